@@ -35,6 +35,8 @@
 
 
 #include <map>
+#include <vector>
+#include <utility>
 #include <cstring>
 
 #include <boost/circular_buffer.hpp>
@@ -50,6 +52,23 @@ namespace bus {
 
 class BusManager : public CommunicationsBus {
 public:
+	/** Bus ID of the periodic broadcast sent by the SafetyModule. These messages
+	 *  are not buffered, but they are passed to MessageObservers.
+	 */
+	static const int SAFETY_MODULE_BROADCAST_BUS_ID = 1344;
+
+	/** MessageObserver is notified of every message received on a given bus ID,
+	 *  in addition to (not instead of) the normal buffering.
+	 *
+	 *  messageReceived() is called with the bus mutex held, possibly from a
+	 *  real-time thread. It must not block, allocate, or call back into the bus.
+	 */
+	class MessageObserver {
+	public:
+		virtual ~MessageObserver() {}
+		virtual void messageReceived(int busId, const unsigned char* data, size_t len) = 0;
+	};
+
 	/** BusManager Constructors and Destructors
 	 */
 	BusManager(CommunicationsBus* bus = NULL);
@@ -84,10 +103,18 @@ public:
 			bool blocking = true) const
 		{ return bus->receiveRaw(busId, data, len, blocking); }
 
+	/** addObserver Method registers mo to be notified of messages on busId
+	 */
+	void addObserver(int busId, MessageObserver* mo);
+	/** removeObserver Method unregisters mo from all bus IDs
+	 */
+	void removeObserver(MessageObserver* mo);
+
 protected:
 	int updateBuffers() const;
 	void storeMessage(int busId, const unsigned char* data, size_t len) const;
 	bool retrieveMessage(int busId, unsigned char* data, size_t& len) const;
+	void notifyObservers(int busId, const unsigned char* data, size_t len) const;
 
 	CommunicationsBus* bus;
 	bool deleteBus;
@@ -117,6 +144,7 @@ private:
 	};
 
 	mutable std::map<int, MessageBuffer> messageBuffers;
+	std::vector<std::pair<int, MessageObserver*> > observers;
 
 	DISALLOW_COPY_AND_ASSIGN(BusManager);
 };
@@ -0,0 +1,166 @@
+/*
+ * allocation_tracker.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_DETAIL_ALLOCATION_TRACKER_H_
+#define BARRETT_DETAIL_ALLOCATION_TRACKER_H_
+
+
+#include <cstddef>
+
+#include <barrett/detail/ca_macro.h>
+
+
+namespace barrett {
+
+namespace systems {
+class System;
+}
+
+namespace detail {
+
+
+/** Counts heap allocations made from within execution cycles.
+ *
+ * Allocating in System::operate() causes mode switches under Xenomai and
+ * jitter under PREEMPT_RT. To find such allocations, link the program against
+ * the \c barrett_allocation_interposer library (with -Wl,--no-as-needed) or
+ * load it with LD_PRELOAD, then give an AllocationTracker to the
+ * ExecutionManager:
+ *
+ * \code
+ * detail::AllocationTracker at;
+ * em.setAllocationTracker(&at);
+ * // ... run ...
+ * at.logStatistics("wam");
+ * \endcode
+ *
+ * The interposer forwards every call to malloc(), free(), etc. to glibc. Only
+ * calls made by the execution-manager thread while it is running an execution
+ * cycle are counted; other threads pay for one thread-local load per call.
+ * Allocations are attributed to the System whose operate() method was running.
+ * If \c printBacktraces is set, a stack trace is printed for each one.
+ *
+ * Without the interposer, the counts remain zero (see isInterposerLinked()).
+ */
+class AllocationTracker {
+public:
+	static const size_t MAX_SYSTEMS = 32;
+	static const size_t MAX_NAME_LENGTH = 48;
+
+	struct SystemStats {
+		const systems::System* sys;  // NULL: outside of any System's operate()
+		char name[MAX_NAME_LENGTH];
+		unsigned long numAllocations;
+		unsigned long numFrees;
+		size_t numBytes;
+	};
+
+	explicit AllocationTracker(bool printBacktraces = false);
+	~AllocationTracker();
+
+	void setPrintBacktraces(bool pb) { printBacktraces = pb; }
+	bool getPrintBacktraces() const { return printBacktraces; }
+
+	void reset();
+
+	unsigned long getNumCycles() const { return numCycles; }
+	/// Number of execution cycles that allocated or freed memory
+	unsigned long getNumAllocatingCycles() const { return numAllocatingCycles; }
+	unsigned long getNumAllocations() const { return numAllocations; }
+	unsigned long getNumFrees() const { return numFrees; }
+	size_t getNumBytes() const { return numBytes; }
+
+	size_t getNumSystems() const { return numSystems; }
+	const SystemStats& getSystemStats(size_t i) const { return systems[i]; }
+
+	void logStatistics(const char* name) const;
+
+
+	// Marks the calling thread's execution cycle. Used by ExecutionManager.
+	class CycleScope {
+	public:
+		explicit CycleScope(AllocationTracker* at_) : at(at_) {
+			if (at != NULL) {
+				at->beginCycle();
+			}
+		}
+		~CycleScope() {
+			if (at != NULL) {
+				at->endCycle();
+			}
+		}
+
+	private:
+		AllocationTracker* at;
+
+		DISALLOW_COPY_AND_ASSIGN(CycleScope);
+	};
+
+	// Marks a call to System::operate(). Used by System::update().
+	class SystemScope {
+	public:
+		explicit SystemScope(const systems::System* sys) : at(current), prev(NULL) {
+			if (at != NULL) {
+				prev = at->currentSystem;
+				at->currentSystem = sys;
+			}
+		}
+		~SystemScope() {
+			if (at != NULL) {
+				at->currentSystem = prev;
+			}
+		}
+
+	private:
+		AllocationTracker* at;
+		const systems::System* prev;
+
+		DISALLOW_COPY_AND_ASSIGN(SystemScope);
+	};
+
+
+	// Called by the interposer. These must not allocate.
+	static void noteAllocation(size_t size);
+	static void noteFree();
+
+	/// True if the interposer is forwarding allocations to the tracker.
+	static bool isInterposerLinked() { return interposerLinked; }
+
+protected:
+	void beginCycle();
+	void endCycle();
+
+	SystemStats* findSystem(const systems::System* sys);
+	void record(size_t size, bool isAllocation);
+
+	bool printBacktraces;
+
+	unsigned long numCycles, numAllocatingCycles;
+	unsigned long numAllocations, numFrees;
+	size_t numBytes;
+	unsigned long cycleCount;  // allocations + frees during the current cycle
+
+	SystemStats systems[MAX_SYSTEMS];
+	size_t numSystems;
+
+	const systems::System* currentSystem;
+	AllocationTracker* prevCurrent;
+	bool inTracker;  // Guards against recursion while printing backtraces
+
+	// The tracker (if any) that the calling thread is reporting to
+	static __thread AllocationTracker* current __attribute__((tls_model("initial-exec")));
+	static volatile bool interposerLinked;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(AllocationTracker);
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_DETAIL_ALLOCATION_TRACKER_H_ */
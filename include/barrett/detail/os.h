@@ -36,6 +36,8 @@
 
 
 #include <string>
+#include <cstddef>
+
 #include <boost/format.hpp>
 
 
@@ -78,6 +80,85 @@ protected:
 };
 
 
+// The number of logMessageRT() records that can wait to be printed
+const size_t REAL_TIME_LOG_QUEUE_SIZE = 256;
+
+// A log message captured without allocating, formatting, or making system
+// calls. See logMessageRT().
+struct RealTimeLogRecord {
+	static const size_t MAX_ARGS = 8;
+
+	struct Arg {
+		enum Type { CHAR, LONG, ULONG, DOUBLE, STRING } type;
+		union {
+			char c;
+			long l;
+			unsigned long ul;
+			double d;
+			const char* s;
+		};
+	};
+
+	const char* fmt;
+	bool ose;
+	double time;
+	size_t numArgs;
+	Arg args[MAX_ARGS];
+};
+
+void submitRealTimeLogRecord(const RealTimeLogRecord& record);
+
+class RealTimeLogFormatter {
+public:
+	RealTimeLogFormatter(const char* fmt, bool outputToStderr, double time) :
+		submitted(false)
+	{
+		record.fmt = fmt;
+		record.ose = outputToStderr;
+		record.time = time;
+		record.numArgs = 0;
+	}
+	RealTimeLogFormatter(const RealTimeLogFormatter& other) :
+		record(other.record), submitted(false)
+	{
+		other.submitted = true;  // Only the last copy submits the record
+	}
+	~RealTimeLogFormatter() {
+		if ( !submitted ) {
+			submitRealTimeLogRecord(record);
+		}
+	}
+
+	RealTimeLogFormatter& operator%(char x) { nextArg(RealTimeLogRecord::Arg::CHAR).c = x; return *this; }
+	RealTimeLogFormatter& operator%(int x) { nextArg(RealTimeLogRecord::Arg::LONG).l = x; return *this; }
+	RealTimeLogFormatter& operator%(long x) { nextArg(RealTimeLogRecord::Arg::LONG).l = x; return *this; }
+	RealTimeLogFormatter& operator%(unsigned int x) { nextArg(RealTimeLogRecord::Arg::ULONG).ul = x; return *this; }
+	RealTimeLogFormatter& operator%(unsigned long x) { nextArg(RealTimeLogRecord::Arg::ULONG).ul = x; return *this; }
+	RealTimeLogFormatter& operator%(double x) { nextArg(RealTimeLogRecord::Arg::DOUBLE).d = x; return *this; }
+	/// The string is not copied, so it must outlive the record (string literals, __func__, strerror()).
+	RealTimeLogFormatter& operator%(const char* x) { nextArg(RealTimeLogRecord::Arg::STRING).s = x; return *this; }
+
+protected:
+	RealTimeLogRecord::Arg& nextArg(enum RealTimeLogRecord::Arg::Type type) {
+		// Extra arguments overwrite the last one; the message is still logged.
+		size_t i = record.numArgs;
+		if (i < RealTimeLogRecord::MAX_ARGS) {
+			++record.numArgs;
+		} else {
+			i = RealTimeLogRecord::MAX_ARGS - 1;
+		}
+		record.args[i].type = type;
+		return record.args[i];
+	}
+
+	RealTimeLogRecord record;
+	mutable bool submitted;
+
+private:
+	RealTimeLogFormatter& operator=(const RealTimeLogFormatter&);
+};
+
+
 }
 }
 
@@ -0,0 +1,99 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ */
+
+/**
+ * @file trajectory_file-inl.h
+ * @date 10/19/2026
+ *
+ */
+
+
+#include <stdexcept>
+#include <sstream>
+#include <algorithm>
+
+#include <boost/tuple/tuple.hpp>
+
+
+namespace barrett {
+namespace log {
+
+
+template<typename Container>
+void TrajectoryFile::getJointPositions(Container* samples) const
+{
+	typedef typename Container::value_type tuple_type;
+	typedef typename boost::tuples::element<1, tuple_type>::type jp_type;
+
+	if (getSampleType() != JOINT_POSITIONS  ||  getWidth() != static_cast<size_t>(jp_type::SIZE)) {
+		std::stringstream ss;
+		ss << "(log::TrajectoryFile::getJointPositions()): The file does not contain "
+				<< jp_type::SIZE << "-DOF joint positions.";
+		throw(std::logic_error(ss.str()));
+	}
+
+	samples->clear();
+	samples->reserve(numRecords());
+
+	tuple_type sample;
+	for (size_t i = 0; i < numRecords(); ++i) {
+		const double* r = getRecord(i);
+		boost::get<0>(sample) = r[0];
+		std::copy(r + 1, r + 1 + jp_type::SIZE, boost::get<1>(sample).data());
+		samples->push_back(sample);
+	}
+}
+
+template<typename PositionContainer, typename OrientationContainer>
+void TrajectoryFile::getPoses(PositionContainer* positions, OrientationContainer* orientations) const
+{
+	typedef typename PositionContainer::value_type position_tuple_type;
+	typedef typename OrientationContainer::value_type orientation_tuple_type;
+
+	if (getSampleType() != POSE  ||  getWidth() != POSE_WIDTH) {
+		throw(std::logic_error("(log::TrajectoryFile::getPoses()): The file does not contain poses."));
+	}
+
+	positions->clear();
+	positions->reserve(numRecords());
+	orientations->clear();
+	orientations->reserve(numRecords());
+
+	position_tuple_type p;
+	orientation_tuple_type q;
+	for (size_t i = 0; i < numRecords(); ++i) {
+		const double* r = getRecord(i);
+		boost::get<0>(p) = r[0];
+		boost::get<0>(q) = r[0];
+		std::copy(r + 1, r + 4, boost::get<1>(p).data());
+		std::copy(r + 4, r + 8, boost::get<1>(q).coeffs().data());
+		positions->push_back(p);
+		orientations->push_back(q);
+	}
+}
+
+
+}
+}
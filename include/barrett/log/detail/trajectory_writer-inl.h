@@ -0,0 +1,48 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ */
+
+/**
+ * @file trajectory_writer-inl.h
+ * @date 10/19/2026
+ *
+ */
+
+
+namespace barrett {
+namespace log {
+
+
+template<typename T>
+TrajectoryWriter<T>::TrajectoryWriter(const char* fileName, double recordPeriod_s, int priority_) :
+	RealTimeWriter<T>(fileName, recordPeriod_s, priority_)
+{
+	// No records have been logged yet, so the disk thread isn't writing.
+	TrajectoryFile::writeHeader(this->file, detail::TrajectorySample<T>::SAMPLE_TYPE,
+			detail::TrajectorySample<T>::WIDTH, recordPeriod_s);
+}
+
+
+}
+}
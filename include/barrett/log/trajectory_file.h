@@ -0,0 +1,160 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ */
+
+/**
+ * @file trajectory_file.h
+ * @date 10/19/2026
+ *
+ */
+
+#ifndef BARRETT_LOG_TRAJECTORY_FILE_H_
+#define BARRETT_LOG_TRAJECTORY_FILE_H_
+
+
+#include <ostream>
+#include <stdint.h>
+
+#include <barrett/detail/ca_macro.h>
+
+
+namespace barrett {
+namespace log {
+
+
+/** Read-only access to a recorded trajectory (for instance, from teach and play).
+ *
+ * A trajectory file is a TrajectoryFile::Header followed by tightly packed
+ * records. Each record is a time stamp followed by Header::width samples, all
+ * stored as doubles in host byte order:
+ *   - JOINT_POSITIONS: one joint angle per DOF.
+ *   - POSE: the tool position (x, y, z) followed by the orientation
+ *     quaternion's coefficients in Eigen's coeffs() order (x, y, z, w).
+ *
+ * This is the layout log::Traits gives boost::tuple<double, jp_type> and
+ * boost::tuple<double, pose_type>, so log::TrajectoryWriter can stream records
+ * to disk exactly as a PeriodicDataLogger produces them. The number of records
+ * is not stored; it is derived from the size of the file.
+ *
+ * The file is memory-mapped, so opening it does not read or parse the data.
+ * The getJointPositions() and getPoses() methods copy the records into
+ * containers suitable for constructing a math::Spline.
+ */
+class TrajectoryFile {
+public:
+	enum SampleType { JOINT_POSITIONS = 0, POSE = 1 };
+
+	/// Number of doubles following the time stamp in a POSE record
+	static const size_t POSE_WIDTH = 7;
+
+	struct Header {
+		static const char MAGIC[8];
+		static const uint32_t VERSION = 1;
+
+		char magic[8];
+		uint32_t version;
+		uint32_t headerLength;  ///< Offset of the first record, in bytes
+		uint32_t sampleType;  ///< One of TrajectoryFile::SampleType
+		uint32_t width;  ///< Number of doubles following the time stamp in each record
+		uint32_t recordLength;  ///< Size of each record, in bytes
+		uint32_t flags;  ///< Reserved; must be zero
+		double recordPeriod;  ///< Nominal time between records, in seconds. Zero if unknown.
+
+		Header() {}
+		Header(SampleType type, size_t width, double recordPeriod = 0.0);
+	};
+
+	/// Throws std::runtime_error if \c fileName does not contain a valid trajectory.
+	explicit TrajectoryFile(const char* fileName);
+	~TrajectoryFile();
+
+	/// Returns true if \c fileName starts with a trajectory file header.
+	static bool isTrajectoryFile(const char* fileName);
+
+	/** Writes a trajectory file header. The records should follow immediately.
+	 *
+	 * Throws std::runtime_error if the stream can't be written.
+	 */
+	static void writeHeader(std::ostream& os, SampleType type, size_t width, double recordPeriod = 0.0);
+
+	/** Converts a CSV file exported by teach and play to a trajectory file.
+	 *
+	 * The first line of \c csvFileName is "jp_type" or "pose_type". Each
+	 * following line is a time stamp followed by the joint angles or by the
+	 * position and the orientation quaternion (w, x, y, z). Throws
+	 * std::runtime_error if the file is malformed.
+	 */
+	static void convertCSV(const char* csvFileName, const char* outputFileName);
+
+	SampleType getSampleType() const { return static_cast<SampleType>(header->sampleType); }
+	size_t getWidth() const { return header->width; }
+	double getRecordPeriod() const { return header->recordPeriod; }
+	size_t numRecords() const { return recordCount; }
+
+	/// Time stamp of record \c i, followed by getWidth() samples
+	const double* getRecord(size_t i) const {
+		return records + i * (getWidth() + 1);
+	}
+
+	/** Copies the records into \c samples.
+	 *
+	 * Container holds boost::tuple<double, jp_type>. Throws std::logic_error
+	 * if this file doesn't contain joint positions of the same DOF.
+	 */
+	template<typename Container> void getJointPositions(Container* samples) const;
+
+	/** Copies the records into \c positions and \c orientations.
+	 *
+	 * The containers hold boost::tuple<double, cp_type> and
+	 * boost::tuple<double, Eigen::Quaterniond>, respectively. Throws
+	 * std::logic_error if this file doesn't contain poses.
+	 */
+	template<typename PositionContainer, typename OrientationContainer>
+	void getPoses(PositionContainer* positions, OrientationContainer* orientations) const;
+
+	void close();
+
+protected:
+	static void validateHeader(const Header& h, const char* fileName);
+
+	void* map;
+	size_t mapLength;
+	const Header* header;
+	const double* records;
+	size_t recordCount;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(TrajectoryFile);
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/log/detail/trajectory_file-inl.h>
+
+
+#endif /* BARRETT_LOG_TRAJECTORY_FILE_H_ */
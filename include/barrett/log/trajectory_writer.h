@@ -0,0 +1,93 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ */
+
+/**
+ * @file trajectory_writer.h
+ * @date 10/19/2026
+ *
+ */
+
+#ifndef BARRETT_LOG_TRAJECTORY_WRITER_H_
+#define BARRETT_LOG_TRAJECTORY_WRITER_H_
+
+
+#include <boost/tuple/tuple.hpp>
+#include <Eigen/Geometry>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/units.h>
+#include <barrett/log/real_time_writer.h>
+#include <barrett/log/trajectory_file.h>
+
+
+namespace barrett {
+namespace log {
+
+
+namespace detail {
+// Only joint positions and poses (each with a time stamp) can be stored in a
+// trajectory file.
+template<typename T> struct TrajectorySample;
+
+template<int DOF>
+struct TrajectorySample<boost::tuple<double, math::Matrix<DOF,1, units::JointPositions<DOF> > > > {
+	static const TrajectoryFile::SampleType SAMPLE_TYPE = TrajectoryFile::JOINT_POSITIONS;
+	static const size_t WIDTH = DOF;
+};
+
+template<>
+struct TrajectorySample<boost::tuple<double, boost::tuple<units::CartesianPosition::type, Eigen::Quaterniond> > > {
+	static const TrajectoryFile::SampleType SAMPLE_TYPE = TrajectoryFile::POSE;
+	static const size_t WIDTH = TrajectoryFile::POSE_WIDTH;
+};
+}
+
+
+/** A log::RealTimeWriter that writes a log::TrajectoryFile.
+ *
+ * T is boost::tuple<double, jp_type> or boost::tuple<double, pose_type>. The
+ * header is written when the file is opened, and records are appended as they
+ * are logged, so the file can be loaded with log::TrajectoryFile without any
+ * conversion.
+ */
+template<typename T>
+class TrajectoryWriter : public RealTimeWriter<T> {
+public:
+	TrajectoryWriter(const char* fileName, double recordPeriod_s, int priority_ = RealTimeWriter<T>::DEFAULT_PRIORITY);
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(TrajectoryWriter);
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/log/detail/trajectory_writer-inl.h>
+
+
+#endif /* BARRETT_LOG_TRAJECTORY_WRITER_H_ */
@@ -42,12 +42,17 @@
 #include <barrett/math/utils.h>
 
 #include <barrett/math/first_order_filter.h>
+#include <barrett/math/velocity_estimator.h>
+#include <barrett/math/jitter_buffer.h>
 
 #include <barrett/math/spline.h>
 #include <barrett/math/trapezoidal_velocity_profile.h>
+#include <barrett/math/s_curve_profile.h>
+#include <barrett/math/trajectory_simplifier.h>
 
 #include <barrett/math/kinematics.h>
 #include <barrett/math/dynamics.h>
+#include <barrett/math/gravity_calibrator.h>
 
 
 #endif /* BARRETT_MATH_H_ */
@@ -170,6 +170,15 @@ inline void FirstOrderFilter<T, MathTraits>::updateCoefficients()
 	c3 = MT::div(a, den);
 }
 
+template<typename T, typename MathTraits>
+inline void FirstOrderFilter<T, MathTraits>::reset()
+{
+	y_0 = MT::zero();
+	y_1 = MT::zero();
+	x_0 = MT::zero();
+	x_1 = MT::zero();
+}
+
 template<typename T, typename MathTraits>
 inline const T& FirstOrderFilter<T, MathTraits>::eval(const T& x_0)
 {
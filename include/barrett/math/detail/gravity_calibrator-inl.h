@@ -0,0 +1,160 @@
+/*
+ * gravity_calibrator-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#include <Eigen/LU>
+
+#include <barrett/os.h>
+
+
+namespace barrett {
+namespace math {
+
+
+template<size_t DOF>
+GravityCalibrator<DOF>::GravityCalibrator(double lambda_) :
+	lambda(lambda_),
+	n(0), meanJt(0.0), m2Jt(0.0), meanJp(0.0), m2Jp(0.0), poses()
+{
+	if (lambda < 0.0) {
+		(logMessage("GravityCalibrator::%s(): lambda must be non-negative. Got %f.")
+				% __func__ % lambda).template raise<std::invalid_argument>();
+	}
+}
+
+template<size_t DOF>
+void GravityCalibrator<DOF>::resetMeasurement()
+{
+	n = 0;
+	meanJt.setZero();
+	m2Jt.setZero();
+	meanJp.setZero();
+	m2Jp.setZero();
+}
+
+template<size_t DOF>
+void GravityCalibrator<DOF>::addSample(const jt_type& jt, const jp_type& jp)
+{
+	++n;
+	for (size_t i = 0; i < DOF; ++i) {
+		double d = jt[i] - meanJt[i];
+		meanJt[i] += d / n;
+		m2Jt[i] += d * (jt[i] - meanJt[i]);
+
+		d = jp[i] - meanJp[i];
+		meanJp[i] += d / n;
+		m2Jp[i] += d * (jp[i] - meanJp[i]);
+	}
+}
+
+template<size_t DOF>
+typename GravityCalibrator<DOF>::jt_type GravityCalibrator<DOF>::getTorqueVariance() const
+{
+	if (n == 0) {
+		return jt_type(0.0);
+	}
+	return m2Jt / n;
+}
+
+template<size_t DOF>
+typename GravityCalibrator<DOF>::jp_type GravityCalibrator<DOF>::getPositionVariance() const
+{
+	if (n == 0) {
+		return jp_type(0.0);
+	}
+	return m2Jp / n;
+}
+
+
+template<size_t DOF>
+void GravityCalibrator<DOF>::addPose(const jt_type& jt, const gravity_type g[DOF], const rotation_type rotToPrev[DOF])
+{
+	poses.push_back(Pose());
+	Pose& pose = poses.back();
+	pose.jt = jt;
+	for (size_t j = 0; j < DOF; ++j) {
+		pose.g[j] = g[j];
+		pose.rotToPrev[j] = rotToPrev[j];
+	}
+}
+
+template<size_t DOF>
+void GravityCalibrator<DOF>::solve(mu_type mus[DOF]) const
+{
+	if (poses.size() == 0) {
+		(logMessage("GravityCalibrator::%s(): No poses have been added.")
+				% __func__).template raise<std::logic_error>();
+	}
+
+	typedef Eigen::Matrix<double, 3,2> lateral_type;
+	typedef std::vector<Eigen::Vector2d, Eigen::aligned_allocator<Eigen::Vector2d> > force_vector_type;
+
+	// The lateral forces at each pose: those of link j+1 while fitting link j.
+	force_vector_type f(poses.size(), Eigen::Vector2d::Zero());
+
+	Eigen::Matrix3d S;  // Torque due to mu: g x mu
+	lateral_type B;     // Torque due to the lateral forces
+	Eigen::Vector3d b;  // Measured torque, less that due to the next link's lateral forces
+	Eigen::Matrix2d Ci;
+	lateral_type K;
+
+	for (int j = DOF - 1; j >= 0; --j) {
+		// Each pose p contributes the equations
+		//   S_p mu + B_p f_p = b_p
+		// with unknowns mu (shared by all poses) and f_p (specific to pose p).
+		// Minimizing the residual plus lambda times the squared norm of the
+		// unknowns, and eliminating each f_p from the normal equations, leaves
+		// a 3x3 system in mu.
+		Eigen::Matrix3d M = lambda * Eigen::Matrix3d::Identity();
+		Eigen::Vector3d v = Eigen::Vector3d::Zero();
+		for (size_t p = 0; p < poses.size(); ++p) {
+			linkEquations(poses[p], j, f[p], &S, &B, &b);
+			Ci = (B.transpose() * B + lambda * Eigen::Matrix2d::Identity()).inverse();
+			K = S.transpose() * B * Ci;
+
+			M += S.transpose() * S - K * (B.transpose() * S);
+			v += S.transpose() * b - K * (B.transpose() * b);
+		}
+		mus[j] = M.inverse() * v;
+
+		// Back-substitute for this link's lateral forces, which the previous
+		// link's equations depend on.
+		for (size_t p = 0; p < poses.size(); ++p) {
+			linkEquations(poses[p], j, f[p], &S, &B, &b);
+			Ci = (B.transpose() * B + lambda * Eigen::Matrix2d::Identity()).inverse();
+			f[p] = Ci * (B.transpose() * (b - S * mus[j]));
+		}
+	}
+}
+
+template<size_t DOF>
+void GravityCalibrator<DOF>::linkEquations(const Pose& pose, size_t j, const Eigen::Vector2d& fNext,
+		Eigen::Matrix3d* S, Eigen::Matrix<double, 3,2>* B, Eigen::Vector3d* b) const
+{
+	const gravity_type& g = pose.g[j];
+	const rotation_type& R = pose.rotToPrev[j];
+
+	(*S) <<   0.0, -g[2],  g[1],
+			 g[2],   0.0, -g[0],
+			-g[1],  g[0],   0.0;
+
+	for (int r = 0; r < 3; ++r) {
+		(*B)(r,0) = -R(0,r);
+		(*B)(r,1) = -R(1,r);
+		(*b)[r] = pose.jt[j] * R(2,r);
+	}
+	if (j < DOF - 1) {
+		(*b)[0] -= fNext[0];
+		(*b)[1] -= fNext[1];
+		(*b)[2] -= pose.jt[j + 1];
+	}
+}
+
+
+}
+}
@@ -0,0 +1,127 @@
+/*
+ * jitter_buffer-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include <barrett/os.h>
+
+
+namespace barrett {
+namespace math {
+
+
+template<typename T, typename MathTraits>
+JitterBuffer<T,MathTraits>::JitterBuffer(double playoutDelay_, double maxExtrapolation_) :
+	playoutDelay(playoutDelay_), maxExtrapolation(maxExtrapolation_)
+{
+	if (playoutDelay < 0.0) {
+		(logMessage("JitterBuffer::%s(): playoutDelay must be non-negative. Got %f.")
+				% __func__ % playoutDelay).template raise<std::invalid_argument>();
+	}
+	if (maxExtrapolation < 0.0) {
+		(logMessage("JitterBuffer::%s(): maxExtrapolation must be non-negative. Got %f.")
+				% __func__ % maxExtrapolation).template raise<std::invalid_argument>();
+	}
+
+	reset();
+}
+
+template<typename T, typename MathTraits>
+void JitterBuffer<T,MathTraits>::reset()
+{
+	newest = 0;
+	count = 0;
+	newestSeq = 0;
+	lastReceiveTime = 0.0;
+	baseTransit = 0.0;
+	lastTransit = 0.0;
+	jitter = 0.0;
+	numLost = 0;
+	numLate = 0;
+}
+
+template<typename T, typename MathTraits>
+bool JitterBuffer<T,MathTraits>::add(uint32_t seq, double sendTime, double receiveTime, const T& value)
+{
+	double transit = receiveTime - sendTime;
+
+	// The difference is computed modulo 2^32, so sequence numbers may wrap.
+	int32_t gap = static_cast<int32_t>(seq - newestSeq);
+	if (count != 0  &&  gap < -MAX_MISORDER) {
+		restart();  // The sender started again from a lower sequence number.
+	}
+
+	if (count != 0) {
+		if (gap <= 0) {
+			++numLate;
+			if (gap < 0  &&  numLost != 0) {
+				--numLost;  // It was counted as lost when the newer sample arrived.
+			}
+			return false;
+		}
+		numLost += gap - 1;
+
+		jitter += (std::fabs(transit - lastTransit) - jitter) / 16.0;
+		baseTransit = std::min(transit, baseTransit + (receiveTime - lastReceiveTime) * BASE_TRANSIT_DRIFT);
+	} else {
+		baseTransit = transit;
+	}
+
+	newest = (newest + 1) % CAPACITY;
+	samples[newest].time = sendTime;
+	samples[newest].value = value;
+	if (count < CAPACITY) {
+		++count;
+	}
+
+	newestSeq = seq;
+	lastReceiveTime = receiveTime;
+	lastTransit = transit;
+	return true;
+}
+
+template<typename T, typename MathTraits>
+bool JitterBuffer<T,MathTraits>::eval(double now, T* value) const
+{
+	if (count == 0) {
+		return false;
+	}
+
+	// The time (by the sender's clock) to play back
+	double t = now - baseTransit - playoutDelay;
+
+	const Sample& s0 = sample(0);
+	if (t >= s0.time) {
+		const Sample& s1 = sample(1);
+		if (count == 1  ||  maxExtrapolation == 0.0  ||  s0.time <= s1.time) {
+			*value = s0.value;
+		} else {
+			double s = std::min(t - s0.time, maxExtrapolation) / (s0.time - s1.time);
+			*value = MT::add(s0.value, MT::mult(MT::sub(s0.value, s1.value), s));
+		}
+		return true;
+	}
+
+	for (size_t i = 1; i < count; ++i) {
+		const Sample& older = sample(i);
+		if (t >= older.time) {
+			const Sample& newer = sample(i - 1);
+			double s = (t - older.time) / (newer.time - older.time);
+			*value = MT::add(older.value, MT::mult(MT::sub(newer.value, older.value), s));
+			return true;
+		}
+	}
+
+	// Older than everything in the buffer
+	*value = sample(count - 1).value;
+	return true;
+}
+
+
+}
+}
@@ -0,0 +1,39 @@
+/*
+ * s_curve_profile-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+
+namespace barrett {
+namespace math {
+
+
+template<typename T>
+SCurveProfile::SCurveProfile(const T& displacement, const T& velocity,
+		const T& acceleration, const T& jerk) :
+	v(std::numeric_limits<double>::max()),
+	a(std::numeric_limits<double>::max()),
+	j(std::numeric_limits<double>::max()),
+	l(displacement.norm())
+{
+	// DOF i moves |displacement[i]| / l as far as the path parameter does.
+	for (int i = 0; i < displacement.size(); ++i) {
+		double d = std::fabs(displacement[i]);
+		if (d > 0.0) {
+			v = std::min(v, velocity[i] * l / d);
+			a = std::min(a, acceleration[i] * l / d);
+			j = std::min(j, jerk[i] * l / d);
+		}
+	}
+
+	init();
+}
+
+
+}
+}
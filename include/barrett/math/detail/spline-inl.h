@@ -30,7 +30,10 @@
 
 
 #include <iostream>
+#include <vector>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 #include <gsl/gsl_interp.h>
 
@@ -82,6 +85,25 @@ Spline<T>::Spline(const Container<T, Allocator>& points, /*const typename T::uni
 	s_f = s_0 + changeInS();
 }
 
+template<typename T>
+template<template<typename, typename> class Container, typename Allocator>
+Spline<T>::Spline(const Container<T, Allocator>& points, const typename T::unitless_type& initialDirection, bool saturateS) :
+	impl(NULL), sat(saturateS), s_0(0.0), s_f(0.0)
+{
+	bt_spline_create(&impl, points[0].asGslType(), BT_SPLINE_MODE_ARCLEN);
+
+	typename Container<T, Allocator>::const_iterator i;
+	for (i = ++(points.begin()); i != points.end(); ++i) {  // start with the 2nd sample
+		bt_spline_add(impl, (*i).asGslType(), 0);
+	}
+
+	// local copy because init modifies its 3rd parameter
+	typename T::unitless_type id(initialDirection);
+	bt_spline_init(impl, NULL, id.asGslType());
+
+	s_f = s_0 + changeInS();
+}
+
 template<typename T>
 Spline<T>::~Spline()
 {
@@ -107,6 +129,29 @@ inline T Spline<T>::eval(double s) const
 	return result;
 }
 
+template<typename T>
+template<typename InputIterator, typename OutputIterator>
+void Spline<T>::eval(InputIterator sBegin, InputIterator sEnd, OutputIterator result) const
+{
+	// impl->acc belongs to eval(), so use a private accelerator.
+	gsl_interp_accel* acc = gsl_interp_accel_alloc();
+
+	T r;
+	for ( ; sBegin != sEnd; ++sBegin, ++result) {
+		double s = *sBegin;
+		if (sat) {
+			s = saturate(s, s_0, s_f);
+		}
+
+		for (int i = 0; i < impl->dimension; ++i) {
+			r[i] = gsl_interp_eval(impl->interps[i], impl->ss, impl->points[i], s - s_0, acc);
+		}
+		*result = r;
+	}
+
+	gsl_interp_accel_free(acc);
+}
+
 template<typename T>
 inline T Spline<T>::evalDerivative(double s) const
 {
@@ -122,22 +167,71 @@ inline T Spline<T>::evalDerivative(double s) const
 }
 
 
+namespace detail {
+
+// The logarithm of a unit quaternion. Only the vector part is returned; the
+// scalar part is zero.
+template<typename Scalar>
+Eigen::Matrix<Scalar,3,1> quaternionLog(const Eigen::Quaternion<Scalar>& q)
+{
+	Eigen::Matrix<Scalar,3,1> v(q.x(), q.y(), q.z());
+	Scalar n = v.norm();
+	if (n < 1e-12) {
+		return v;
+	}
+	return v * (std::atan2(n, q.w()) / n);
+}
+
+// The inverse of quaternionLog()
+template<typename Scalar>
+Eigen::Quaternion<Scalar> quaternionExp(const Eigen::Matrix<Scalar,3,1>& v)
+{
+	Scalar theta = v.norm();
+	Scalar k = (theta < 1e-12) ? Scalar(1) : std::sin(theta) / theta;
+	return Eigen::Quaternion<Scalar>(std::cos(theta), k * v[0], k * v[1], k * v[2]);
+}
+
+// Unlike Eigen's slerp(), this doesn't switch to the shorter path when the
+// quaternions are more than 180 degrees apart (SQUAD relies on that) and
+// doesn't snap to p when p and q are very close.
+template<typename Scalar>
+Eigen::Quaternion<Scalar> slerp(const Eigen::Quaternion<Scalar>& p, const Eigen::Quaternion<Scalar>& q, Scalar t)
+{
+	Scalar d = p.dot(q);
+	Eigen::Quaternion<Scalar> result;
+	if (d > Scalar(1) - Scalar(1e-6)) {
+		result.coeffs() = (Scalar(1) - t) * p.coeffs() + t * q.coeffs();
+		result.normalize();
+	} else {
+		Scalar theta = std::acos(std::max(d, Scalar(-1)));
+		Scalar sinTheta = std::sin(theta);
+		result.coeffs() = (std::sin((Scalar(1) - t) * theta) / sinTheta) * p.coeffs()
+				+ (std::sin(t * theta) / sinTheta) * q.coeffs();
+	}
+	return result;
+}
+
+}
+
+
 // Specialization for Eigen::Quaternion  types
 template<typename Scalar>
 template<template<typename, typename> class Container, typename Allocator>
 Spline<Eigen::Quaternion<Scalar> >::Spline(const Container<tuple_type, Allocator>& samples, bool saturateS) :
-	data(samples.begin(), samples.end()), sat(saturateS), index(0), rate(-1.0)
+	data(samples.begin(), samples.end()), outgoing(), incoming(), rates(), sat(saturateS), index(0)
 {
 	// Make sure s is monotonic.
 	for (size_t i = 0; i < data.size() - 1; ++i) {
 		assert(boost::get<0>(data[i]) < boost::get<0>(data[i+1]));
 	}
+
+	init();
 }
 
 template<typename Scalar>
 template<template<typename, typename> class Container, typename Allocator>
 Spline<Eigen::Quaternion<Scalar> >::Spline(const Container<data_type, Allocator>& points, bool saturateS) :
-	data(points.size()), sat(saturateS), index(0), rate(-1.0)
+	data(points.size()), outgoing(), incoming(), rates(), sat(saturateS), index(0)
 {
 	double s = 0.0;
 	for (size_t i = 0; i < data.size(); ++i) {
@@ -158,34 +252,126 @@ Spline<Eigen::Quaternion<Scalar> >::Spline(const Container<data_type, Allocator>
 	for (size_t i = 0; i < data.size() - 1; ++i) {
 		assert(boost::get<0>(data[i]) < boost::get<0>(data[i+1]));
 	}
+
+	init();
 }
 
 template<typename Scalar>
-typename Spline<Eigen::Quaternion<Scalar> >::data_type Spline<Eigen::Quaternion<Scalar> >::eval(double s) const
+void Spline<Eigen::Quaternion<Scalar> >::init()
+{
+	typedef Eigen::Matrix<Scalar,3,1> log_type;
+	const size_t numSegments = data.size() - 1;
+
+	// q and -q are the same orientation. Pick the signs so that each segment
+	// takes the shorter way around.
+	for (size_t i = 1; i < data.size(); ++i) {
+		if (boost::get<1>(data[i-1]).dot(boost::get<1>(data[i])) < 0.0) {
+			boost::get<1>(data[i]).coeffs() = -boost::get<1>(data[i]).coeffs();
+		}
+	}
+
+	// The rotation across each segment, in the log space of its first sample
+	std::vector<log_type, Eigen::aligned_allocator<log_type> > segmentLog(numSegments);
+	rates.resize(numSegments);
+	for (size_t i = 0; i < numSegments; ++i) {
+		segmentLog[i] = detail::quaternionLog(boost::get<1>(data[i]).conjugate() * boost::get<1>(data[i+1]));
+		rates[i] = 1.0 / (boost::get<0>(data[i+1]) - boost::get<0>(data[i]));
+	}
+
+	// The angular velocity (d(log q)/ds) at each sample: a weighted average of
+	// the neighboring segments, or the only neighboring segment at the ends.
+	std::vector<log_type, Eigen::aligned_allocator<log_type> > velocity(data.size());
+	for (size_t i = 0; i < data.size(); ++i) {
+		if (numSegments == 0) {
+			velocity[i].setZero();
+		} else if (i == 0) {
+			velocity[i] = segmentLog[0] * rates[0];
+		} else if (i == numSegments) {
+			velocity[i] = segmentLog[i-1] * rates[i-1];
+		} else {
+			double hIn = 1.0 / rates[i-1];
+			double hOut = 1.0 / rates[i];
+			velocity[i] = (hOut * rates[i-1] * segmentLog[i-1] + hIn * rates[i] * segmentLog[i]) / (hIn + hOut);
+		}
+	}
+
+	// A SQUAD segment leaves its first sample with d(log q)/du =
+	// segmentLog + 2*log(q^-1 * outgoing), and arrives at its last sample with
+	// d(log q)/du = segmentLog - 2*log(q^-1 * incoming).
+	outgoing.resize(numSegments);
+	incoming.resize(numSegments);
+	for (size_t i = 0; i < numSegments; ++i) {
+		double h = 1.0 / rates[i];
+		log_type out = (velocity[i] * h - segmentLog[i]) / 2.0;
+		log_type in = (segmentLog[i] - velocity[i+1] * h) / 2.0;
+		outgoing[i] = boost::get<1>(data[i]) * detail::quaternionExp(out);
+		incoming[i] = boost::get<1>(data[i+1]) * detail::quaternionExp(in);
+	}
+}
+
+template<typename Scalar>
+inline typename Spline<Eigen::Quaternion<Scalar> >::data_type Spline<Eigen::Quaternion<Scalar> >::eval(double s) const
 {
 	s = saturate(s, initialS(), finalS());
+	index = findSegment(s, index);
+	return evalSegment(index, s);
+}
 
-	while (index > 0  &&  s < boost::get<0>(data[index])) {
-		--index;
-		rate = -1.0;
+template<typename Scalar>
+template<typename InputIterator, typename OutputIterator>
+void Spline<Eigen::Quaternion<Scalar> >::eval(InputIterator sBegin, InputIterator sEnd, OutputIterator result) const
+{
+	size_t i = 0;
+	for ( ; sBegin != sEnd; ++sBegin, ++result) {
+		double s = saturate(*sBegin, initialS(), finalS());
+		i = findSegment(s, i);
+		*result = evalSegment(i, s);
 	}
-	while (index < data.size()-1  &&  s >= boost::get<0>(data[index+1])) {
-		++index;
-		rate = -1.0;
+}
+
+template<typename Scalar>
+size_t Spline<Eigen::Quaternion<Scalar> >::findSegment(double s, size_t hint) const
+{
+	const size_t last = data.size() - 1;
+	if (s >= boost::get<0>(data[last])) {
+		return last;
 	}
-	assert(index < data.size());
 
-	if (index == data.size()-1) {
-		return boost::get<1>(data[index]);
-	} else {
-		if (rate < 0.0) {
-			rate = 1.0 / (boost::get<0>(data[index+1]) - boost::get<0>(data[index]));
+	// Try the hint and the segment after it first.
+	if (hint < last  &&  s >= boost::get<0>(data[hint])) {
+		if (s < boost::get<0>(data[hint+1])) {
+			return hint;
+		} else if (hint + 1 < last  &&  s < boost::get<0>(data[hint+2])) {
+			return hint + 1;
 		}
+	}
 
-		return boost::get<1>(data[index]).slerp(rate * (s - boost::get<0>(data[index])), boost::get<1>(data[index+1]));
+	// Binary search for the last sample at or before s
+	size_t lo = 0, hi = last;
+	while (hi - lo > 1) {
+		size_t mid = (lo + hi) / 2;
+		if (s < boost::get<0>(data[mid])) {
+			hi = mid;
+		} else {
+			lo = mid;
+		}
 	}
+	return lo;
 }
 
+template<typename Scalar>
+inline typename Spline<Eigen::Quaternion<Scalar> >::data_type Spline<Eigen::Quaternion<Scalar> >::evalSegment(size_t i, double s) const
+{
+	if (i == data.size() - 1) {
+		return boost::get<1>(data[i]);
+	}
+
+	Scalar u = (s - boost::get<0>(data[i])) * rates[i];
+	return detail::slerp(
+			detail::slerp(boost::get<1>(data[i]), boost::get<1>(data[i+1]), u),
+			detail::slerp(outgoing[i], incoming[i], u),
+			Scalar(2) * u * (Scalar(1) - u));
+}
 
 }
 }
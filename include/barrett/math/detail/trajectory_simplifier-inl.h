@@ -0,0 +1,298 @@
+/*
+ * trajectory_simplifier-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/tuple/tuple.hpp>
+#include <Eigen/Geometry>
+
+#include <barrett/os.h>
+#include <barrett/detail/ca_macro.h>
+#include <barrett/math/spline.h>
+
+
+namespace barrett {
+namespace math {
+
+
+namespace detail {
+
+
+// Error as a fraction of the tolerance. Samples with a ratio over 1 are kept.
+inline double toleranceRatio(double error, double tolerance)
+{
+	if (tolerance > 0.0) {
+		return error / tolerance;
+	} else {
+		return (error > 0.0) ? std::numeric_limits<double>::max() : 0.0;
+	}
+}
+
+// Where sample j falls between samples i and k, in time
+template<typename Container>
+inline double chordFraction(const Container& samples, size_t i, size_t k, size_t j)
+{
+	double span = boost::get<0>(samples[k]) - boost::get<0>(samples[i]);
+	if (span <= 0.0) {
+		return 0.0;
+	}
+	return (boost::get<0>(samples[j]) - boost::get<0>(samples[i])) / span;
+}
+
+template<typename Container>
+class VectorChordError {
+public:
+	VectorChordError(const Container& samples_, double tolerance_) :
+		samples(samples_), tolerance(tolerance_) {}
+
+	double operator() (size_t i, size_t k, size_t j) const {
+		double u = chordFraction(samples, i, k, j);
+		const typename boost::tuples::element<1, typename Container::value_type>::type&
+				xi = boost::get<1>(samples[i]);
+		double e = (boost::get<1>(samples[j]) - xi - u * (boost::get<1>(samples[k]) - xi)).norm();
+		return toleranceRatio(e, tolerance);
+	}
+
+protected:
+	const Container& samples;
+	double tolerance;
+};
+
+template<typename PositionContainer, typename OrientationContainer>
+class PoseChordError {
+public:
+	PoseChordError(const PositionContainer& positions, const OrientationContainer& orientations_,
+			double positionTolerance, double orientationTolerance_) :
+		pe(positions, positionTolerance), orientations(orientations_), orientationTolerance(orientationTolerance_) {}
+
+	double operator() (size_t i, size_t k, size_t j) const {
+		double u = chordFraction(orientations, i, k, j);
+		double angle = boost::get<1>(orientations[i]).slerp(u, boost::get<1>(orientations[k]))
+				.angularDistance(boost::get<1>(orientations[j]));
+		return std::max(pe(i, k, j), toleranceRatio(angle, orientationTolerance));
+	}
+
+protected:
+	VectorChordError<PositionContainer> pe;
+	const OrientationContainer& orientations;
+	double orientationTolerance;
+};
+
+// Marks the samples to keep so that every other sample is within tolerance
+// (error(i, k, j) <= 1) of the chord between the kept samples i and k on
+// either side of it. Segments are split at their worst sample. An explicit
+// stack is used because recordings can have millions of samples.
+template<typename ErrorFunction>
+void markKnots(size_t n, const ErrorFunction& error, std::vector<bool>* keep)
+{
+	keep->assign(n, false);
+	if (n == 0) {
+		return;
+	}
+	(*keep)[0] = true;
+	(*keep)[n - 1] = true;
+
+	std::vector<std::pair<size_t, size_t> > segments;
+	if (n > 2) {
+		segments.push_back(std::make_pair(0, n - 1));
+	}
+	while ( !segments.empty() ) {
+		size_t i = segments.back().first;
+		size_t k = segments.back().second;
+		segments.pop_back();
+
+		double maxError = 1.0;
+		size_t worst = i;
+		for (size_t j = i + 1; j < k; ++j) {
+			double e = error(i, k, j);
+			if (e > maxError) {
+				maxError = e;
+				worst = j;
+			}
+		}
+
+		if (worst != i) {
+			(*keep)[worst] = true;
+			if (worst - i > 1) {
+				segments.push_back(std::make_pair(i, worst));
+			}
+			if (k - worst > 1) {
+				segments.push_back(std::make_pair(worst, k));
+			}
+		}
+	}
+}
+
+template<typename Container>
+void copyKnots(const Container& samples, const std::vector<bool>& keep, Container* result)
+{
+	result->clear();
+	for (size_t i = 0; i < keep.size(); ++i) {
+		if (keep[i]) {
+			result->push_back(samples[i]);
+		}
+	}
+}
+
+// The distance between sample j and a math::Spline through the kept samples
+template<typename Container>
+class VectorSplineError {
+public:
+	typedef typename boost::tuples::element<1, typename Container::value_type>::type data_type;
+
+	VectorSplineError(const Container& samples_, double tolerance_) :
+		samples(samples_), tolerance(tolerance_), knots(), spline(NULL) {}
+	~VectorSplineError() {
+		delete spline;
+	}
+
+	void fit(const std::vector<bool>& keep) {
+		copyKnots(samples, keep, &knots);
+		delete spline;
+		spline = NULL;
+		spline = new Spline<data_type>(knots);
+	}
+
+	double operator() (size_t j) const {
+		double e = (boost::get<1>(samples[j]) - spline->eval(boost::get<0>(samples[j]))).norm();
+		return toleranceRatio(e, tolerance);
+	}
+
+protected:
+	const Container& samples;
+	double tolerance;
+	Container knots;
+	Spline<data_type>* spline;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(VectorSplineError);
+};
+
+template<typename PositionContainer, typename OrientationContainer>
+class PoseSplineError {
+public:
+	PoseSplineError(const PositionContainer& positions, const OrientationContainer& orientations_,
+			double positionTolerance, double orientationTolerance_) :
+		pe(positions, positionTolerance), orientations(orientations_), orientationTolerance(orientationTolerance_),
+		knots(), spline(NULL) {}
+	~PoseSplineError() {
+		delete spline;
+	}
+
+	void fit(const std::vector<bool>& keep) {
+		pe.fit(keep);
+		copyKnots(orientations, keep, &knots);
+		delete spline;
+		spline = NULL;
+		spline = new Spline<Eigen::Quaterniond>(knots);
+	}
+
+	double operator() (size_t j) const {
+		double angle = spline->eval(boost::get<0>(orientations[j])).angularDistance(boost::get<1>(orientations[j]));
+		return std::max(pe(j), toleranceRatio(angle, orientationTolerance));
+	}
+
+protected:
+	VectorSplineError<PositionContainer> pe;
+	const OrientationContainer& orientations;
+	double orientationTolerance;
+	OrientationContainer knots;
+	Spline<Eigen::Quaterniond>* spline;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(PoseSplineError);
+};
+
+// Keeps more samples until the spline through the kept samples is within
+// tolerance (error(j) <= 1) of every sample. The spline can overshoot a chord
+// that is itself within tolerance, typically around sharp turns and sudden
+// stops. Each pass keeps the worst sample between each pair of adjacent kept
+// samples where the spline is out of tolerance, then fits the spline again.
+// This ends because samples are only ever added, and a spline through every
+// sample has nothing left to check.
+template<typename ErrorFunction>
+void refineKnots(ErrorFunction& error, std::vector<bool>* keep)
+{
+	const size_t n = keep->size();
+	bool added = n > 2;
+	while (added) {
+		added = false;
+		error.fit(*keep);
+
+		double maxError = 1.0;
+		size_t worst = 0;  // Sample 0 is always kept, so 0 means "none".
+		for (size_t j = 1; j < n; ++j) {
+			if ((*keep)[j]) {
+				if (worst != 0) {
+					(*keep)[worst] = true;
+					added = true;
+				}
+				maxError = 1.0;
+				worst = 0;
+			} else {
+				double e = error(j);
+				if (e > maxError) {
+					maxError = e;
+					worst = j;
+				}
+			}
+		}
+	}
+}
+
+
+}
+
+
+template<typename Container>
+void simplifyTrajectory(const Container& samples, double tolerance, Container* result)
+{
+	if (tolerance < 0.0) {
+		(logMessage("math::%s(): tolerance must be non-negative. Got %g.")
+				% __func__ % tolerance).template raise<std::invalid_argument>();
+	}
+
+	std::vector<bool> keep;
+	detail::markKnots(samples.size(), detail::VectorChordError<Container>(samples, tolerance), &keep);
+	detail::VectorSplineError<Container> splineError(samples, tolerance);
+	detail::refineKnots(splineError, &keep);
+	detail::copyKnots(samples, keep, result);
+}
+
+template<typename PositionContainer, typename OrientationContainer>
+void simplifyTrajectory(const PositionContainer& positions, const OrientationContainer& orientations,
+		double positionTolerance, double orientationTolerance,
+		PositionContainer* positionResult, OrientationContainer* orientationResult)
+{
+	if (positions.size() != orientations.size()) {
+		(logMessage("math::%s(): positions and orientations must have the same number of samples. "
+				"Got %d and %d.") % __func__ % positions.size() % orientations.size())
+				.template raise<std::invalid_argument>();
+	}
+	if (positionTolerance < 0.0  ||  orientationTolerance < 0.0) {
+		(logMessage("math::%s(): tolerances must be non-negative. Got %g and %g.")
+				% __func__ % positionTolerance % orientationTolerance).template raise<std::invalid_argument>();
+	}
+
+	std::vector<bool> keep;
+	detail::markKnots(positions.size(),
+			detail::PoseChordError<PositionContainer, OrientationContainer>(
+					positions, orientations, positionTolerance, orientationTolerance),
+			&keep);
+	detail::PoseSplineError<PositionContainer, OrientationContainer> splineError(
+			positions, orientations, positionTolerance, orientationTolerance);
+	detail::refineKnots(splineError, &keep);
+	detail::copyKnots(positions, keep, positionResult);
+	detail::copyKnots(orientations, keep, orientationResult);
+}
+
+
+}
+}
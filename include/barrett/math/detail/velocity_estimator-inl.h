@@ -0,0 +1,197 @@
+/*
+ * velocity_estimator-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+#include <cmath>
+
+#include <boost/static_assert.hpp>
+
+#include <barrett/os.h>
+
+
+namespace barrett {
+namespace math {
+
+
+template<size_t DOF>
+void FiniteDifferenceVelocityEstimator<DOF>::reset(const jp_type& jp, double t)
+{
+	jp_1 = jp;
+	t_1 = t;
+	this->jv.setZero();
+}
+
+template<size_t DOF>
+inline const typename FiniteDifferenceVelocityEstimator<DOF>::jv_type&
+FiniteDifferenceVelocityEstimator<DOF>::update(const jp_type& jp, double t)
+{
+	double dt = this->sampleInterval(t - t_1);
+	if (dt > 0.0) {
+		this->jv = (jp - jp_1) / dt;
+	}
+
+	jp_1 = jp;
+	t_1 = t;
+	return this->jv;
+}
+
+
+template<size_t DOF, size_t N>
+LeastSquaresVelocityEstimator<DOF,N>::LeastSquaresVelocityEstimator(int order_, double nominalPeriod) :
+	VelocityEstimator<DOF>(nominalPeriod), order(order_),
+	jpHistory(), tHistory(), newest(0), count(0)
+{
+	BOOST_STATIC_ASSERT(N >= 2);
+
+	if (order < 1  ||  order > 2  ||  (size_t)order >= N) {
+		(logMessage("LeastSquaresVelocityEstimator::%s(): order must be 1 or 2 "
+				"and less than the window size (%d). Got order %d.")
+				% __func__ % N % order).template raise<std::invalid_argument>();
+	}
+}
+
+template<size_t DOF, size_t N>
+void LeastSquaresVelocityEstimator<DOF,N>::reset(const jp_type& jp, double t)
+{
+	newest = 0;
+	count = 1;
+	jpHistory[newest] = jp;
+	tHistory[newest] = t;
+	this->jv.setZero();
+}
+
+template<size_t DOF, size_t N>
+const typename LeastSquaresVelocityEstimator<DOF,N>::jv_type&
+LeastSquaresVelocityEstimator<DOF,N>::update(const jp_type& jp, double t)
+{
+	newest = (newest + 1) % N;
+	jpHistory[newest] = jp;
+	tHistory[newest] = t;
+	if (count < N) {
+		++count;
+	}
+
+	// Times are measured relative to the newest sample and in units of the
+	// (nominal or average) sample period to keep the normal equations well
+	// conditioned.
+	size_t oldest = (newest + N - (count - 1)) % N;
+	double scale = this->T_s;
+	if (scale <= 0.0) {
+		scale = (t - tHistory[oldest]) / (count - 1);
+		if (scale <= 0.0) {
+			return this->jv;  // All samples share a timestamp
+		}
+	}
+
+	double S[5] = { 0.0, 0.0, 0.0, 0.0, 0.0 };  // S[j] = sum of tau^j
+	for (size_t i = 0; i < count; ++i) {
+		double tau = (tHistory[(oldest + i) % N] - t) / scale;
+		double tauj = 1.0;
+		for (int j = 0; j <= 2*order; ++j) {
+			S[j] += tauj;
+			tauj *= tau;
+		}
+	}
+
+	// The estimate is a weighted sum of the samples: jv = sum(w_i * jp_i).
+	// w_i = (c0 + c1*tau_i + c2*tau_i^2) / det comes from the row of the
+	// inverted normal equations that corresponds to the linear coefficient.
+	double c0, c1, c2, det;
+	if (order == 1  ||  count < 3) {
+		c0 = -S[1];
+		c1 = S[0];
+		c2 = 0.0;
+		det = S[0]*S[2] - S[1]*S[1];
+	} else {
+		c0 = -(S[1]*S[4] - S[2]*S[3]);
+		c1 = S[0]*S[4] - S[2]*S[2];
+		c2 = -(S[0]*S[3] - S[1]*S[2]);
+		det = S[0]*(S[2]*S[4] - S[3]*S[3]) - S[1]*(S[1]*S[4] - S[3]*S[2]) + S[2]*(S[1]*S[3] - S[2]*S[2]);
+	}
+	if (std::fabs(det) < 1e-12) {
+		return this->jv;
+	}
+
+	this->jv.setZero();
+	for (size_t i = 0; i < count; ++i) {
+		size_t k = (oldest + i) % N;
+		double tau = (tHistory[k] - t) / scale;
+		this->jv += jpHistory[k] * ((c0 + c1*tau + c2*tau*tau) / (det * scale));
+	}
+
+	return this->jv;
+}
+
+
+template<size_t DOF>
+KalmanVelocityEstimator<DOF>::KalmanVelocityEstimator(const v_type& accelerationNoise,
+		const v_type& positionNoise, double nominalPeriod) :
+	VelocityEstimator<DOF>(nominalPeriod), q(accelerationNoise), r(positionNoise),
+	jp(), t_1(0.0), P_pp(), P_pv(), P_vv()
+{
+}
+
+template<size_t DOF>
+void KalmanVelocityEstimator<DOF>::setNoise(const v_type& accelerationNoise, const v_type& positionNoise)
+{
+	q = accelerationNoise;
+	r = positionNoise;
+}
+
+template<size_t DOF>
+void KalmanVelocityEstimator<DOF>::reset(const jp_type& jp_, double t)
+{
+	jp = jp_;
+	t_1 = t;
+	this->jv.setZero();
+
+	// The position is known to within the measurement noise. The velocity is
+	// assumed to be small, but the first few samples will quickly correct it.
+	P_pp = r;
+	P_pv.setZero();
+	P_vv.setConstant(1.0);
+}
+
+template<size_t DOF>
+const typename KalmanVelocityEstimator<DOF>::jv_type&
+KalmanVelocityEstimator<DOF>::update(const jp_type& z, double t)
+{
+	double dt = this->sampleInterval(t - t_1);
+	t_1 = t;
+
+	for (size_t i = 0; i < DOF; ++i) {
+		// Predict
+		if (dt > 0.0) {
+			jp[i] += this->jv[i] * dt;
+
+			P_pp[i] += dt * (2.0*P_pv[i] + dt*P_vv[i]) + q[i] * dt*dt*dt / 3.0;
+			P_pv[i] += dt * P_vv[i] + q[i] * dt*dt / 2.0;
+			P_vv[i] += q[i] * dt;
+		}
+
+		// Correct
+		double S = P_pp[i] + r[i];
+		if (S <= 0.0) {
+			continue;
+		}
+		double K_p = P_pp[i] / S;
+		double K_v = P_pv[i] / S;
+		double y = z[i] - jp[i];
+
+		jp[i] += K_p * y;
+		this->jv[i] += K_v * y;
+
+		P_vv[i] -= K_v * P_pv[i];
+		P_pv[i] *= 1.0 - K_p;
+		P_pp[i] *= 1.0 - K_p;
+	}
+
+	return this->jv;
+}
+
+
+}
+}
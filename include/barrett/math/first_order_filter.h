@@ -37,6 +37,8 @@ public:
 	void setIntegrator(const T& gain = T(1.0));
 	void setParameters(const T& a, const T& b, const T& c);
 
+	// Forget past inputs and outputs, as if eval() had never been called.
+	void reset();
 	const T& eval(const T& input);
 
 	typedef const T& result_type;  ///< For use with boost::bind().
@@ -0,0 +1,124 @@
+/*
+ * gravity_calibrator.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_MATH_GRAVITY_CALIBRATOR_H_
+#define BARRETT_MATH_GRAVITY_CALIBRATOR_H_
+
+
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/units.h>
+
+
+namespace barrett {
+namespace math {
+
+
+/** Fits the first moments of mass (the "mus" used by systems::GravityCompensator)
+ * of a WAM's links to torques measured with the WAM holding still.
+ *
+ * Measurement: addSample() folds one cycle of joint torques and positions into
+ * running means and variances (Welford's algorithm). It does not allocate, so
+ * it can be called from the control loop, typically through a
+ * systems::Callback. Deciding when the WAM is still enough to measure is left
+ * to the caller: bt-wam-gravitycal uses a systems::SettleDetector on the joint
+ * velocities, and restarts the measurement with resetMeasurement() if the WAM
+ * moves.
+ *
+ * Fitting: addPose() records the mean torques of a measurement along with, for
+ * each link, the gravity vector in the link's frame and the link's rotation
+ * relative to the previous link (as computed by bt_calgrav_eval() and
+ * bt_kinematics_eval()). solve() then finds each link's mu, from the last link
+ * to the first, by regularized least-squares. The unknown lateral forces at
+ * each pose are eliminated analytically, so the fit is linear in the number of
+ * poses and uses only fixed-size matrices. The result is identical to solving
+ * the full (3 poses) x (3 + 2 poses) regularized system for each link.
+ */
+template<size_t DOF>
+class GravityCalibrator {
+public:
+	BARRETT_UNITS_TEMPLATE_TYPEDEFS(DOF);
+
+	typedef Eigen::Vector3d mu_type;
+	typedef Eigen::Vector3d gravity_type;
+	typedef Eigen::Matrix3d rotation_type;
+
+	/**
+	 * @param lambda The regularization added to the diagonal of each link's
+	 *        normal equations
+	 */
+	explicit GravityCalibrator(double lambda = 1e-6);
+
+	double getLambda() const { return lambda; }
+
+
+	/// Discards the current measurement.
+	void resetMeasurement();
+
+	/// Adds one sample to the current measurement.
+	void addSample(const jt_type& jt, const jp_type& jp);
+
+	size_t numSamples() const { return n; }
+	const jt_type& getMeanTorque() const { return meanJt; }
+	const jp_type& getMeanPosition() const { return meanJp; }
+	/// The population variance of the samples in the current measurement
+	jt_type getTorqueVariance() const;
+	/// The population variance of the samples in the current measurement
+	jp_type getPositionVariance() const;
+
+
+	/** Records the torques measured at a pose.
+	 *
+	 * \c g[j] is the gravity vector expressed in link \c j's frame and
+	 * \c rotToPrev[j] is the rotation from link \c j's frame to link \c j-1's.
+	 */
+	void addPose(const jt_type& jt, const gravity_type g[DOF], const rotation_type rotToPrev[DOF]);
+	size_t numPoses() const { return poses.size(); }
+	void clearPoses() { poses.clear(); }
+
+	/// Fits the mus to the recorded poses. Requires at least one pose.
+	void solve(mu_type mus[DOF]) const;
+
+protected:
+	double lambda;
+
+	size_t n;
+	jt_type meanJt, m2Jt;
+	jp_type meanJp, m2Jp;
+
+	struct Pose {
+		jt_type jt;
+		gravity_type g[DOF];
+		rotation_type rotToPrev[DOF];
+
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+	std::vector<Pose, Eigen::aligned_allocator<Pose> > poses;
+
+	void linkEquations(const Pose& pose, size_t j, const Eigen::Vector2d& fNext,
+			Eigen::Matrix3d* S, Eigen::Matrix<double, 3,2>* B, Eigen::Vector3d* b) const;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(GravityCalibrator);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/math/detail/gravity_calibrator-inl.h>
+
+
+#endif /* BARRETT_MATH_GRAVITY_CALIBRATOR_H_ */
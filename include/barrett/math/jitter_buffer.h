@@ -0,0 +1,119 @@
+/*
+ * jitter_buffer.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_MATH_JITTER_BUFFER_H_
+#define BARRETT_MATH_JITTER_BUFFER_H_
+
+
+#include <stdint.h>
+
+#include <Eigen/Core>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/math/traits.h>
+
+
+namespace barrett {
+namespace math {
+
+
+/** Turns time-stamped samples that arrive over a network into a smooth signal.
+ *
+ * add() takes each sample with its sequence number, the sender's time stamp
+ * and the local time it was received. Samples that arrive after a newer one
+ * are discarded, unless they are more than MAX_MISORDER behind it: then the
+ * sender is assumed to have restarted, and the sample starts a new stream. The sender's and receiver's clocks don't need to agree: the
+ * offset between them (plus the smallest network delay) is tracked as the
+ * base transit time, the minimum of (receive time - send time). It is allowed
+ * to rise slowly so that it follows clock drift and route changes.
+ *
+ * eval() maps local time to the sender's time and plays the samples back
+ * playoutDelay seconds behind. Between samples, the output is interpolated.
+ * Past the newest sample (when a packet is late or lost, or if playoutDelay
+ * is zero), the output is extrapolated from the two newest samples for up to
+ * maxExtrapolation seconds and then held. A larger playoutDelay rides out more
+ * jitter at the cost of latency.
+ *
+ * Also keeps the counts of lost and late samples and the interarrival jitter
+ * as defined by RFC 3550.
+ */
+template<typename T, typename MathTraits = math::Traits<T> >
+class JitterBuffer {
+protected:
+	typedef MathTraits MT;
+
+public:
+	static const size_t CAPACITY = 16;
+	/// The rate (seconds per second) at which the base transit time may rise
+	static const double BASE_TRANSIT_DRIFT = 1e-3;
+	/// How far (in sequence numbers) a sample may trail the newest one and
+	/// still be counted as late. This is RFC 3550's MAX_MISORDER.
+	static const int32_t MAX_MISORDER = 100;
+
+	explicit JitterBuffer(double playoutDelay = 0.0, double maxExtrapolation = 0.01);
+
+	double getPlayoutDelay() const { return playoutDelay; }
+	double getMaxExtrapolation() const { return maxExtrapolation; }
+
+	/// Discards all samples and statistics.
+	void reset();
+	/// Discards all samples, keeping the statistics. The next sample added
+	/// starts a new stream, whatever its sequence number.
+	void restart() { count = 0; }
+
+	/// Returns false if the sample is a duplicate or arrived (no more than
+	/// MAX_MISORDER) after a newer one.
+	bool add(uint32_t seq, double sendTime, double receiveTime, const T& value);
+
+	/// Returns false if no samples have been added.
+	bool eval(double now, T* value) const;
+
+	size_t size() const { return count; }
+	double getLastReceiveTime() const { return lastReceiveTime; }
+	double getBaseTransit() const { return baseTransit; }
+	double getJitter() const { return jitter; }
+	/// Gaps in the sequence numbers, less the samples that later filled them
+	unsigned long getNumLost() const { return numLost; }
+	/// Duplicates and samples that arrived after a newer one
+	unsigned long getNumLate() const { return numLate; }
+
+protected:
+	double playoutDelay;
+	double maxExtrapolation;
+
+	struct Sample {
+		double time;
+		T value;
+
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF(MT::RequiresAlignment)
+	};
+	Sample samples[CAPACITY];  // A ring; samples[newest] is the newest
+	size_t newest, count;
+
+	uint32_t newestSeq;
+	double lastReceiveTime, baseTransit, lastTransit, jitter;
+	unsigned long numLost, numLate;
+
+	// The i-th newest sample
+	const Sample& sample(size_t i) const { return samples[(newest + CAPACITY - i) % CAPACITY]; }
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(JitterBuffer);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF(MT::RequiresAlignment)
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/math/detail/jitter_buffer-inl.h>
+
+
+#endif /* BARRETT_MATH_JITTER_BUFFER_H_ */
@@ -0,0 +1,93 @@
+/*
+ * s_curve_profile.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_MATH_S_CURVE_PROFILE_H_
+#define BARRETT_MATH_S_CURVE_PROFILE_H_
+
+
+namespace barrett {
+namespace math {
+
+
+/** A time-optimal, jerk-limited, rest-to-rest velocity profile.
+ *
+ * Like TrapezoidalVelocityProfile, this maps time to distance along a path of
+ * length \c pathLength (for instance, the \c s parameter of a math::Spline).
+ * Unlike TrapezoidalVelocityProfile, the acceleration ramps up and down at the
+ * given jerk instead of jumping, so the profile has up to seven segments:
+ *   -# jerk +j,
+ *   -# constant acceleration,
+ *   -# jerk -j,
+ *   -# constant velocity,
+ *   -# jerk -j,
+ *   -# constant deceleration,
+ *   -# jerk +j.
+ *
+ * Segments are dropped when the path is too short to reach the velocity or
+ * acceleration limit. The segment boundaries are computed in the constructor;
+ * eval() is closed-form and does not allocate.
+ *
+ * Compared to a TrapezoidalVelocityProfile with the same velocity and
+ * acceleration, a move takes at most 2*acceleration/jerk seconds longer, or
+ * acceleration/jerk seconds longer if it reaches the velocity limit.
+ */
+class SCurveProfile {
+public:
+	static const int NUM_SEGMENTS = 7;
+
+	SCurveProfile(double velocity, double acceleration, double jerk,
+			double pathLength);
+
+	/** A straight-line move of several DOF with per-DOF limits.
+	 *
+	 * The path is parameterized by distance, so its length is
+	 * displacement.norm(). The path limits are the largest for which every
+	 * DOF stays within its own limits. All DOF start and finish together.
+	 */
+	template<typename T>
+	SCurveProfile(const T& displacement, const T& velocity,
+			const T& acceleration, const T& jerk);
+
+	double finalT() const { return segT[NUM_SEGMENTS]; }
+
+	double eval(double t) const;
+	/// The rate of change of eval() at time \c t
+	double evalDerivative(double t) const;
+	/// The rate of change of evalDerivative() at time \c t
+	double evalSecondDerivative(double t) const;
+
+	double getVelocity() const { return v; }
+	double getAcceleration() const { return a; }
+	double getJerk() const { return j; }
+	double getPathLength() const { return l; }
+
+	typedef double result_type;  ///< For use with boost::bind().
+	result_type operator() (double t) const {
+		return eval(t);
+	}
+
+protected:
+	void init();
+	int segment(double t) const;
+
+	double v, a, j, l;
+
+	// Segment i runs from segT[i] to segT[i+1] with constant jerk segJ[i]
+	// and starts at position segS[i], velocity segV[i], acceleration segA[i].
+	double segT[NUM_SEGMENTS + 1];
+	double segS[NUM_SEGMENTS], segV[NUM_SEGMENTS], segA[NUM_SEGMENTS], segJ[NUM_SEGMENTS];
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/math/detail/s_curve_profile-inl.h>
+
+
+#endif /* BARRETT_MATH_S_CURVE_PROFILE_H_ */
@@ -65,6 +65,8 @@ public:
 	// initialDirection will be normalized internally
 	template<template<typename, typename> class Container, typename Allocator>
 	Spline(const Container<T, Allocator>& points, /*const typename T::unitless_type& initialDirection = typename T::unitless_type(0.0),*/ bool saturateS = true);
+	template<template<typename, typename> class Container, typename Allocator>
+	Spline(const Container<T, Allocator>& points, const typename T::unitless_type& initialDirection, bool saturateS = true);
 
 	~Spline();
 
@@ -75,6 +77,14 @@ public:
 	T eval(double s) const;
 	T evalDerivative(double s) const;
 
+	/** Evaluates the spline at each s in [\c sBegin, \c sEnd).
+	 *
+	 * Use this to pre-render a trajectory. It keeps its own lookup state, so
+	 * several threads can call it at once, alongside eval().
+	 */
+	template<typename InputIterator, typename OutputIterator>
+	void eval(InputIterator sBegin, InputIterator sEnd, OutputIterator result) const;
+
 	typedef T result_type;  ///< For use with boost::bind().
 	result_type operator() (double s) const {
 		return eval(s);
@@ -95,6 +105,11 @@ private:
 
 
 // Specialization for Eigen::Quaternion<> types
+//
+// Interpolates with SQUAD (spherical quadrangle interpolation). Each segment
+// has two intermediate control quaternions, computed in the constructor so that
+// the angular velocity is continuous at the samples, even when the samples are
+// unevenly spaced in s.
 template<typename Scalar>
 class Spline<Eigen::Quaternion<Scalar> > {
 public:
@@ -112,19 +127,36 @@ public:
 	double finalS() const { return boost::get<0>(data.back()); }
 	double changeInS() const { return finalS() - initialS(); }
 
+	// Finding the segment is O(1) when s changes monotonically between calls,
+	// and O(log n) otherwise.
 	data_type eval(double s) const;
 
+	/** Evaluates the spline at each s in [\c sBegin, \c sEnd).
+	 *
+	 * Use this to pre-render a trajectory. It doesn't change the state used by
+	 * eval(), so it can run in another thread.
+	 */
+	template<typename InputIterator, typename OutputIterator>
+	void eval(InputIterator sBegin, InputIterator sEnd, OutputIterator result) const;
+
 	typedef data_type result_type;  ///< For use with boost::bind().
 	result_type operator() (double s) const {
 		return eval(s);
 	}
 
 protected:
+	void init();
+	size_t findSegment(double s, size_t hint) const;
+	data_type evalSegment(size_t i, double s) const;
+
 	std::vector<tuple_type, Eigen::aligned_allocator<tuple_type> > data;
+	// Segment i runs from data[i] to data[i+1]. Its control quaternions are
+	// outgoing[i] and incoming[i], and rates[i] is 1/(s_{i+1} - s_i).
+	std::vector<data_type, Eigen::aligned_allocator<data_type> > outgoing, incoming;
+	std::vector<double> rates;
 	bool sat;
 
 	mutable size_t index;
-	mutable double rate;
 
 private:
 	// TODO(dc): write a real copy constructor and assignment operator?
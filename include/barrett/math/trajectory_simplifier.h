@@ -0,0 +1,58 @@
+/*
+ * trajectory_simplifier.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_MATH_TRAJECTORY_SIMPLIFIER_H_
+#define BARRETT_MATH_TRAJECTORY_SIMPLIFIER_H_
+
+
+namespace barrett {
+namespace math {
+
+
+/** Removes samples from a recorded trajectory while staying within \c tolerance of it.
+ *
+ * Container holds time-stamped samples (boost::tuple<double, T>, sorted by
+ * time) where T is a math::Vector such as jp_type or cp_type. The result is a
+ * subset of the samples, including the first and the last, suitable for
+ * constructing a math::Spline with far fewer knots.
+ *
+ * This is the Ramer-Douglas-Peucker algorithm, but the error of a dropped
+ * sample is its distance from the straight line between the surrounding kept
+ * samples *at the same time*, so the timing of the motion is preserved as well
+ * as its shape. A math::Spline through those samples can still overshoot the
+ * line, so the spline is then checked against every dropped sample and more
+ * samples are kept where it strays. Every dropped sample is within
+ * \c tolerance of a math::Spline constructed from the result.
+ *
+ * Typically O(n log n), O(n^2) in the worst case.
+ */
+template<typename Container>
+void simplifyTrajectory(const Container& samples, double tolerance, Container* result);
+
+/** Removes samples from a recorded Cartesian pose trajectory.
+ *
+ * As above, but for the positions (boost::tuple<double, cp_type>) and
+ * orientations (boost::tuple<double, Eigen::Quaterniond>) of a pose
+ * trajectory. The orientation error is the angle between a dropped sample and
+ * the slerp between the surrounding kept samples, then the SQUAD of a
+ * math::Spline<Eigen::Quaterniond>. A sample is kept if either error is over
+ * its tolerance, and both results keep the same samples.
+ */
+template<typename PositionContainer, typename OrientationContainer>
+void simplifyTrajectory(const PositionContainer& positions, const OrientationContainer& orientations,
+		double positionTolerance, double orientationTolerance,
+		PositionContainer* positionResult, OrientationContainer* orientationResult);
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/math/detail/trajectory_simplifier-inl.h>
+
+
+#endif /* BARRETT_MATH_TRAJECTORY_SIMPLIFIER_H_ */
@@ -29,6 +29,8 @@ public:
 	double finalT() const;
 
 	double eval(double t) const;
+	/// The rate of change of eval() at time \c t
+	double evalDerivative(double t) const;
 
 	typedef double result_type;  ///< For use with boost::bind().
 	result_type operator() (double t) const {
@@ -0,0 +1,167 @@
+/*
+ * velocity_estimator.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_MATH_VELOCITY_ESTIMATOR_H_
+#define BARRETT_MATH_VELOCITY_ESTIMATOR_H_
+
+
+#include <boost/array.hpp>
+#include <Eigen/Core>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/units.h>
+
+
+namespace barrett {
+namespace math {
+
+
+/** Estimates joint velocities from a stream of timestamped joint positions.
+ *
+ * Implementations must not allocate memory in reset() or update() so that they
+ * can be used from within the control loop (see LowLevelWam::update()).
+ *
+ * If the nominal sample period is set, it is used in place of the measured
+ * sample interval whenever the latter is not positive (for instance, when two
+ * samples share a timestamp).
+ */
+template<size_t DOF>
+class VelocityEstimator {
+public:
+	BARRETT_UNITS_TEMPLATE_TYPEDEFS(DOF);
+
+	explicit VelocityEstimator(double nominalPeriod = 0.0) :
+		T_s(nominalPeriod), jv() {}
+	virtual ~VelocityEstimator() {}
+
+	void setNominalPeriod(double nominalPeriod) { T_s = nominalPeriod; }
+	double getNominalPeriod() const { return T_s; }
+
+	/// Forget all history. The velocity estimate is set to zero.
+	virtual void reset(const jp_type& jp, double t) = 0;
+	virtual const jv_type& update(const jp_type& jp, double t) = 0;
+
+	const jv_type& getVelocity() const { return jv; }
+
+protected:
+	double sampleInterval(double dt) const {
+		return (dt > 0.0  ||  T_s <= 0.0) ? dt : T_s;
+	}
+
+	double T_s;
+	jv_type jv;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(VelocityEstimator);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+/// Backward difference of consecutive samples. This is LowLevelWam's default.
+template<size_t DOF>
+class FiniteDifferenceVelocityEstimator : public VelocityEstimator<DOF> {
+public:
+	BARRETT_UNITS_TEMPLATE_TYPEDEFS(DOF);
+
+	explicit FiniteDifferenceVelocityEstimator(double nominalPeriod = 0.0) :
+		VelocityEstimator<DOF>(nominalPeriod), jp_1(), t_1(0.0) {}
+
+	virtual void reset(const jp_type& jp, double t);
+	virtual const jv_type& update(const jp_type& jp, double t);
+
+protected:
+	jp_type jp_1;
+	double t_1;
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+/** Fits a polynomial to the last \c N samples and differentiates it at the
+ * newest sample.
+ *
+ * With evenly spaced samples this is a Savitzky-Golay differentiator. Samples
+ * are weighted by their actual timestamps, so jitter in the sample times does
+ * not bias the estimate.
+ *
+ * A first-order (linear) fit has the least noise, but lags a changing velocity
+ * by roughly half the window. A second-order fit tracks constant accelerations
+ * without lag at the cost of more noise.
+ */
+template<size_t DOF, size_t N = 5>
+class LeastSquaresVelocityEstimator : public VelocityEstimator<DOF> {
+public:
+	BARRETT_UNITS_TEMPLATE_TYPEDEFS(DOF);
+
+	explicit LeastSquaresVelocityEstimator(int order = 1, double nominalPeriod = 0.0);
+
+	int getOrder() const { return order; }
+
+	virtual void reset(const jp_type& jp, double t);
+	virtual const jv_type& update(const jp_type& jp, double t);
+
+protected:
+	int order;
+
+	boost::array<jp_type, N> jpHistory;
+	boost::array<double, N> tHistory;
+	size_t newest, count;
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+/** A constant-velocity Kalman filter for each joint.
+ *
+ * The joint accelerations are modeled as white noise with (one-sided) spectral
+ * density \c accelerationNoise ((rad/s^2)^2/Hz). Position measurements have
+ * variance \c positionNoise (rad^2); for a quantized encoder with resolution
+ * \c r radians, r^2/12 is a good starting point.
+ *
+ * Increasing \c accelerationNoise relative to \c positionNoise makes the
+ * estimate respond faster and filter less.
+ */
+template<size_t DOF>
+class KalmanVelocityEstimator : public VelocityEstimator<DOF> {
+public:
+	BARRETT_UNITS_TEMPLATE_TYPEDEFS(DOF);
+
+	KalmanVelocityEstimator(const v_type& accelerationNoise,
+			const v_type& positionNoise, double nominalPeriod = 0.0);
+
+	void setNoise(const v_type& accelerationNoise, const v_type& positionNoise);
+	const jp_type& getPosition() const { return jp; }
+
+	virtual void reset(const jp_type& jp, double t);
+	virtual const jv_type& update(const jp_type& jp, double t);
+
+protected:
+	v_type q, r;
+
+	jp_type jp;
+	double t_1;
+
+	// Symmetric state covariance
+	v_type P_pp, P_pv, P_vv;
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/math/detail/velocity_estimator-inl.h>
+
+
+#endif /* BARRETT_MATH_VELOCITY_ESTIMATOR_H_ */
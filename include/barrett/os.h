@@ -30,6 +30,8 @@
 
 
 #include <string>
+#include <time.h>
+
 #include <barrett/detail/os.h>
 
 
@@ -47,16 +49,39 @@ void btsleep(double duration_s, bool realtime);
  */
 double highResolutionSystemTime();
 
+/** PeriodicLoopTimer releases the calling thread once per period.
+ *
+ * The constructor prepares the calling thread for real-time work. Under
+ * Xenomai, the thread becomes a Xenomai task. Otherwise, the thread is
+ * optionally pinned to a CPU (typically one reserved with the isolcpus kernel
+ * parameter) and, if threadPriority > 0, it is given the SCHED_FIFO policy at
+ * threadPriority, the process' memory is locked with mlockall(), and the
+ * thread's stack is prefaulted. Pass a threadPriority of 0 for an ordinary
+ * thread. Failures due to insufficient privileges are logged, not thrown, so
+ * the timer still works for unprivileged users.
+ *
+ * Release points are kept on CLOCK_MONOTONIC and slept until with an absolute
+ * deadline, so the loop does not drift. wait() returns the number of release
+ * points that were missed since the previous call.
+ */
 class PeriodicLoopTimer {
 public:
-	explicit PeriodicLoopTimer(double period_, int threadPriority = 10);
+	explicit PeriodicLoopTimer(double period_, int threadPriority = 10, int cpu = -1);
 
 	unsigned long wait();
 
+	/// Total number of release points missed since construction.
+	unsigned long getNumMissedReleasePoints() const { return numMissed; }
+
 protected:
 	bool firstRun;
 	double period;
-	double releasePoint;
+	unsigned long numMissed;
+
+	// Unused under Xenomai. (The class layout must not depend on
+	// BARRETT_XENOMAI, which is only defined for OS-dependent sources.)
+	long period_ns;
+	struct timespec releasePoint;
 };
 
 
@@ -72,6 +97,33 @@ protected:
 detail::LogFormatter logMessage(const std::string& message,
 		bool outputToStderr = false);
 
+/** logMessageRT is a real-time safe version of logMessage.
+ *
+ * Arguments are captured in a fixed-size record (format string, up to 8
+ * arguments, and the highResolutionSystemTime()) and pushed onto a lock-free
+ * queue. A background thread formats queued records and outputs them the same
+ * way logMessage does. If the queue is full, the record is dropped and
+ * counted; the count is reported by the background thread. Until
+ * startRealTimeLogging() is called, records are output immediately, like
+ * logMessage, except that records from real-time (SCHED_FIFO, SCHED_RR, or
+ * Xenomai) threads are dropped and counted.
+ *
+ * Only char, integer, double, and const char* arguments are supported. The
+ * format string and any string arguments are not copied, so they must remain
+ * valid until the record is printed (string literals, __func__, strerror()).
+ *   barrett::logMessageRT("%s: Error %d", true) % __func__ % 5;
+ */
+detail::RealTimeLogFormatter logMessageRT(const char* message,
+		bool outputToStderr = false);
+/// Number of logMessageRT() records dropped because the queue was full or
+/// because a real-time thread logged before logging was started.
+unsigned long getNumDroppedRealTimeLogMessages();
+/// Start the background thread used by logMessageRT(). PeriodicLoopTimer and
+/// ProductManager call this from the thread constructing them, so that the
+/// logger never has to be started from a real-time thread. Calling it again
+/// has no effect.
+void startRealTimeLogging();
+
 
 }
 
@@ -67,7 +67,8 @@ LowLevelWam<DOF>::LowLevelWam(const std::vector<Puck*>& _pucks, SafetyModule* _s
 	safetyModule(_safetyModule), torqueGroups(),
 	home(setting["home"]), j2mp(setting["j2mp"]),
 	noJointEncoders(true), positionSensor(PS_MOTOR_ENCODER),
-	lastUpdate(0.0), torquePropId(group.getPropertyId(Puck::T))
+	lastUpdate(0.0), velocityEstimator(new math::FiniteDifferenceVelocityEstimator<DOF>),
+	resetVelocityEstimator(true), torquePropId(group.getPropertyId(Puck::T))
 {
 	logMessage("  Config setting: %s => \"%s\"") % setting.getSourceFile() % setting.getPath();
 
@@ -229,15 +230,15 @@ LowLevelWam<DOF>::LowLevelWam(const std::vector<Puck*>& _pucks, SafetyModule* _s
 	}
 
 
-	// Get good initial values for jp_1 and lastUpdate
+	// Get a good initial value for the velocity estimator
 	update();
-	jv_best.setZero();
 }
 
 template<size_t DOF>
 LowLevelWam<DOF>::~LowLevelWam()
 {
 	detail::purge(torqueGroups);
+	delete velocityEstimator;
 }
 
 
@@ -321,13 +322,35 @@ void LowLevelWam<DOF>::update()
 		}
 	}
 
-	jv_best = (jp_best - jp_best_1) / (now - lastUpdate);
+	if (resetVelocityEstimator) {
+		velocityEstimator->reset(jp_best, now);
+		resetVelocityEstimator = false;
+	} else {
+		velocityEstimator->update(jp_best, now);
+	}
+	jv_best = velocityEstimator->getVelocity();
 	// TODO(dc): Detect unreasonably large velocities
 
-	jp_best_1 = jp_best;
 	lastUpdate = now;
 }
 
+template<size_t DOF>
+void LowLevelWam<DOF>::setVelocityEstimator(math::VelocityEstimator<DOF>* ve)
+{
+	if (ve == NULL) {
+		ve = new math::FiniteDifferenceVelocityEstimator<DOF>;
+	}
+
+	{
+		// Synchronize with execution-cycle
+		BARRETT_SCOPED_LOCK(bus.getMutex());
+
+		delete velocityEstimator;
+		velocityEstimator = ve;
+		resetVelocityEstimator = true;
+	}
+}
+
 template<size_t DOF>
 void LowLevelWam<DOF>::setTorques(const jt_type& jt)
 {
@@ -360,6 +383,9 @@ void LowLevelWam<DOF>::definePosition(const jp_type& jp)
 		for (size_t i = 0; i < DOF; ++i) {
 			pucks[i]->setProperty(Puck::P, floor(pp[i]));
 		}
+
+		// Don't differentiate across the discontinuity
+		resetVelocityEstimator = true;
 	}
 
 	// Record the fact that the WAM has been zeroed
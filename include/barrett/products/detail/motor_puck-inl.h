@@ -40,7 +40,7 @@ namespace barrett {
 template<typename ResultType>
 int MotorPuck::MotorPositionParser<ResultType>::parse(int id, int propId, result_type* result, const unsigned char* data, size_t len) {
 	if (len != 3 && len != 6) {
-		logMessage("%s: expected message length of 3 or 6, got message length of %d") % __func__ % len;
+		logMessageRT("%s: expected message length of 3 or 6, got message length of %d") % __func__ % len;
 		return 1;
 	}
 
@@ -50,7 +50,7 @@ int MotorPuck::MotorPositionParser<ResultType>::parse(int id, int propId, result
 template<typename ResultType>
 int MotorPuck::SecondaryPositionParser<ResultType>::parse(int id, int propId, result_type* result, const unsigned char* data, size_t len) {
 	if (len != 3) {
-		logMessage("%s: expected message length of 3, got message length of %d") % __func__ % len;
+		logMessageRT("%s: expected message length of 3, got message length of %d") % __func__ % len;
 		return 1;
 	}
 
@@ -66,7 +66,7 @@ int MotorPuck::CombinedPositionParser<ResultType>::parse(int id, int propId, res
 		boost::get<0>(*result) = twentyTwoBit2<ResultType>(data[0], data[1], data[2]);
 		boost::get<1>(*result) = std::numeric_limits<ResultType>::max();
 	} else {
-		logMessage("%s: expected message length of 3 or 6, got message length of %d") % __func__ % len;
+		logMessageRT("%s: expected message length of 3 or 6, got message length of %d") % __func__ % len;
 		return 1;
 	}
 
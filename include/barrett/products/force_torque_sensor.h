@@ -61,6 +61,10 @@ public:
 	void tare() { Puck::setProperty(*bus, id, propId, 0); }
 	/** update Method establishes new force and torque values from the sensor */
 	void update(bool realtime = false);
+	/** requestUpdate Method asks the sensor for new force and torque values without waiting for the reply */
+	void requestUpdate();
+	/** receiveUpdate Method receives the reply to a previous requestUpdate() call */
+	void receiveUpdate(bool realtime = false);
 	/** getForce Method returns cartesian force values for each axis in n/m */
 	const cf_type& getForce() const { return cf; }
 	/** getTorque Method returns cartesian torque values for each axis in torque units */
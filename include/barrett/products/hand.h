@@ -109,9 +109,14 @@ public:
 	static const unsigned int S_POSITION          = 1 << 0;
 	static const unsigned int S_FINGERTIP_TORQUE = 1 << 1;
 	static const unsigned int S_TACT_FULL         = 1 << 2;
+	static const unsigned int S_TACT_TOP10        = 1 << 3;  // Ignored if S_TACT_FULL is also given
 	static const unsigned int S_ALL = S_POSITION | S_FINGERTIP_TORQUE | S_TACT_FULL;
 	/** update Method */
 	void update(unsigned int sensors = S_ALL, bool realtime = false);
+	/** requestUpdate Method sends requests for the given sensors without waiting for the replies */
+	void requestUpdate(unsigned int sensors = S_ALL) const;
+	/** receiveUpdate Method receives the replies to a previous requestUpdate() call */
+	void receiveUpdate(unsigned int sensors = S_ALL, bool realtime = false);
 	/** getInnerLinkPosition Method */
 	const jp_type& getInnerLinkPosition() const { return innerJp; }
 	/** getOuterLinkPosition Method */
@@ -41,6 +41,7 @@
 #include <libconfig.h++>
 
 #include <barrett/units.h>
+#include <barrett/math/velocity_estimator.h>
 #include <barrett/products/puck.h>
 #include <barrett/products/motor_puck.h>
 #include <barrett/products/safety_module.h>
@@ -67,6 +68,13 @@ public:
 	const jp_type& getJointPositions(enum PositionSensor sensor = PS_BEST) const;
 	const jv_type& getJointVelocities() const { return jv_best; }
 
+	/** Replaces the velocity estimator used by update(). The LowLevelWam takes
+	 * ownership of ve. Passing NULL restores the default
+	 * math::FiniteDifferenceVelocityEstimator.
+	 */
+	void setVelocityEstimator(math::VelocityEstimator<DOF>* ve);
+	math::VelocityEstimator<DOF>& getVelocityEstimator() const { return *velocityEstimator; }
+
 
 	bool hasJointEncoders() const { return !noJointEncoders; }
 	void setPositionSensor(enum PositionSensor sensor);
@@ -110,8 +118,10 @@ protected:
 	v_type pp;
 	math::Matrix<DOF,2> pp_jep;
 	jp_type jp_motorEncoder, jp_jointEncoder;
-	jp_type jp_best, jp_best_1;
+	jp_type jp_best;
 	jv_type jv_best;
+	math::VelocityEstimator<DOF>* velocityEstimator;
+	bool resetVelocityEstimator;
 
 	v_type pt;
 	int torquePropId;
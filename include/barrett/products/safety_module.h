@@ -36,6 +36,9 @@
 
 #include <string>
 
+#include <barrett/detail/ca_macro.h>
+#include <barrett/thread/seqlock.h>
+#include <barrett/bus/bus_manager.h>
 #include <barrett/products/puck.h>
 #include <barrett/products/abstract/special_puck.h>
 
@@ -56,7 +59,13 @@ public:
 	 *
 	 */
 	SafetyModule(Puck* puck = NULL);
-	~SafetyModule() {}
+	~SafetyModule();
+	/** setPuck Method changes the Puck, moving the bus monitor to the new Puck's bus
+	 *
+	 *	Hides SpecialPuck::setPuck(), which doesn't know about the monitor. The
+	 *	Telemetry is cleared.
+	 */
+	void setPuck(Puck* puck);
 	/** getMode Method returns current state of Safety Pendant (E-Stopped/Idle/Active)
 	 *
 	 */
@@ -139,12 +148,110 @@ public:
  *	Method will update the current button, mode and parameter status values.
  */
 	void getPendantState(PendantState* ps, bool realtime = false) const;
+	/** decodePendantState Method fills ps from a raw PEN value
+	 *
+	 *	Returns false (without logging) if pen is malformed.
+	 */
+	static bool decodePendantState(int pen, PendantState* ps);
+	/** decodeSafetyParameter Method fills state with one parameter from a raw PEN value
+	 *
+	 *	Returns false (without logging) if that parameter's bits are malformed.
+	 */
+	static bool decodeSafetyParameter(int pen, enum PendantState::ParameterNames param,
+			enum PendantState::Parameter* state);
+
+
+	/** Telemetry holds the SafetyModule state most recently observed on the bus.
+	 *
+	 *	Times are highResolutionSystemTime() values. A field is only meaningful
+	 *	if its corresponding *Valid flag is set.
+	 */
+	struct Telemetry {
+		bool modeValid;
+		enum SafetyMode mode;
+		double modeTime;
+
+		bool pendantStateValid;
+		PendantState pendantState;
+		double pendantStateTime;
+
+		/// SAFE, WARNING, or FAULT, from the latest PEN value. Valid even if
+		/// another part of that value was malformed.
+		bool limitStatesValid;
+		enum PendantState::Parameter velocityState;
+		enum PendantState::Parameter torqueState;
+		double limitStatesTime;
+
+		unsigned long numBroadcasts;
+		int broadcastProperty;
+		int broadcastValue;
+		double broadcastTime;
+	};
+
+	/** isMonitoringBus Method returns true if Telemetry is being collected
+	 *
+	 *	Telemetry is collected passively: every MODE and PEN reply from the
+	 *	SafetyModule (no matter who requested it) and every SafetyModule
+	 *	broadcast is decoded as it is received. This requires the Puck to be on
+	 *	a bus::BusManager.
+	 *
+	 *	Other than by pollMode(), nothing is requested on the Telemetry's behalf,
+	 *	so MODE and PEN are only as fresh as the last time some thread read them
+	 *	(SafetyModule::waitForMode() polls MODE, for example), unless the
+	 *	broadcast carries them. What the broadcast carries hasn't been confirmed
+	 *	against the hardware.
+	 */
+	bool isMonitoringBus() const { return monitoredBus != NULL; }
+	/** getTelemetry Method returns a consistent copy of the latest Telemetry
+	 *
+	 *	Never touches the bus, so it is safe to call from any thread.
+	 */
+	Telemetry getTelemetry() const { return telemetry.read(); }
+	/** getObservedMode Method
+	 *
+	 *	If a MODE value was observed within the last maxAge_s seconds, stores it
+	 *	in *mode and returns true. Otherwise returns false. Never touches the bus.
+	 */
+	bool getObservedMode(enum SafetyMode* mode, double maxAge_s) const;
+	/** pollMode Method keeps the observed MODE fresh without blocking
+	 *
+	 *	Each call collects the reply to the previous MODE request if it has
+	 *	arrived, then sends a new request if none is outstanding and the last
+	 *	one was sent at least period_s ago. A request that goes unanswered for
+	 *	longer than CommunicationsBus::TIMEOUT is abandoned. The reply is
+	 *	decoded into the Telemetry, so this does nothing unless
+	 *	isMonitoringBus(). Safe to call from a real-time thread.
+	 */
+	void pollMode(double period_s);
 
 protected:
 	static const int VELOCITY_FAULT_HISTORY_BUFFER_SIZE = 5;
 
+	class BusMonitor : public bus::BusManager::MessageObserver {
+	public:
+		explicit BusMonitor(SafetyModule* _sm) : sm(_sm) {}
+		virtual void messageReceived(int busId, const unsigned char* data, size_t len);
+	protected:
+		SafetyModule* sm;
+	};
+	friend class BusMonitor;
+
+	void startMonitoring();
+	void stopMonitoring();
+	void processProperty(int propId, int value, bool broadcast);
+
+	bus::BusManager* monitoredBus;
+	int modePropId, penPropId;
+	bool modeRequestPending;
+	double modeRequestTime;
+	BusMonitor monitor;
+	Telemetry telemetryBuffer;  // only accessed by the BusMonitor, or while it isn't registered
+	thread::SeqLock<Telemetry> telemetry;
+
 private:
 	static const char safetyModeStrs[][15];
+
+	DISALLOW_COPY_AND_ASSIGN(SafetyModule);
 };
 
 
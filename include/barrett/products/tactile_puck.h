@@ -47,6 +47,19 @@ public:
 	static const size_t NUM_SENSORS = 24;
 	typedef math::Vector<NUM_SENSORS>::type v_type;
 
+	/// Number of CAN frames in each FULL formatted reply
+	static const size_t NUM_FULL_MESSAGES = 5;
+	/// Number of CAN frames in each TOP10 formatted reply
+	static const size_t NUM_TOP10_MESSAGES = 1;
+
+	/** Selects the format used by request(), receive(), and update().
+	 *
+	 * In TM_AUTO mode, the Puck reports in TOP10 format until one of the cells
+	 * reaches the contact threshold, then reports in FULL format until every
+	 * cell drops below the release threshold.
+	 */
+	enum TactMode { TM_FULL, TM_TOP10, TM_AUTO };
+
 protected:
 	enum TactState { NONE, TOP10_FORMAT, FULL_FORMAT, TARE };
 
@@ -54,7 +67,11 @@ public:
 	/**
 	 *
 	 */
-	TactilePuck(Puck* puck = NULL) : SpecialPuck() { setPuck(puck); }
+	TactilePuck(Puck* puck = NULL) :
+		SpecialPuck(), mode(TM_FULL), contactThreshold(1.0), releaseThreshold(0.5), inContact(false)
+	{
+		setPuck(puck);
+	}
 	~TactilePuck() {}
 /**
  *
@@ -71,11 +88,21 @@ public:
 		requestFull();
 		receiveFull(realtime);
 	}
-//	void updateTop10(bool realtime = false);
+/**
+ *
+ */
+	void updateTop10(bool realtime = false) {
+		requestTop10();
+		receiveTop10(realtime);
+	}
 /**
  *
  */
 	const v_type& getFullData() const { return full; }
+/** getData Method returns the most recent reading in either format. Cells that were not part of a TOP10 reply are zero.
+ *
+ */
+	const v_type& getData() const { return full; }
 
 /**
  *
@@ -85,6 +112,43 @@ public:
  *
  */
 	void receiveFull(bool realtime = false);
+/**
+ *
+ */
+	void requestTop10();
+/**
+ *
+ */
+	void receiveTop10(bool realtime = false);
+
+/** setMode Method chooses the format used by update(). Thresholds are in the same units as getData().
+ *
+ */
+	void setMode(enum TactMode newMode, double contactThreshold_ = 1.0, double releaseThreshold_ = 0.5);
+	enum TactMode getMode() const { return mode; }
+/** usingTop10 Method returns true if the next request() will ask for TOP10 data.
+ *
+ */
+	bool usingTop10() const;
+/** getNumReplyMessages Method returns the number of CAN frames the next request() will generate.
+ *
+ */
+	size_t getNumReplyMessages() const { return usingTop10() ? NUM_TOP10_MESSAGES : NUM_FULL_MESSAGES; }
+/**
+ *
+ */
+	void update(bool realtime = false) {
+		request();
+		receive(realtime);
+	}
+/**
+ *
+ */
+	void request();
+/**
+ *
+ */
+	void receive(bool realtime = false);
 
 /**
  *
@@ -97,29 +161,40 @@ public:
 		typedef v_type result_type;
 		static int parse(int id, int propId, result_type* result, const unsigned char* data, size_t len);
 	};
-	// TODO(dc): Implement Top10TactParser
-//	struct Top10TactParser {
-//		static int busId(int id, int propId) {
-//			return Puck::encodeBusId(id, PuckGroup::FGRP_TACT_TOP10);
-//		}
-//
-//		typedef int result_type;
-//		static int parse(int id, int propId, result_type* result, const unsigned char* data, size_t len) { return 0; }
-//	};
+/** Decodes a TOP10 reply: a 24-bit mask of the ten most-loaded cells followed by one 4-bit reading for each of them.
+ *
+ */
+	struct Top10TactParser {
+		static int busId(int id, int propId) {
+			return Puck::encodeBusId(id, PuckGroup::FGRP_TACT_TOP10);
+		}
+
+		typedef v_type result_type;
+		static int parse(int id, int propId, result_type* result, const unsigned char* data, size_t len);
+	};
 
 protected:
+	void setTactState(enum TactState newState);
+	void updateContactState();
+
 	const bus::CommunicationsBus* bus;
 	int id;
 	int propId;
 
 	enum TactState tact;
 	v_type full;
-//	int top10;
+
+	enum TactMode mode;
+	double contactThreshold, releaseThreshold;
+	bool inContact;
 
 
-	static const size_t NUM_FULL_MESSAGES = 5;
 	static const size_t NUM_SENSORS_PER_FULL_MESSAGE = 5;
 	static const double FULL_SCALE_FACTOR = 256.0;
+	static const size_t NUM_TOP10_VALUES = 10;
+	// TOP10 readings are the high nibble of the 12-bit FULL readings, so they
+	// are already in the same units as FULL readings divided by FULL_SCALE_FACTOR.
+	static const double TOP10_SCALE_FACTOR = 1.0;
 
 
 	friend class Hand;
@@ -51,6 +51,8 @@
 // sources
 #include <barrett/systems/constant.h>
 #include <barrett/systems/exposed_output.h>
+#include <barrett/systems/hand_sensor_scheduler.h>
+#include <barrett/systems/force_torque_sensor_source.h>
 
 #include <barrett/systems/ramp.h>
 
@@ -80,8 +82,14 @@
 #include <barrett/systems/pid_controller.h>
 #include <barrett/systems/first_order_filter.h>
 #include <barrett/systems/rate_limiter.h>
+#include <barrett/systems/settle_detector.h>
+#include <barrett/systems/state_snapshot.h>
+#include <barrett/systems/state_publisher.h>
+#include <barrett/systems/command_subscriber.h>
+#include <barrett/systems/network_link.h>
 
 #include <barrett/systems/callback.h>
+#include <barrett/systems/setpoint_table.h>
 
 #include <barrett/systems/array_splitter.h>
 #include <barrett/systems/array_editor.h>
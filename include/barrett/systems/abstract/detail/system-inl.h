@@ -79,6 +79,14 @@ void System::Input<T>::unsetExecutionManager()
 	}
 }
 
+template<typename T>
+void System::Input<T>::prefaultUpstream(update_token_type prefaultToken)
+{
+	if (isConnected()) {
+		output->parentSys->prefaultUpstream(prefaultToken);
+	}
+}
+
 
 template<typename T>
 System::Output<T>::~Output() {
@@ -138,6 +146,14 @@ void System::Output<T>::unsetExecutionManager()
 	}
 }
 
+template<typename T>
+void System::Output<T>::prefaultUpstream(update_token_type prefaultToken)
+{
+	if (value.delegate != NULL) {
+		value.delegate->parentOutput.parentSys->prefaultUpstream(prefaultToken);
+	}
+}
+
 template<typename T>
 void System::Output<T>::Value::delegateTo(Output<T>& delegateOutput)
 {
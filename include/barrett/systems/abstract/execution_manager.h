@@ -43,6 +43,7 @@
 
 #include <barrett/detail/ca_macro.h>
 #include <barrett/detail/libconfig_utils.h>
+#include <barrett/detail/allocation_tracker.h>
 #include <barrett/thread/abstract/mutex.h>
 #include <barrett/thread/null_mutex.h>
 
@@ -63,9 +64,11 @@ public:
 class ExecutionManager {
 public:
 	explicit ExecutionManager(double period_s = -1.0) :
-		mutex(new thread::NullMutex), period(period_s), ut(System::UT_NULL) {}
+		mutex(new thread::NullMutex), period(period_s), ut(System::UT_NULL),
+		allocationTracker(NULL) {}
 	explicit ExecutionManager(const libconfig::Setting& setting) :
-		mutex(new thread::NullMutex), period(), ut(System::UT_NULL)
+		mutex(new thread::NullMutex), period(), ut(System::UT_NULL),
+		allocationTracker(NULL)
 	{
 		period = barrett::detail::numericToDouble(setting["control_loop_period"]);
 	}
@@ -77,12 +80,22 @@ public:
 	thread::Mutex& getMutex() const { return *mutex; }
 	double getPeriod() const {  return period;  }
 
+	// Calls System::prefault() once on each managed System, including those
+	// that are only managed through the Systems that pull from them.
+	void prefault();
+
+	// Count heap allocations made during execution cycles. Pass NULL to stop.
+	// See detail::AllocationTracker.
+	void setAllocationTracker(barrett::detail::AllocationTracker* at);
+	barrett::detail::AllocationTracker* getAllocationTracker() const { return allocationTracker; }
+
 protected:
 	void runExecutionCycle();
 
 	thread::Mutex* mutex;
 	double period;
 	System::update_token_type ut;
+	barrett::detail::AllocationTracker* allocationTracker;
 
 private:
 	typedef boost::intrusive::list<System, boost::intrusive::member_hook<System, System::managed_hook_type, &System::managedHook> > managed_system_list_type;
@@ -69,7 +69,7 @@ public:
 
 
 	explicit System(const std::string& sysName = "System") :
-			name(sysName), em(NULL), emDirect(false), ut(UT_NULL) {}
+			name(sysName), em(NULL), emDirect(false), ut(UT_NULL), prefaultUt(UT_NULL) {}
 	virtual ~System() { mandatoryCleanUp(); }
 
 	void setName(const std::string& newName) { name = newName; }
@@ -93,6 +93,14 @@ protected:
 	// MyBaseClass::onExecutionManagerChanged() in the new version.
 	virtual void onExecutionManagerChanged() {}
 
+	// Called by ExecutionManager::prefault() (from the execution thread, before
+	// the first execution cycle) once on each System it manages, whether
+	// directly or because a managed System pulls from it. Systems are visited
+	// after the Systems they pull from. Redefine
+	// this to touch memory or bus buffers that operate() would otherwise
+	// allocate or fault in during the first cycle. Must not block for long.
+	virtual void prefault() {}
+
 	std::string name;
 	ExecutionManager* em;
 	bool emDirect;
@@ -116,6 +124,7 @@ public:
 	private:
 		virtual void pushExecutionManager() = 0;
 		virtual void unsetExecutionManager() = 0;
+		virtual void prefaultUpstream(update_token_type prefaultToken) = 0;
 
 		typedef boost::intrusive::list_member_hook<> child_hook_type;
 		child_hook_type childHook;
@@ -143,6 +152,7 @@ public:
 		virtual ExecutionManager* collectExecutionManager() const = 0;
 		virtual void pushExecutionManager() = 0;
 		virtual void unsetExecutionManager() = 0;
+		virtual void prefaultUpstream(update_token_type prefaultToken) = 0;
 
 		typedef boost::intrusive::list_member_hook<> child_hook_type;
 		child_hook_type childHook;
@@ -156,11 +166,13 @@ public:
 private:
 	static const update_token_type UT_NULL = 0;
 	update_token_type ut;
+	update_token_type prefaultUt;
 
 
 	void setExecutionManager(ExecutionManager* newEm);
 	void unsetDirectExecutionManager();
 	void unsetExecutionManager();
+	void prefaultUpstream(update_token_type prefaultToken);
 
 	typedef boost::intrusive::list_member_hook<> managed_hook_type;
 	managed_hook_type managedHook;
@@ -192,6 +204,7 @@ public:
 	virtual ~Input();
 
 	bool isConnected() const { return output != NULL; }
+	bool isConnectedTo(const Output<T>& o) const { return output == &o; }
 	virtual bool valueDefined() const {
 		assert(parentSys != NULL);
 		return parentSys->hasExecutionManager()  &&  isConnected()  &&  output->getValueObject()->updateData(parentSys->ut);
@@ -217,6 +230,7 @@ protected:
 private:
 	virtual void pushExecutionManager();
 	virtual void unsetExecutionManager();
+	virtual void prefaultUpstream(update_token_type prefaultToken);
 
 	typedef boost::intrusive::list_member_hook<> connected_hook_type;
 	connected_hook_type connectedHook;
@@ -289,6 +303,7 @@ private:
 	virtual ExecutionManager* collectExecutionManager() const;
 	virtual void pushExecutionManager();
 	virtual void unsetExecutionManager();
+	virtual void prefaultUpstream(update_token_type prefaultToken);
 
 
 	typename detail::IntrusiveDelegateFunctor<T>::hook_type delegateHook;
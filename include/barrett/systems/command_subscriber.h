@@ -0,0 +1,131 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * command_subscriber.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_COMMAND_SUBSCRIBER_H_
+#define BARRETT_SYSTEMS_COMMAND_SUBSCRIBER_H_
+
+
+#include <string>
+#include <stdexcept>
+
+#include <Eigen/Core>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/os.h>
+#include <barrett/math/traits.h>
+#include <barrett/thread/shared_memory.h>
+#include <barrett/systems/abstract/system.h>
+#include <barrett/systems/abstract/single_io.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Outputs commands written by another process to shared memory.
+ *
+ * The constructor creates a thread::SharedMemoryChannel<T> named shmName
+ * (failing if it already exists, unless replace is true); the destructor
+ * removes it. Another process
+ * opens the channel by name and writes commands to it at any rate. Each
+ * execution cycle, operate() outputs the most recent command. Checking for a
+ * command is a read from memory: it makes no system calls and never waits
+ * for the writer.
+ *
+ * Watchdog: if no new command arrives for timeout seconds (or before the
+ * first command), the output is undefined. Systems that depend on it stop
+ * operating, so a controller tracking the commands lets go rather than
+ * holding a stale setpoint when the other process stalls or exits.
+ */
+template<typename T, typename MathTraits = math::Traits<T> >
+class CommandSubscriber : public System, public SingleOutput<T> {
+public:
+	CommandSubscriber(const std::string& shmName, double timeout_, bool replace = false,
+			const std::string& sysName = "CommandSubscriber") :
+		System(sysName), SingleOutput<T>(this),
+		channel(shmName, true, replace), timeout(timeout_), lastSequence(0), lastUpdate(0.0), active(false),
+		sample(), data()
+	{
+		if (timeout <= 0.0) {
+			(logMessage("CommandSubscriber::%s(): timeout must be positive. Got %f.")
+					% __func__ % timeout).template raise<std::invalid_argument>();
+		}
+	}
+	virtual ~CommandSubscriber() { mandatoryCleanUp(); }
+
+	const std::string& getChannelName() const { return channel.getName(); }
+	double getTimeout() const { return timeout; }
+
+	/// False before the first command and while the watchdog has timed out
+	bool isActive() const { return active; }
+
+protected:
+	virtual void operate() {
+		double now = highResolutionSystemTime();
+
+		unsigned long seq = channel.getSequence();
+		if (seq != lastSequence  &&  channel.tryRead(&sample)) {
+			// If the read overlapped a write, try again next cycle.
+			lastSequence = seq;
+			lastUpdate = now;
+			data = sample.value;
+		}
+
+		// lastUpdate is local, so the two processes' clocks needn't agree.
+		active = lastSequence != 0  &&  now - lastUpdate <= timeout;
+		if (active) {
+			this->outputValue->setData(&data);
+		} else {
+			this->outputValue->setUndefined();
+		}
+	}
+
+	thread::SharedMemoryChannel<T> channel;
+	double timeout;
+
+	unsigned long lastSequence;
+	double lastUpdate;
+	volatile bool active;
+
+	typename thread::SharedMemoryChannel<T>::Sample sample;
+	T data;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(CommandSubscriber);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF(MathTraits::RequiresAlignment)
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_COMMAND_SUBSCRIBER_H_ */
@@ -34,6 +34,7 @@
 
 #include <libconfig.h++>
 
+#include <barrett/os.h>
 #include <barrett/products/puck.h>
 #include <barrett/products/low_level_wam.h>
 #include <barrett/products/safety_module.h>
@@ -67,20 +68,58 @@ void LowLevelWamWrapper<DOF>::Sink::operate()
 template<size_t DOF>
 void LowLevelWamWrapper<DOF>::Source::operate()
 {
+	// The SafetyModule's MODE is polled in the background so that it is
+	// fresh when the Pucks stop answering. The reply arrives on a later cycle.
+	static const double MODE_POLLING_PERIOD = 0.05;  // seconds
+	static const double MAX_MODE_AGE = 0.1;  // seconds
+
+	SafetyModule* sm = parent->llw.getSafetyModule();
 	try {
 		parent->llw.update();
 	} catch (const std::runtime_error& e) {
-		if (parent->llw.getSafetyModule() != NULL  &&  parent->llw.getSafetyModule()->getMode(true) == SafetyModule::ESTOP) {
-			throw ExecutionManagerException("systems::LowLevelWamWrapper::Source::operate(): E-stop! Cannot communicate with Pucks.");
-		} else {
-			throw;
+		if (sm != NULL) {
+			sm->pollMode(MODE_POLLING_PERIOD);
+
+			enum SafetyModule::SafetyMode mode;
+			if ( !sm->getObservedMode(&mode, MAX_MODE_AGE) ) {
+				// Don't block on the bus to find out. Go with the last mode
+				// observed, if any.
+				SafetyModule::Telemetry t = sm->getTelemetry();
+				if ( !t.modeValid ) {
+					logMessageRT("systems::LowLevelWamWrapper::Source::%s(): SafetyModule MODE has never been observed") % __func__;
+					throw;
+				}
+				logMessageRT("systems::LowLevelWamWrapper::Source::%s(): SafetyModule MODE is stale (%f s old). Assuming it is still %s.")
+						% __func__ % (highResolutionSystemTime() - t.modeTime) % SafetyModule::getSafetyModeStr(t.mode);
+				mode = t.mode;
+			}
+			if (mode == SafetyModule::ESTOP) {
+				throw ExecutionManagerException("systems::LowLevelWamWrapper::Source::operate(): E-stop! Cannot communicate with Pucks.");
+			}
 		}
+		throw;
+	}
+
+	if (sm != NULL) {
+		sm->pollMode(MODE_POLLING_PERIOD);
 	}
 
 	this->jpOutputValue->setData( &(parent->llw.getJointPositions()) );
 	this->jvOutputValue->setData( &(parent->llw.getJointVelocities()) );
 }
 
+template<size_t DOF>
+void LowLevelWamWrapper<DOF>::Source::prefault()
+{
+	// One read of the joint positions creates the bus's receive buffers for
+	// the position group. The Sink has no equivalent: any torque it sent
+	// would reach the motors. If the Pucks don't answer, leave it to the
+	// first execution cycle to report that.
+	try {
+		parent->llw.update();
+	} catch (const std::runtime_error&) {}
+}
+
 
 }
 }
@@ -0,0 +1,253 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * network_link-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <string>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include <barrett/os.h>
+
+// sendmmsg() first appeared in glibc 2.14.
+#if defined(__GLIBC__)  &&  (__GLIBC__ > 2  ||  (__GLIBC__ == 2  &&  __GLIBC_MINOR__ >= 14))
+#  define BARRETT_HAVE_SENDMMSG
+#endif
+
+
+namespace barrett {
+namespace systems {
+
+
+template<typename T, typename MathTraits>
+NetworkLink<T,MathTraits>::NetworkLink(const std::string& remoteHost, int localPort, int remotePort,
+		double playoutDelay, double maxExtrapolation, double timeout_,
+		double ioPeriod_, bool batchSends_, const std::string& sysName) :
+	SingleIO<T,T>(sysName), sock(-1), timeout(timeout_), ioPeriod(ioPeriod_), batchSends(batchSends_),
+	txQueue(), rxQueue(), stopRequested(false), ioThread(),
+	jb(playoutDelay, maxExtrapolation), txPacket(), rxPacket(), txSeq(0),
+	lastRemoteSendTime(0.0), lastRemoteReceiveTime(0.0), s(), data(),
+	linked(false), stats()
+{
+	if (timeout <= 0.0) {
+		(logMessage("NetworkLink::%s(): timeout must be positive. Got %f.")
+				% __func__ % timeout).template raise<std::invalid_argument>();
+	}
+	if (ioPeriod <= 0.0) {
+		(logMessage("NetworkLink::%s(): ioPeriod must be positive. Got %f.")
+				% __func__ % ioPeriod).template raise<std::invalid_argument>();
+	}
+
+	struct sockaddr_in remoteAddr;
+	std::memset(&remoteAddr, 0, sizeof(remoteAddr));
+	remoteAddr.sin_family = AF_INET;
+	remoteAddr.sin_port = htons(remotePort);
+	if (inet_pton(AF_INET, remoteHost.c_str(), &remoteAddr.sin_addr) != 1) {
+		(logMessage("NetworkLink::%s(): Bad IPv4 address: \"%s\".")
+				% __func__ % remoteHost).template raise<std::invalid_argument>();
+	}
+
+	struct sockaddr_in localAddr;
+	std::memset(&localAddr, 0, sizeof(localAddr));
+	localAddr.sin_family = AF_INET;
+	localAddr.sin_port = htons(localPort);
+	localAddr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+	const char* failedCall = NULL;
+	sock = socket(AF_INET, SOCK_DGRAM, 0);
+	if (sock == -1) {
+		failedCall = "socket";
+	} else if (fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK) == -1) {
+		failedCall = "fcntl";
+	} else if (bind(sock, (struct sockaddr*) &localAddr, sizeof(localAddr)) == -1) {
+		failedCall = "bind";
+	} else if (connect(sock, (struct sockaddr*) &remoteAddr, sizeof(remoteAddr)) == -1) {
+		// Only accept packets from remoteHost:remotePort, and send there by default.
+		failedCall = "connect";
+	}
+	if (failedCall != NULL) {
+		int err = errno;
+		if (sock != -1) {
+			close(sock);
+		}
+		(logMessage("NetworkLink::%s(): %s() failed for port %d: (%d) %s")
+				% __func__ % failedCall % localPort % err % strerror(err)).template raise<std::runtime_error>();
+	}
+
+	// start I/O thread
+	boost::thread tmpThread(boost::bind(&NetworkLink<T,MathTraits>::ioThreadEntryPoint, this));
+	ioThread.swap(tmpThread);
+}
+
+template<typename T, typename MathTraits>
+NetworkLink<T,MathTraits>::~NetworkLink()
+{
+	this->mandatoryCleanUp();
+
+	stopRequested = true;
+	ioThread.join();
+	close(sock);
+}
+
+template<typename T, typename MathTraits>
+void NetworkLink<T,MathTraits>::operate()
+{
+	double now = highResolutionSystemTime();
+
+	while (rxQueue.pop(&rxPacket)) {
+		const Packet& p = rxPacket.packet;
+		++s.packetsReceived;
+
+		// After a timeout, accept whatever the other end sends next (even if
+		// it restarted and its sequence numbers went back).
+		if (jb.size() != 0  &&  rxPacket.receiveTime - jb.getLastReceiveTime() > timeout) {
+			jb.restart();
+		}
+
+		if (jb.add(p.seq, p.sendTime, rxPacket.receiveTime, p.value)) {
+			lastRemoteSendTime = p.sendTime;
+			lastRemoteReceiveTime = rxPacket.receiveTime;
+		}
+
+		// p.echoTime is one of our time stamps, so the round-trip time doesn't
+		// depend on the other end's clock.
+		if (p.echoDelay >= 0.0) {
+			double rtt = rxPacket.receiveTime - p.echoTime - p.echoDelay;
+			if (s.roundTripTime == 0.0) {
+				s.roundTripTime = rtt;
+			} else {
+				s.roundTripTime += RTT_GAIN * (rtt - s.roundTripTime);
+			}
+		}
+	}
+
+	txPacket.seq = txSeq++;
+	txPacket.sendTime = now;
+	if (jb.size() != 0) {
+		txPacket.echoTime = lastRemoteSendTime;
+		txPacket.echoDelay = now - lastRemoteReceiveTime;
+	} else {
+		txPacket.echoTime = 0.0;
+		txPacket.echoDelay = -1.0;
+	}
+	txPacket.value = this->input.getValue();
+	if (txQueue.push(txPacket)) {
+		++s.packetsSent;
+	} else {
+		++s.packetsDropped;
+	}
+
+	linked = jb.size() != 0  &&  now - jb.getLastReceiveTime() <= timeout  &&  jb.eval(now, &data);
+	if (linked) {
+		this->outputValue->setData(&data);
+	} else {
+		this->outputValue->setUndefined();
+	}
+
+	s.packetsLost = jb.getNumLost();
+	s.packetsLate = jb.getNumLate();
+	s.jitter = jb.getJitter();
+	stats.write(s);
+}
+
+template<typename T, typename MathTraits>
+void NetworkLink<T,MathTraits>::ioThreadEntryPoint()
+{
+	Packet batch[MAX_BATCH];
+	ReceivedPacket rp;
+
+	struct pollfd pfd;
+	pfd.fd = sock;
+	pfd.events = POLLIN;
+
+	struct timespec period;
+	period.tv_sec = (time_t) ioPeriod;
+	period.tv_nsec = (long) ((ioPeriod - period.tv_sec) * 1e9);
+
+	while ( !stopRequested ) {
+		size_t n = 0;
+		while (n < MAX_BATCH  &&  txQueue.pop(&batch[n])) {
+			++n;
+		}
+		if (n != 0) {
+			sendPackets(batch, n);
+		}
+
+		// Drain the socket. Runts and errors (such as ECONNREFUSED while the
+		// other end isn't running yet) are ignored.
+		ssize_t len;
+		while ((len = recv(sock, &rp.packet, sizeof(rp.packet), 0)) != -1  ||  errno == ECONNREFUSED) {
+			if (len == (ssize_t) sizeof(rp.packet)) {
+				rp.receiveTime = highResolutionSystemTime();
+				rxQueue.push(rp);  // If the execution thread falls behind, drop the packet.
+			}
+		}
+
+		// Wait for a packet to arrive or for the next chance to send.
+		ppoll(&pfd, 1, &period, NULL);
+	}
+}
+
+template<typename T, typename MathTraits>
+void NetworkLink<T,MathTraits>::sendPackets(Packet* packets, size_t n)
+{
+#ifdef BARRETT_HAVE_SENDMMSG
+	if (batchSends  &&  n > 1) {
+		struct iovec iovs[MAX_BATCH];
+		struct mmsghdr msgs[MAX_BATCH];
+		std::memset(msgs, 0, sizeof(msgs));
+		for (size_t i = 0; i < n; ++i) {
+			iovs[i].iov_base = &packets[i];
+			iovs[i].iov_len = sizeof(Packet);
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+		sendmmsg(sock, msgs, n, 0);
+		return;
+	}
+#endif
+
+	for (size_t i = 0; i < n; ++i) {
+		::send(sock, &packets[i], sizeof(Packet), 0);
+	}
+}
+
+
+}
+}
@@ -0,0 +1,129 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+
+
+/*
+ * setpoint_table-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include <barrett/os.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+namespace detail {
+// Maps time directly to the spline's parameter
+struct IdentityProfile {
+	double eval(double t) const { return t; }
+};
+}
+
+
+template<typename T>
+template<typename SplineType>
+SetpointTable<T>::SetpointTable(const SplineType& spline, double period_, size_t numThreads,
+		const std::string& sysName) :
+	SingleIO<double, T>(sysName), table(), t_0(spline.initialS()), period(period_), rate(0.0)
+{
+	render(spline, detail::IdentityProfile(), spline.finalS(), numThreads);
+}
+
+template<typename T>
+template<typename SplineType, typename ProfileType>
+SetpointTable<T>::SetpointTable(const SplineType& spline, const ProfileType& profile, double period_,
+		size_t numThreads, const std::string& sysName) :
+	SingleIO<double, T>(sysName), table(), t_0(0.0), period(period_), rate(0.0)
+{
+	render(spline, profile, profile.finalT(), numThreads);
+}
+
+template<typename T>
+template<typename SplineType, typename ProfileType>
+void SetpointTable<T>::render(const SplineType& spline, const ProfileType& profile, double t_f,
+		size_t numThreads)
+{
+	if (period <= 0.0  ||  numThreads == 0) {
+		(logMessage("SetpointTable::%s(): period and numThreads must be positive. Got %g and %d.")
+				% __func__ % period % numThreads).template raise<std::invalid_argument>();
+	}
+	rate = 1.0 / period;
+
+	// One tick at t_0, and enough ticks to reach t_f
+	size_t n = 1 + static_cast<size_t>(std::ceil(std::max(0.0, (t_f - t_0) * rate - 1e-9)));
+	table.resize(n);
+
+	numThreads = std::min(numThreads, n);
+	if (numThreads == 1) {
+		renderChunk(&spline, &profile, 0, n);
+	} else {
+		boost::thread_group threads;
+		for (size_t i = 0; i < numThreads; ++i) {
+			threads.create_thread(boost::bind(
+					&SetpointTable<T>::template renderChunk<SplineType, ProfileType>,
+					this, &spline, &profile, (n * i) / numThreads, (n * (i + 1)) / numThreads));
+		}
+		threads.join_all();
+	}
+}
+
+template<typename T>
+template<typename SplineType, typename ProfileType>
+void SetpointTable<T>::renderChunk(const SplineType* spline, const ProfileType* profile,
+		size_t begin, size_t end)
+{
+	std::vector<double> s(end - begin);
+	for (size_t i = begin; i < end; ++i) {
+		s[i - begin] = profile->eval(t_0 + i * period);
+	}
+	spline->eval(s.begin(), s.end(), table.begin() + begin);
+}
+
+template<typename T>
+void SetpointTable<T>::operate()
+{
+	double t = this->input.getValue();
+
+	size_t i = 0;
+	if (t > t_0) {
+		double x = (t - t_0) * rate + 0.5;
+		i = (x < table.size() - 1) ? static_cast<size_t>(x) : table.size() - 1;
+	}
+	this->outputValue->setData(&table[i]);
+}
+
+
+}
+}
@@ -0,0 +1,144 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+
+
+
+/*
+ * settle_detector-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+
+#include <barrett/os.h>
+#include <barrett/math/utils.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+template<typename T, typename MathTraits>
+SettleDetector<T,MathTraits>::SettleDetector(size_t windowSize, const T& meanThreshold_,
+		const T& deviationThreshold, const std::string& sysName) :
+	SingleIO<T, bool>(sysName),
+	meanThreshold(meanThreshold_), squaredDeviationThreshold(MT::mult(deviationThreshold, deviationThreshold)),
+	window(windowSize), newest(0), count(0), sum(), sumOfSquares(), mean(), variance(),
+	settled(false), resetRequested(false), data(false)
+{
+	if (windowSize < 2) {
+		(logMessage("SettleDetector::%s(): windowSize must be at least 2. Got %d.")
+				% __func__ % windowSize).template raise<std::invalid_argument>();
+	}
+	if ( !(meanThreshold == math::abs(meanThreshold))  ||  !(deviationThreshold == math::abs(deviationThreshold)) ) {
+		(logMessage("SettleDetector::%s(): Thresholds must be non-negative.")
+				% __func__).template raise<std::invalid_argument>();
+	}
+
+	sum = MT::zero();
+	sumOfSquares = MT::zero();
+}
+
+template<typename T, typename MathTraits>
+bool SettleDetector<T,MathTraits>::waitUntilSettled(double timeout)
+{
+	// Clear settled before requesting the reset so a stale result from the
+	// previous window can't be mistaken for a new one.
+	settled = false;
+	resetRequested = true;
+
+	double start = highResolutionSystemTime();
+	while (resetRequested  ||  !settled) {
+		if ( !this->hasExecutionManager() ) {
+			return false;
+		}
+		if (timeout > 0.0  &&  highResolutionSystemTime() - start > timeout) {
+			return false;
+		}
+		btsleep(this->getExecutionManager()->getPeriod());
+	}
+	return true;
+}
+
+template<typename T, typename MathTraits>
+void SettleDetector<T,MathTraits>::operate()
+{
+	if (resetRequested) {
+		count = 0;
+		sum = MT::zero();
+		sumOfSquares = MT::zero();
+		settled = false;
+		resetRequested = false;
+	}
+
+	const T& x = this->input.getValue();
+	newest = (newest + 1) % window.size();
+	if (count == window.size()) {
+		sum -= window[newest];
+		sumOfSquares -= MT::mult(window[newest], window[newest]);
+	} else {
+		++count;
+	}
+	window[newest] = x;
+	sum += x;
+	sumOfSquares += MT::mult(x, x);
+
+	if (count == window.size()) {
+		// Keep round-off from accumulating in the running sums.
+		if (newest == window.size() - 1) {
+			recomputeSums();
+		}
+
+		mean = MT::div(sum, (double) count);
+		variance = MT::sub(MT::div(sumOfSquares, (double) count), MT::mult(mean, mean));
+
+		bool s = true;
+		if ( !(meanThreshold == MT::zero()) ) {
+			s = s  &&  math::max(math::abs(mean), meanThreshold) == meanThreshold;
+		}
+		if ( !(squaredDeviationThreshold == MT::zero()) ) {
+			s = s  &&  math::max(variance, squaredDeviationThreshold) == squaredDeviationThreshold;
+		}
+		settled = s;
+	}
+
+	data = settled;
+	this->outputValue->setData(&data);
+}
+
+template<typename T, typename MathTraits>
+void SettleDetector<T,MathTraits>::recomputeSums()
+{
+	sum = MT::zero();
+	sumOfSquares = MT::zero();
+	for (size_t i = 0; i < window.size(); ++i) {
+		sum += window[i];
+		sumOfSquares += MT::mult(window[i], window[i]);
+	}
+}
+
+
+}
+}
@@ -0,0 +1,521 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+
+/*
+ * trajectory_executor-inl.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+
+#define EIGEN_USE_NEW_STDVECTOR
+#include <Eigen/StdVector>
+
+#include <barrett/os.h>
+#include <barrett/systems/abstract/execution_manager.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+template<typename T> const size_t TrajectoryExecutor<T>::NUM_SLOTS;
+template<typename T> const size_t TrajectoryExecutor<T>::NO_SLOT;
+
+template<typename T>
+TrajectoryExecutor<T>::TrajectoryExecutor(const std::string& sysName) :
+	System(sysName), SingleOutput<T>(this),
+	T_s(0.0), jerkLimit(0.0), commandQueue(), retiredQueue(),
+	enqueuedId(0), completedId(0), lastDestination(),
+	lastPrimary(NO_SLOT), lastAlternate(NO_SLOT),
+	resolvedId(0), resolvedBlend(false), numCycles(0),
+	dropAppended(false), pendingHead(0), numPending(0), active(NULL), activeSlot(0),
+	t(0.0), value(), valueDefined(false)
+{
+	for (size_t i = 0; i < NUM_SLOTS; ++i) {
+		slotFree[i] = true;
+	}
+	getSamplePeriodFromEM();
+}
+
+template<typename T>
+TrajectoryExecutor<T>::~TrajectoryExecutor()
+{
+	mandatoryCleanUp();
+
+	// The execution thread is no longer using any of the slots.
+	for (size_t i = 0; i < NUM_SLOTS; ++i) {
+		if ( !slotFree[i] ) {
+			freeSlot(slots[i]);
+		}
+	}
+}
+
+template<typename T>
+typename TrajectoryExecutor<T>::move_id_type TrajectoryExecutor<T>::enqueue(
+		const T& start, const T& destination,
+		double velocity, double acceleration, bool preempt)
+{
+	waitForFreeSlots(1);
+	size_t i = allocateSlot();
+
+	// Plan the move here, outside of the control loop.
+	Slot& s = slots[i];
+	planFromRest(start, destination, velocity, acceleration, &s);
+	s.preempt = preempt;
+	s.appended = false;
+	s.id = ++enqueuedId;
+	lastDestination = destination;
+
+	push(i);
+	return s.id;
+}
+
+template<typename T>
+typename TrajectoryExecutor<T>::move_id_type TrajectoryExecutor<T>::append(
+		const T& destination, double velocity, double acceleration, double blendRadius)
+{
+	if (enqueuedId == 0) {
+		(logMessage("TrajectoryExecutor::%s(): There is no previous move to append to.")
+				% __func__).template raise<std::logic_error>();
+	}
+
+	// Each call may need two slots.
+	waitForFreeSlots(2);
+	size_t fallback = allocateSlot();
+
+	// The version that starts from rest
+	Slot& f = slots[fallback];
+	planFromRest(lastDestination, destination, velocity, acceleration, &f);
+	f.preempt = false;
+	f.appended = true;
+	f.id = enqueuedId + 1;
+
+	// The version that blends, if the previous move might still be under way
+	size_t blend = NO_SLOT;
+	const Slot* prev = resolveTail();
+	if (prev != NULL  &&  blendRadius > 0.0) {
+		try {
+			blend = allocateSlot();
+		} catch (...) {
+			freeSlot(f);
+			slotFree[fallback] = true;
+			throw;
+		}
+
+		Slot& b = slots[blend];
+		if (planBlend(*prev, destination, velocity, acceleration, blendRadius, &b)) {
+			b.preempt = false;
+			b.appended = true;
+			b.id = f.id;
+		} else {
+			slotFree[blend] = true;
+			blend = NO_SLOT;
+		}
+	}
+
+	++enqueuedId;
+	lastDestination = destination;
+
+	if (blend == NO_SLOT) {
+		push(fallback);
+	} else {
+		push(blend, fallback);
+	}
+	return f.id;
+}
+
+template<typename T>
+void TrajectoryExecutor<T>::setJerkLimit(double jerk)
+{
+	if (jerk < 0.0) {
+		(logMessage("TrajectoryExecutor::%s(): jerk must not be negative. Got %g.")
+				% __func__ % jerk).template raise<std::invalid_argument>();
+	}
+	jerkLimit = jerk;
+}
+
+template<typename T>
+bool TrajectoryExecutor<T>::waitUntilDone(move_id_type id) const
+{
+	while ( !isDone(id) ) {
+		if ( !waitForCycle() ) {
+			return isDone(id);
+		}
+	}
+	return true;
+}
+
+template<typename T>
+void TrajectoryExecutor<T>::operate()
+{
+	++numCycles;
+
+	Command cmd;
+	while (commandQueue.pop(&cmd)) {
+		accept(cmd);
+	}
+
+	if (active == NULL  &&  numPending != 0) {
+		start(pending[pendingHead], 0.0);
+	}
+
+	// Hand off to a move that branches off of this one
+	while (active != NULL  &&  active->endT < active->finalT()  &&  t >= active->endT) {
+		double carry = t - active->endT;
+		retire(activeSlot);
+		active = NULL;
+
+		assert(numPending != 0);
+		start(pending[pendingHead], carry);
+	}
+
+	if (active != NULL) {
+		value = active->spline->eval(active->eval(t));
+		valueDefined = true;
+
+		if (t >= active->finalT()) {
+			retire(activeSlot);
+			active = NULL;
+		} else {
+			t += T_s;
+		}
+	}
+
+	if (valueDefined) {
+		this->outputValue->setData(&value);
+	}
+}
+
+template<typename T>
+void TrajectoryExecutor<T>::onExecutionManagerChanged()
+{
+	System::onExecutionManagerChanged();  // First, call super
+	getSamplePeriodFromEM();
+
+	// If nothing is using the output anymore, the moves have been interrupted.
+	// operate() can't be running, so it's safe to touch its state.
+	if ( !hasExecutionManager() ) {
+		Command cmd;
+		while (commandQueue.pop(&cmd)) {
+			accept(cmd);
+		}
+		cancelAll();
+	}
+}
+
+template<typename T>
+void TrajectoryExecutor<T>::getSamplePeriodFromEM()
+{
+	if (this->hasExecutionManager()) {
+		assert(this->getExecutionManager()->getPeriod() > 0.0);
+		T_s = this->getExecutionManager()->getPeriod();
+	} else {
+		T_s = 0.0;
+	}
+}
+
+template<typename T>
+void TrajectoryExecutor<T>::accept(const Command& cmd)
+{
+	Slot& p = slots[cmd.primary];
+	bool blended = false;
+	size_t chosen = cmd.primary;
+
+	if (p.preempt) {
+		cancelAll();
+		dropAppended = false;
+	}
+
+	if (p.appended  &&  dropAppended) {
+		// The move this one was supposed to follow was cancelled, so its start
+		// point may never be reached.
+		retire(cmd.primary);
+		if (cmd.alternate != NO_SLOT) {
+			retire(cmd.alternate);
+		}
+		chosen = NO_SLOT;
+	} else if (cmd.alternate != NO_SLOT) {
+		// Blend only if the previous move hasn't passed the branch point yet.
+		Slot* prev = tail();
+		if (prev != NULL  &&  (prev != active  ||  t <= p.branchT)) {
+			prev->endT = p.branchT;
+			retire(cmd.alternate, false);
+			blended = true;
+		} else {
+			retire(cmd.primary, false);
+			chosen = cmd.alternate;
+		}
+	}
+
+	resolvedBlend = blended;
+	__sync_synchronize();
+	resolvedId = p.id;
+
+	if (chosen != NO_SLOT) {
+		pending[(pendingHead + numPending) % NUM_SLOTS] = chosen;
+		++numPending;
+	}
+}
+
+template<typename T>
+typename TrajectoryExecutor<T>::Slot* TrajectoryExecutor<T>::tail()
+{
+	if (numPending != 0) {
+		return &slots[pending[(pendingHead + numPending - 1) % NUM_SLOTS]];
+	}
+	return active;
+}
+
+template<typename T>
+void TrajectoryExecutor<T>::start(size_t slot, double t_0)
+{
+	assert(numPending != 0  &&  pending[pendingHead] == slot);
+	pendingHead = (pendingHead + 1) % NUM_SLOTS;
+	--numPending;
+
+	activeSlot = slot;
+	active = &slots[slot];
+	t = t_0;
+}
+
+template<typename T>
+void TrajectoryExecutor<T>::cancelAll()
+{
+	if (active != NULL) {
+		retire(activeSlot);
+		active = NULL;
+		dropAppended = true;
+	}
+	while (numPending != 0) {
+		retire(pending[pendingHead]);
+		pendingHead = (pendingHead + 1) % NUM_SLOTS;
+		--numPending;
+		dropAppended = true;
+	}
+}
+
+template<typename T>
+void TrajectoryExecutor<T>::retire(size_t slot, bool done)
+{
+	if (done) {
+		completedId = slots[slot].id;
+	}
+
+	bool pushed = retiredQueue.push(slot);
+	assert(pushed);
+	(void) pushed;
+}
+
+template<typename T>
+size_t TrajectoryExecutor<T>::allocateSlot()
+{
+	for (size_t i = 0; i < NUM_SLOTS; ++i) {
+		if (slotFree[i]) {
+			slotFree[i] = false;
+			return i;
+		}
+	}
+
+	(logMessage("TrajectoryExecutor::%s(): All %d slots are in use, and the "
+			"TrajectoryExecutor isn't running to free them.")
+			% __func__ % NUM_SLOTS).template raise<std::runtime_error>();
+	return NO_SLOT;
+}
+
+template<typename T>
+void TrajectoryExecutor<T>::waitForFreeSlots(size_t n)
+{
+	// Let earlier moves make room. A preempting move frees the slots of the
+	// moves it cancels within a cycle of being queued.
+	reclaimSlots();
+	while (numFreeSlots() < n  &&  waitForCycle()) {
+		reclaimSlots();
+	}
+}
+
+template<typename T>
+bool TrajectoryExecutor<T>::waitForCycle() const
+{
+	// Allow for a late cycle, but not for an ExecutionManager that has been
+	// stopped or no longer pulls from this System.
+	const double timeout = std::max(0.5, 50.0 * T_s);
+	const double start = highResolutionSystemTime();
+
+	unsigned long cycle = numCycles;
+	while (numCycles == cycle) {
+		if ( !hasExecutionManager()  ||  highResolutionSystemTime() - start > timeout) {
+			return false;
+		}
+		btsleep(T_s > 0.0 ? T_s : 0.001);
+	}
+	return true;
+}
+
+template<typename T>
+size_t TrajectoryExecutor<T>::numFreeSlots() const
+{
+	size_t n = 0;
+	for (size_t i = 0; i < NUM_SLOTS; ++i) {
+		if (slotFree[i]) {
+			++n;
+		}
+	}
+	return n;
+}
+
+template<typename T>
+void TrajectoryExecutor<T>::push(size_t primary, size_t alternate)
+{
+	lastPrimary = primary;
+	lastAlternate = alternate;
+
+	Command cmd;
+	cmd.primary = primary;
+	cmd.alternate = alternate;
+	bool pushed = commandQueue.push(cmd);
+	assert(pushed);  // There are only NUM_SLOTS slots
+	(void) pushed;
+}
+
+template<typename T>
+const typename TrajectoryExecutor<T>::Slot* TrajectoryExecutor<T>::resolveTail() const
+{
+	move_id_type id = enqueuedId;
+
+	// Wait (at most a cycle or two) for the execution thread to pick a version
+	// of the previous move.
+	while (resolvedId < id) {
+		if ( !waitForCycle() ) {
+			return NULL;
+		}
+	}
+	__sync_synchronize();
+
+	if (isDone(id)) {
+		return NULL;
+	} else if (lastAlternate == NO_SLOT  ||  resolvedBlend) {
+		return &slots[lastPrimary];
+	} else {
+		return &slots[lastAlternate];
+	}
+}
+
+template<typename T>
+void TrajectoryExecutor<T>::planFromRest(const T& start, const T& destination,
+		double velocity, double acceleration, Slot* s)
+{
+	std::vector<T, Eigen::aligned_allocator<T> > vec;
+	vec.push_back(start);
+	vec.push_back(destination);
+
+	s->spline = new math::Spline<T>(vec);
+	if (jerkLimit > 0.0) {
+		s->sCurve = new math::SCurveProfile(velocity, acceleration, jerkLimit, s->spline->changeInS());
+	} else {
+		s->profile = new math::TrapezoidalVelocityProfile(velocity, acceleration, 0.0, s->spline->changeInS());
+	}
+	s->endT = s->finalT();
+}
+
+template<typename T>
+bool TrajectoryExecutor<T>::planBlend(const Slot& prev, const T& destination,
+		double velocity, double acceleration, double blendRadius, Slot* s)
+{
+	const math::Spline<T>& prevSpline = *prev.spline;
+
+	T corner = lastDestination;
+	T out = destination - corner;
+	double length = out.norm();
+	double r = std::min(blendRadius, std::min(prevSpline.changeInS(), length) / 2.0);
+	if (r <= 0.0) {
+		return false;
+	}
+
+	// Find when the previous move reaches the branch point.
+	double s_b = prevSpline.changeInS() - r;
+	double lo = 0.0, hi = prev.finalT();
+	for (int i = 0; i < 60; ++i) {
+		double mid = (lo + hi) / 2.0;
+		if (prev.eval(mid) < s_b) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+	double t_b = hi;
+
+	T direction = prevSpline.evalDerivative(s_b);
+	double v_0 = prev.evalDerivative(t_b) * direction.norm();
+	if (v_0 <= 0.0) {
+		return false;
+	}
+
+	// If the path doubles back, a velocity-continuous blend would have to swing
+	// wide of the corner. Stop there instead.
+	if (direction.dot(out) < 0.0) {
+		return false;
+	}
+
+	// Pass through a point r past the corner so the path stays near the corner.
+	std::vector<T, Eigen::aligned_allocator<T> > vec;
+	vec.push_back(prevSpline.eval(s_b));
+	vec.push_back(corner + out * (r / length));
+	vec.push_back(destination);
+
+	s->spline = new math::Spline<T>(vec, typename T::unitless_type(direction));
+	s->profile = new math::TrapezoidalVelocityProfile(velocity, acceleration, v_0, s->spline->changeInS());
+	s->branchT = t_b;
+	s->endT = s->finalT();
+	return true;
+}
+
+template<typename T>
+void TrajectoryExecutor<T>::reclaimSlots()
+{
+	size_t i;
+	while (retiredQueue.pop(&i)) {
+		freeSlot(slots[i]);
+		slotFree[i] = true;
+	}
+}
+
+template<typename T>
+void TrajectoryExecutor<T>::freeSlot(Slot& s)
+{
+	delete s.spline;
+	s.spline = NULL;
+	delete s.profile;
+	s.profile = NULL;
+	delete s.sCurve;
+	s.sCurve = NULL;
+}
+
+
+}
+}
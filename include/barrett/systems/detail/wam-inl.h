@@ -29,14 +29,9 @@
  */
 
 
-#include <unistd.h>  // usleep
+#include <algorithm>
+#include <cmath>
 
-#include <boost/ref.hpp>
-#include <boost/bind.hpp>
-#include <boost/thread.hpp>
-
-#define EIGEN_USE_NEW_STDVECTOR
-#include <Eigen/StdVector>
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
@@ -47,12 +42,8 @@
 #include <barrett/products/puck.h>
 #include <barrett/products/safety_module.h>
 #include <barrett/thread/abstract/mutex.h>
-#include <barrett/math/spline.h>
-#include <barrett/math/trapezoidal_velocity_profile.h>
 #include <barrett/systems/abstract/system.h>
 #include <barrett/systems/io_conversion.h>
-#include <barrett/systems/ramp.h>
-#include <barrett/systems/callback.h>
 
 
 namespace barrett {
@@ -73,6 +64,7 @@ Wam<DOF>::Wam(ExecutionManager* em, const std::vector<Puck*>& genericPucks,
 	toolVelocity(),
 	toolOrientation(),
 	toolPose(),
+	stateSnapshot(sysName + "::stateSnapshot"),
 
 	supervisoryController(),
 	jtPassthrough(1.0),
@@ -91,11 +83,15 @@ Wam<DOF>::Wam(ExecutionManager* em, const std::vector<Puck*>& genericPucks,
 	tpoTt2jt(),
 	tpoSum(),
 
+	jpTrajectory(sysName + "::jpTrajectory"),
+	tpTrajectory(sysName + "::tpTrajectory"),
+	toTrajectory(sysName + "::toTrajectory"),
+	poseTrajectory(sysName + "::poseTrajectory"),
+
 	jtSum(true),
 
 	input(jtSum.getInput(JT_INPUT)), jpOutput(llww.jpOutput), jvOutput(jvFilter.output),
 
-	doneMoving(true),
 	kin(setting["kinematics"])
 {
 	connect(llww.jpOutput, kinematicsBase.jpInput);
@@ -117,6 +113,12 @@ Wam<DOF>::Wam(ExecutionManager* em, const std::vector<Puck*>& genericPucks,
 	connect(toolPosition.output, toolPose.getInput<0>());
 	connect(toolOrientation.output, toolPose.getInput<1>());
 
+	// stateSnapshot only runs once publishState() is called.
+	connect(llww.jpOutput, stateSnapshot.jpInput);
+	connect(jvOutput, stateSnapshot.jvInput);
+	connect(jtSum.output, stateSnapshot.jtInput);
+	connect(toolPose.output, stateSnapshot.poseInput);
+
 	connect(llww.jvOutput, jvFilter.input);
 	if (em != NULL) {
 		// Keep the jvFilter updated so it will provide accurate values for
@@ -166,9 +168,6 @@ Wam<DOF>::Wam(ExecutionManager* em, const std::vector<Puck*>& genericPucks,
 template<size_t DOF>
 Wam<DOF>::~Wam()
 {
-	// Make sure any outstanding moveTo() threads are cleaned up
-	mtThreadGroup.interrupt_all();
-	mtThreadGroup.join_all();
 }
 
 template<size_t DOF>
@@ -278,6 +277,19 @@ void Wam<DOF>::gravityCompensate(bool compensate)
 	}
 }
 
+template<size_t DOF>
+void Wam<DOF>::publishState(bool publish)
+{
+	if (publish) {
+		ExecutionManager* em = jvFilter.getExecutionManager();
+		if (em != NULL  &&  !isPublishingState()) {
+			em->startManaging(stateSnapshot);
+		}
+	} else if (isPublishingState()) {
+		stateSnapshot.getExecutionManager()->stopManaging(stateSnapshot);
+	}
+}
+
 template<size_t DOF>
 bool Wam<DOF>::updateGravity(double val)
 {
@@ -335,30 +347,103 @@ template<size_t DOF>
 template<typename T>
 void Wam<DOF>::moveTo(const T& currentPos, /*const typename T::unitless_type& currentVel,*/ const T& destination, bool blocking, double velocity, double acceleration)
 {
-	bool started = false;
-	boost::promise<boost::thread*> threadPtrPromise;
-	boost::shared_future<boost::thread*> threadPtrFuture(threadPtrPromise.get_future());
-	boost::thread* threadPtr = new boost::thread(&Wam<DOF>::moveToThread<T>, this, boost::ref(currentPos), /*currentVel,*/ boost::ref(destination), velocity, acceleration, &started, threadPtrFuture);
-	mtThreadGroup.add_thread(threadPtr);
-	threadPtrPromise.set_value(threadPtr);
-	
-
-	// wait until move starts
-	while ( !started ) {
-		btsleep(0.001);
+	TrajectoryExecutor<T>& te = trajectoryExecutorFor(destination);
+
+	// TODO(dc): Use currentVel. Requires changes to math::spline<Eigen::Quaternion<T> > specialization.
+	// The move is planned here and replaces any move that is in progress. It
+	// starts in the next execution cycle.
+	typename TrajectoryExecutor<T>::move_id_type id =
+			te.enqueue(currentPos, destination, velocity, acceleration, true);
+
+	// te cancels its moves if it loses its ExecutionManager, so leave the
+	// connection alone if te is already being tracked. Only the
+	// supervisoryController uses te's output.
+	if ( !te.hasExecutionManager() ) {
+		trackReferenceSignal(te.output);
 	}
 
 	if (blocking) {
-		while (!moveIsDone()) {
-			btsleep(0.01);
-		}
+		te.waitUntilDone(id);
+	}
+}
+
+template<size_t DOF>
+inline void Wam<DOF>::appendMove(const jp_type& destination, double velocity, double acceleration, double blendRadius)
+{
+	appendMove(currentPosHelper(getJointPositions()), destination, velocity, acceleration, blendRadius);
+}
+
+template<size_t DOF>
+inline void Wam<DOF>::appendMove(const cp_type& destination, double velocity, double acceleration, double blendRadius)
+{
+	appendMove(currentPosHelper(getToolPosition()), destination, velocity, acceleration, blendRadius);
+}
+
+template<size_t DOF>
+template<typename T>
+void Wam<DOF>::appendMove(const T& currentPos, const T& destination, double velocity, double acceleration, double blendRadius)
+{
+	TrajectoryExecutor<T>& te = trajectoryExecutorFor(destination);
+
+	if (te.isIdle()  ||  !te.hasExecutionManager()) {
+		moveTo(currentPos, destination, false, velocity, acceleration);
+	} else {
+		te.append(destination, velocity, acceleration, blendRadius);
+	}
+}
+
+template<size_t DOF>
+void Wam<DOF>::moveThrough(const std::vector<jp_type>& waypoints, bool blocking, double velocity, double acceleration, double blendRadius)
+{
+	for (size_t i = 0; i < waypoints.size(); ++i) {
+		appendMove(waypoints[i], velocity, acceleration, blendRadius);
+	}
+	if (blocking) {
+		jpTrajectory.waitUntilDone(jpTrajectory.getNumEnqueued());
+	}
+}
+
+template<size_t DOF>
+void Wam<DOF>::moveThrough(const std::vector<cp_type>& waypoints, bool blocking, double velocity, double acceleration, double blendRadius)
+{
+	for (size_t i = 0; i < waypoints.size(); ++i) {
+		appendMove(waypoints[i], velocity, acceleration, blendRadius);
+	}
+	if (blocking) {
+		tpTrajectory.waitUntilDone(tpTrajectory.getNumEnqueued());
 	}
 }
 
 template<size_t DOF>
 bool Wam<DOF>::moveIsDone() const
 {
-	return doneMoving;
+	return jpTrajectory.isIdle()  &&  tpTrajectory.isIdle()  &&
+			toTrajectory.isIdle()  &&  poseTrajectory.isIdle();
+}
+
+template<size_t DOF>
+bool Wam<DOF>::waitUntilSettled(double velocityThreshold, double settleTime, double timeout)
+{
+	ExecutionManager* em = jvFilter.getExecutionManager();
+	if (em == NULL) {
+		return false;
+	}
+
+	size_t windowSize = std::max((size_t) 2, (size_t) std::ceil(settleTime / em->getPeriod()));
+	SettleDetector<jv_type> sd(windowSize, jv_type(velocityThreshold), jv_type(velocityThreshold));
+	connect(jvOutput, sd.input);
+	em->startManaging(sd);
+
+	return sd.waitUntilSettled(timeout);
+}
+
+template<size_t DOF>
+void Wam<DOF>::setJerkLimit(double jerk)
+{
+	jpTrajectory.setJerkLimit(jerk);
+	tpTrajectory.setJerkLimit(jerk);
+	toTrajectory.setJerkLimit(jerk);
+	poseTrajectory.setJerkLimit(jerk);
 }
 
 template<size_t DOF>
@@ -387,64 +472,5 @@ T Wam<DOF>::currentPosHelper(const T& currentPos)
 	return currentPos;
 }
 
-template<size_t DOF>
-template<typename T>
-void Wam<DOF>::moveToThread(const T& currentPos, /*const typename T::unitless_type& currentVel,*/ const T& destination, double velocity, double acceleration, bool* started, boost::shared_future<boost::thread*> threadPtrFuture)
-{
-	// Only remove this thread from mtThreadGroup on orderly exit. (Don't remove on exception.)
-	bool removeThread = false;
-	
-	try {
-		std::vector<T, Eigen::aligned_allocator<T> > vec;
-		vec.push_back(currentPos);
-		vec.push_back(destination);
-
-		// TODO(dc): Use currentVel. Requires changes to math::spline<Eigen::Quaternion<T> > specialization.
-		//math::Spline<T> spline(vec, currentVel);
-		//math::TrapezoidalVelocityProfile profile(velocity, acceleration, currentVel.norm(), spline.changeInS());
-		math::Spline<T> spline(vec);
-		math::TrapezoidalVelocityProfile profile(velocity, acceleration, 0.0, spline.changeInS());
-
-		Ramp time(NULL, 1.0);
-		Callback<double, T> trajectory(boost::bind(boost::ref(spline), boost::bind(boost::ref(profile), _1)));
-
-		connect(time.output, trajectory.input);
-		trackReferenceSignal(trajectory.output);
-		time.start();
-
-		doneMoving = false;
-		*started = true;
-
-		// The value of trajectory.input will be undefined until the next execution cycle.
-		// It may become undefined again if trajectory.output is disconnected and this chain
-		// of Systems loses its ExecutionManager. We must check that the value is defined
-		// before calling getValue().
-		while ( !trajectory.input.valueDefined()  ||  trajectory.input.getValue() < profile.finalT()) {
-			// if the move is interrupted, clean up and end the thread
-			if ( !trajectory.output.isConnected() ||  boost::this_thread::interruption_requested() ) {
-				removeThread = true;
-				break;
-			}
-			btsleep(0.01);  // Interruption point. May throw boost::thread_interrupted
-		}
-
-		if ( !removeThread ) {
-			doneMoving = true;
-
-			// Wait until the trajectory is no longer referenced by supervisoryController
-			while (trajectory.hasExecutionManager()  &&  !boost::this_thread::interruption_requested()) {
-				btsleep(0.01);  // Interruption point. May throw boost::thread_interrupted
-			}
-			removeThread = true;
-		}
-	} catch (const boost::thread_interrupted& e) {}
-	
-	if (removeThread) {
-		mtThreadGroup.remove_thread(threadPtrFuture.get());
-		delete threadPtrFuture.get();
-	}
-}
-
-
 }
 }
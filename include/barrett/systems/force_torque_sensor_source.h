@@ -0,0 +1,134 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * force_torque_sensor_source.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_FORCE_TORQUE_SENSOR_SOURCE_H_
+#define BARRETT_SYSTEMS_FORCE_TORQUE_SENSOR_SOURCE_H_
+
+
+#include <string>
+
+#include <Eigen/Core>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/units.h>
+#include <barrett/math/first_order_filter.h>
+#include <barrett/products/force_torque_sensor.h>
+#include <barrett/systems/abstract/execution_manager.h>
+#include <barrett/systems/abstract/system.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Samples a ForceTorqueSensor once per execution cycle.
+ *
+ * The request is sent and the reply is received from within the control loop,
+ * so the latency between the sensor reading and its use by downstream Systems
+ * is fixed. Each sample is biased and (optionally) low-pass filtered before it
+ * is published along with the highResolutionSystemTime() at which the reply
+ * arrived.
+ *
+ * The bias is estimated in the control loop: after a call to tare(), the next
+ * \c numSamples raw readings are averaged and subtracted from all subsequent
+ * readings. The outputs are undefined while the bias is being estimated.
+ * Changing the bias (with tare() or setBias()) also resets the low-pass
+ * filters, so the first filtered outputs start from zero.
+ */
+class ForceTorqueSensorSource : public System {
+public:
+	BARRETT_UNITS_FIXED_SIZE_TYPEDEFS;
+
+
+// IO
+public:		Output<cf_type> forceOutput;
+protected:	Output<cf_type>::Value* forceOutputValue;
+public:		Output<ct_type> torqueOutput;
+protected:	Output<ct_type>::Value* torqueOutputValue;
+public:		Output<double> timeOutput;
+protected:	Output<double>::Value* timeOutputValue;
+
+
+public:
+	ForceTorqueSensorSource(ExecutionManager* em, ForceTorqueSensor* fts,
+			const std::string& sysName = "ForceTorqueSensorSource");
+	virtual ~ForceTorqueSensorSource();
+
+	ForceTorqueSensor& getSensor() const { return *fts; }
+
+	/** Filter each axis with a first-order low-pass with corner frequency \c omega_p (rad/s). */
+	void setLowPass(double forceOmega_p, double torqueOmega_p);
+	void setLowPass(double omega_p) { setLowPass(omega_p, omega_p); }
+	void clearLowPass();
+
+	void tare(size_t numSamples = 100);
+	bool isTaring() const { return tareSamplesRemaining != 0; }
+	void setBias(const cf_type& forceBias, const ct_type& torqueBias);
+	const cf_type& getForceBias() const { return cfBias; }
+	const ct_type& getTorqueBias() const { return ctBias; }
+
+protected:
+	virtual bool inputsValid() { return true; }
+	virtual void operate();
+	virtual void invalidateOutputs() {  /* do nothing */  }
+	virtual void prefault();
+
+	virtual void onExecutionManagerChanged() {
+		System::onExecutionManagerChanged();  // First, call super
+		getSamplePeriodFromEM();
+	}
+	void getSamplePeriodFromEM();
+
+	ForceTorqueSensor* fts;
+
+	bool filtering;
+	math::FirstOrderFilter<cf_type> cfFilter;
+	math::FirstOrderFilter<ct_type> ctFilter;
+
+	size_t tareSamples, tareSamplesRemaining;
+	cf_type cfBias, cfSum;
+	ct_type ctBias, ctSum;
+
+	cf_type cf;
+	ct_type ct;
+	double time;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(ForceTorqueSensorSource);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_FORCE_TORQUE_SENSOR_SOURCE_H_ */
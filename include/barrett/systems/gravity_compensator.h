@@ -79,6 +79,15 @@ protected:
 		this->outputValue->setData(&data);
 	}
 
+	// Systems we pull from have already been prefaulted and haven't been
+	// given a newer update token than ours, so reading kinInput here doesn't
+	// run them again.
+	virtual void prefault() {
+		if (this->kinInput.valueDefined()) {
+			bt_calgrav_eval(impl, this->kinInput.getValue().impl, data.asGslType());
+		}
+	}
+
 	struct bt_calgrav* impl;
 	jt_type data;
 
@@ -0,0 +1,203 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * hand_sensor_scheduler.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_HAND_SENSOR_SCHEDULER_H_
+#define BARRETT_SYSTEMS_HAND_SENSOR_SCHEDULER_H_
+
+
+#include <string>
+
+#include <Eigen/Core>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/math/matrix.h>
+#include <barrett/products/hand.h>
+#include <barrett/products/tactile_puck.h>
+#include <barrett/systems/abstract/execution_manager.h>
+#include <barrett/systems/abstract/system.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Polls the sensors of a Hand at different rates from within the control loop.
+ *
+ * Hand::update() requests every sensor stream at once and blocks on all of the
+ * replies. This System instead spreads the traffic over several execution
+ * cycles:
+ *   - finger positions are read every cycle,
+ *   - fingertip torques are read every \c fingertipTorqueDivider cycles,
+ *   - tactile pads are read round-robin, one TactilePuck per cycle.
+ *
+ * Tactile pads are read with TactilePuck::update(), so each pad's
+ * TactilePuck::setMode() determines whether it reports in FULL or TOP10
+ * format.
+ *
+ * Before sending any requests, the System estimates how long the resulting CAN
+ * traffic will occupy the bus. Fingertip torque and tactile reads that don't
+ * fit in the per-cycle bus-time budget are deferred to a later cycle. Position
+ * reads are never deferred. When the fingertip torques and a tactile pad don't
+ * fit in the same cycle, they take turns. The budget defaults to the
+ * ExecutionManager's period less the time a WAM's own traffic takes on the
+ * same bus (see defaultBusTimeBudget()); raise it if the Hand has a bus to
+ * itself. A stream that doesn't fit in the budget even alongside the positions
+ * is never read.
+ *
+ * Each stream is published along with the highResolutionSystemTime() at which
+ * its replies were received.
+ */
+class HandSensorScheduler : public System {
+public:
+	static const size_t DOF = Hand::DOF;
+	BARRETT_UNITS_TYPEDEFS(DOF);
+
+	/// Row i holds the most recent data from Hand::getTactilePucks()[i].
+	typedef math::Matrix<DOF, TactilePuck::NUM_SENSORS> tact_type;
+
+
+// IO
+public:		Output<jp_type> innerJpOutput;
+protected:	Output<jp_type>::Value* innerJpOutputValue;
+public:		Output<jp_type> outerJpOutput;
+protected:	Output<jp_type>::Value* outerJpOutputValue;
+public:		Output<double> positionTimeOutput;
+protected:	Output<double>::Value* positionTimeOutputValue;
+
+public:		Output<v_type> fingertipTorqueOutput;
+protected:	Output<v_type>::Value* fingertipTorqueOutputValue;
+public:		Output<double> fingertipTorqueTimeOutput;
+protected:	Output<double>::Value* fingertipTorqueTimeOutputValue;
+
+public:		Output<tact_type> tactOutput;
+protected:	Output<tact_type>::Value* tactOutputValue;
+public:		Output<double> tactTimeOutput;
+protected:	Output<double>::Value* tactTimeOutputValue;
+
+
+public:
+	/** Approximate time (in seconds) for one CAN frame at 1 Mbit/s, including
+	 * bit-stuffing and inter-frame space.
+	 */
+	static const double FRAME_TIME = 130e-6;
+
+	static double frameTime(size_t numFrames) { return numFrames * FRAME_TIME; }
+
+	/** CAN frames a 7-DOF WAM exchanges on the bus each cycle: a position
+	 * request, a reply from each Puck, and two packed torque commands.
+	 */
+	static const size_t WAM_FRAMES = 1 + 7 + 2;
+
+	/** The budget used when none is given: \c period_s less the bus time
+	 * reserved for a WAM (WAM_FRAMES). Never negative.
+	 */
+	static double defaultBusTimeBudget(double period_s);
+
+
+	/** Decides which streams to read in each cycle.
+	 *
+	 * This is the part of HandSensorScheduler that doesn't talk to the Hand.
+	 */
+	class Schedule {
+	public:
+		explicit Schedule(size_t fingertipTorqueDivider = 5);
+
+		void setFingertipTorqueDivider(size_t divider);
+		size_t getFingertipTorqueDivider() const { return fttDivider; }
+
+		/** Plans the next cycle.
+		 *
+		 * \c tactFrames is the number of reply frames the next tactile pad
+		 * will send, or zero if there are no tactile pads. On return,
+		 * \c readFtt and \c readTact say which optional streams to read in
+		 * addition to the positions.
+		 */
+		void next(double budget_s, bool hasFtt, size_t tactFrames, bool* readFtt, bool* readTact);
+
+		unsigned long getNumDeferredReads() const { return numDeferred; }
+
+	protected:
+		bool fits(double* busTime, size_t numFrames, double budget_s);
+
+		size_t fttDivider;
+		size_t cycle;
+		bool fttPending;
+		bool tactFirst;  // Whether tactile reads go first when both don't fit
+		unsigned long numDeferred;
+	};
+
+
+	/** @param busTimeBudget_s Zero means defaultBusTimeBudget() of the
+	 * ExecutionManager's period.
+	 */
+	HandSensorScheduler(ExecutionManager* em, Hand* hand,
+			size_t fingertipTorqueDivider = 5, double busTimeBudget_s = 0.0,
+			const std::string& sysName = "HandSensorScheduler");
+	virtual ~HandSensorScheduler();
+
+	Hand& getHand() const { return *hand; }
+
+	void setFingertipTorqueDivider(size_t divider) { schedule.setFingertipTorqueDivider(divider); }
+	size_t getFingertipTorqueDivider() const { return schedule.getFingertipTorqueDivider(); }
+	void setBusTimeBudget(double budget_s);
+	double getBusTimeBudget() const { return busTimeBudget; }
+
+	/// Number of times a fingertip torque or tactile read was put off because it didn't fit in the budget.
+	unsigned long getNumDeferredReads() const { return schedule.getNumDeferredReads(); }
+
+protected:
+	virtual bool inputsValid() { return true; }
+	virtual void operate();
+	virtual void invalidateOutputs() {  /* do nothing */  }
+	virtual void prefault();
+
+	Hand* hand;
+	double busTimeBudget;
+
+	Schedule schedule;
+	size_t nextPad;
+
+	jp_type innerJp, outerJp;
+	v_type ftt;
+	tact_type tact;
+	double positionTime, fttTime, tactTime;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(HandSensorScheduler);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_HAND_SENSOR_SCHEDULER_H_ */
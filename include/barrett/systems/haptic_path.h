@@ -32,15 +32,13 @@
 #define BARRETT_SYSTEMS_HAPTIC_PATH_H_
 
 
-#include <cmath>
-#include <cassert>
 #include <vector>
+#include <string>
 
 #include <Eigen/Core>
 
 #include <barrett/detail/ca_macro.h>
 #include <barrett/units.h>
-#include <barrett/math.h>
 #include <barrett/systems/abstract/haptic_object.h>
 
 
@@ -48,81 +46,78 @@ namespace barrett {
 namespace systems {
 
 
+/** Pulls the tool toward the nearest point on a path.
+ *
+ * The path is resampled to roughly 1 cm spacing and interpolated with a
+ * math::Spline. Each cubic piece of the spline is stored as a polynomial, so
+ * the nearest point on a piece is found in closed form (Newton's method on the
+ * derivative of the squared distance) without evaluating the Spline.
+ *
+ * To find the nearest piece, operate() first checks the pieces around the
+ * previous nearest point. Then it searches a bounding volume hierarchy over
+ * the pieces, skipping every branch that is farther away than the best point
+ * found so far. When the tool moves smoothly, this costs O(log n) per
+ * execution cycle for a path with n pieces.
+ */
 class HapticPath : public HapticObject {
 	BARRETT_UNITS_FIXED_SIZE_TYPEDEFS;
 
 	static const double COARSE_STEP = 0.01;
-	static const double FINE_STEP = 0.0001;
 
 public:		System::Output<cp_type> tangentDirectionOutput;
 protected:	System::Output<cp_type>::Value* tangentDirectionOutputValue;
 
 public:
 	HapticPath(const std::vector<cp_type>& path,
-			const std::string& sysName = "HapticPath") :
-		HapticObject(sysName),
-		tangentDirectionOutput(this, &tangentDirectionOutputValue),
-		nearestIndex(0), spline(NULL)
-	{
-		// Sample the path
-		cp_type prev = path[0];
-		for (size_t i = 0; i < path.size(); ++i) {
-			if ((path[i] - prev).norm() > COARSE_STEP) {
-				coarsePath.push_back(path[i]);
-				prev = path[i];
-			}
-		}
-		spline = new math::Spline<cp_type>(coarsePath);
-	}
-
-	virtual ~HapticPath() {
-		mandatoryCleanUp();
-		delete spline;
-	}
+			const std::string& sysName = "HapticPath");
+	virtual ~HapticPath();
 
-protected:
-	virtual void operate() {
-		const cp_type& cp = input.getValue();
-
-		// Coarse search
-		minDist = (coarsePath[nearestIndex] - cp).norm();
-		for (size_t i = 0; i < coarsePath.size(); ++i) {
-			double dist = (coarsePath[i] - cp).norm();
-			if (dist < minDist) {
-				minDist = dist;
-				nearestIndex = i;
-			}
-		}
-
-		// Fine search
-		// TODO(dc): Can we do this without relying on Spline's implementation?
-		double sNearest = spline->getImplementation()->ss[nearestIndex];
-		double sLow = sNearest - COARSE_STEP;
-		double sHigh = sNearest + COARSE_STEP;
-		for (double s = sLow; s <= sHigh; s += FINE_STEP) {
-			double dist = (spline->eval(s) - cp).norm();
-			if (dist < minDist) {
-				minDist = dist;
-				sNearest = s;
-			}
-		}
-
-		dir = (spline->eval(sNearest) - cp).normalized();
-		tangentDir = spline->evalDerivative(sNearest).normalized();
-
-		depthOutputValue->setData(&minDist);
-		directionOutputValue->setData(&dir);
-		tangentDirectionOutputValue->setData(&tangentDir);
-	}
+	size_t getNumSegments() const { return segments.size(); }
 
+protected:
+	static const size_t SEGMENTS_PER_LEAF = 4;
+	static const size_t MAX_TREE_DEPTH = 64;
+	static const int MAX_NEWTON_ITERATIONS = 8;
+
+	// One cubic piece of the spline:
+	// p(u) = c0 + u*(c1 + u*(c2 + u*c3)) for u in [0,1], and s = s0 + u*ds
+	struct Segment {
+		cp_type c0, c1, c2, c3;
+		double s0, ds;
+		cp_type lower, upper;  // Bounding box
+
+		cp_type eval(double u) const { return c0 + u*(c1 + u*(c2 + u*c3)); }
+		cp_type evalDerivative(double u) const { return c1 + u*(2.0*c2 + 3.0*u*c3); }
+		cp_type evalSecondDerivative(double u) const { return 2.0*c2 + 6.0*u*c3; }
+	};
+
+	// A node in the bounding volume hierarchy. It covers segments [begin, end).
+	// Inner nodes have two children, stored at firstChild and firstChild + 1.
+	struct Node {
+		cp_type lower, upper;
+		size_t begin, end;
+		size_t firstChild;  // 0 for leaves
+	};
+
+	virtual void operate();
+
+	void buildTree(size_t node);
+	double project(const Segment& seg, const cp_type& cp, double* u) const;
+	void check(size_t i, const cp_type& cp);
+	static double distanceSquaredToBox(const cp_type& lower, const cp_type& upper, const cp_type& cp);
+
+	std::vector<Segment> segments;
+	std::vector<Node> tree;
+
+	// Results of the nearest-point search
 	double minDist;
+	double minDistSquared;
 	size_t nearestIndex;
+	double uNearest;
+
 	cf_type dir;
 	cp_type tangentDir;
 
-	std::vector<cp_type> coarsePath;
-	math::Spline<cp_type>* spline;
-
 private:
 	DISALLOW_COPY_AND_ASSIGN(HapticPath);
 
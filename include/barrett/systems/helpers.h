@@ -65,6 +65,12 @@ void reconnect(System::Output<T>& newOutput, System::Input<T>& input)
 
 	assert(input.isConnected());
 
+	// Disconnecting would briefly leave the output's System without an
+	// ExecutionManager.
+	if (input.isConnectedTo(newOutput)) {
+		return;
+	}
+
 	disconnect(input);
 	connect(newOutput, input);
 }
@@ -81,6 +81,14 @@ protected:
 		kinOutputValue->setData(&kin);
 	}
 
+	// Evaluate once at the zero position to warm up the kinematics state. This
+	// also leaves kinOutput defined for downstream Systems' prefault().
+	virtual void prefault() {
+		kin.eval(typename units::JointPositions<DOF>::type(0.0),
+				typename units::JointVelocities<DOF>::type(0.0));
+		kinOutputValue->setData(&kin);
+	}
+
 	math::Kinematics<DOF> kin;
 
 private:
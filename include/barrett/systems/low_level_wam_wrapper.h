@@ -129,6 +129,7 @@ protected:
 
 	protected:
 		virtual void operate();
+		virtual void prefault();
 
 		LowLevelWamWrapper* parent;
 
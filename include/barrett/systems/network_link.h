@@ -0,0 +1,170 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * network_link.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_NETWORK_LINK_H_
+#define BARRETT_SYSTEMS_NETWORK_LINK_H_
+
+
+#include <string>
+#include <stdint.h>
+
+#include <boost/thread.hpp>
+#include <Eigen/Core>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/math/traits.h>
+#include <barrett/math/jitter_buffer.h>
+#include <barrett/thread/bounded_queue.h>
+#include <barrett/thread/seqlock.h>
+#include <barrett/systems/abstract/single_io.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Exchanges a signal with a NetworkLink in another process or on another computer over UDP.
+ *
+ * Each execution cycle, operate() sends its input and outputs the other end's
+ * input. Every packet carries a sequence number and a time stamp. operate()
+ * never touches the socket: packets pass through lock-free queues to and from
+ * an I/O thread, which sends (in one sendmmsg() call, where available, if
+ * several packets are waiting) and receives them. The I/O thread is an
+ * ordinary thread, so socket calls never cause mode switches in the execution
+ * thread.
+ *
+ * Received packets go through a math::JitterBuffer: the output is played back
+ * playoutDelay seconds behind the other end, interpolating between packets and
+ * extrapolating (for up to maxExtrapolation seconds) across late or lost ones.
+ * If no packet arrives for timeout seconds, the output is undefined and
+ * isLinked() returns false. The next packet starts a new stream, so the link
+ * recovers if the other end restarts.
+ *
+ * Packets also echo the time stamp of the last packet received, which gives
+ * each end an estimate of the round-trip time. getStatistics() can be called
+ * from any thread.
+ *
+ * Both ends must use the same T (with the same layout): values are sent as
+ * raw bytes.
+ */
+template<typename T, typename MathTraits = math::Traits<T> >
+class NetworkLink : public SingleIO<T, T> {
+protected:
+	typedef MathTraits MT;
+
+public:
+	struct Statistics {
+		unsigned long packetsSent;
+		unsigned long packetsDropped;  ///< Not sent because the I/O thread fell behind
+		unsigned long packetsReceived;
+		unsigned long packetsLost;  ///< See math::JitterBuffer::getNumLost()
+		unsigned long packetsLate;  ///< See math::JitterBuffer::getNumLate()
+		double roundTripTime;  ///< Smoothed, in seconds. Zero until measured.
+		double jitter;  ///< Interarrival jitter (RFC 3550), in seconds
+	};
+
+	/**
+	 * @param remoteHost The other end's IPv4 address
+	 * @param localPort The UDP port to receive on
+	 * @param remotePort The UDP port the other end receives on
+	 * @param playoutDelay See math::JitterBuffer
+	 * @param maxExtrapolation See math::JitterBuffer
+	 * @param timeout The output is undefined after this long without a packet (seconds)
+	 * @param ioPeriod How often the I/O thread checks for packets to send (seconds)
+	 * @param batchSends If false, don't use sendmmsg()
+	 */
+	NetworkLink(const std::string& remoteHost, int localPort, int remotePort,
+			double playoutDelay = 0.0, double maxExtrapolation = 0.01, double timeout = 0.1,
+			double ioPeriod = 0.0002, bool batchSends = true,
+			const std::string& sysName = "NetworkLink");
+	virtual ~NetworkLink();
+
+	bool isLinked() const { return linked; }
+	Statistics getStatistics() const { return stats.read(); }
+
+protected:
+	static const size_t QUEUE_SIZE = 64;
+	static const size_t MAX_BATCH = 16;
+	static const double RTT_GAIN = 0.125;
+
+	struct Packet {
+		uint32_t seq;
+		double sendTime;
+		double echoTime;  ///< sendTime of the last packet received
+		double echoDelay;  ///< Time from receiving that packet until sending this one; negative if none
+		T value;
+	};
+	struct ReceivedPacket {
+		Packet packet;
+		double receiveTime;
+	};
+
+	virtual void operate();
+	void ioThreadEntryPoint();
+	void sendPackets(Packet* packets, size_t n);
+
+	int sock;
+	double timeout;
+	double ioPeriod;
+	bool batchSends;
+
+	thread::BoundedQueue<Packet, QUEUE_SIZE> txQueue;
+	thread::BoundedQueue<ReceivedPacket, QUEUE_SIZE> rxQueue;
+	volatile bool stopRequested;
+	boost::thread ioThread;
+
+	// Only accessed from the execution thread
+	math::JitterBuffer<T, MT> jb;
+	Packet txPacket;
+	ReceivedPacket rxPacket;
+	uint32_t txSeq;
+	double lastRemoteSendTime, lastRemoteReceiveTime;
+	Statistics s;
+	T data;
+
+	volatile bool linked;
+	thread::SeqLock<Statistics> stats;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(NetworkLink);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF(MT::RequiresAlignment)
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/systems/detail/network_link-inl.h>
+
+
+#endif /* BARRETT_SYSTEMS_NETWORK_LINK_H_ */
@@ -51,7 +51,7 @@ class RealTimeExecutionManager : public ExecutionManager {
 public:
 	typedef boost::function<void (RealTimeExecutionManager*, const ExecutionManagerException&)> callback_type;
 
-	explicit RealTimeExecutionManager(double period_s, int rt_priority = 50);
+	explicit RealTimeExecutionManager(double period_s, int rt_priority = 50, int cpu = -1);
 	explicit RealTimeExecutionManager(const libconfig::Setting& setting);  //TODO(dc): test!
 	virtual ~RealTimeExecutionManager();
 
@@ -66,9 +66,16 @@ public:
 	void setErrorCallback(callback_type callback);
 	void clearErrorCallback();
 
+	/** Pin the execution thread to a CPU (-1 means any CPU). Takes effect the
+	 * next time the RealTimeExecutionManager is started.
+	 */
+	void setCpuAffinity(int cpu) { cpuAffinity = cpu; }
+	int getCpuAffinity() const { return cpuAffinity; }
+
 protected:
 	boost::thread thread;
 	int priority;
+	int cpuAffinity;
 	bool running;
 
 	bool error;
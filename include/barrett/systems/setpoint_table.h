@@ -0,0 +1,117 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+
+
+/*
+ * setpoint_table.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_SETPOINT_TABLE_H_
+#define BARRETT_SYSTEMS_SETPOINT_TABLE_H_
+
+
+#include <vector>
+#include <string>
+
+#define EIGEN_USE_NEW_STDVECTOR
+#include <Eigen/StdVector>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/systems/abstract/single_io.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Streams a trajectory that was evaluated ahead of time.
+ *
+ * The constructor evaluates a trajectory once per control period and stores
+ * the results in a contiguous table. The work can be split across several
+ * threads. After that, operate() turns the input time into an index and
+ * outputs the table entry at that index. Its cost doesn't depend on the size
+ * of the trajectory.
+ *
+ * The input is time, as from a systems::Ramp. The output is the setpoint for
+ * the nearest tick: the first setpoint before initialT() and the last setpoint
+ * after finalT().
+ *
+ * SplineType is a math::Spline or another type with a thread-safe
+ * eval(sBegin, sEnd, result). ProfileType maps time to the spline's
+ * parameter, like math::TrapezoidalVelocityProfile or math::SCurveProfile.
+ */
+template<typename T>
+class SetpointTable : public SingleIO<double, T> {
+public:
+	/// Evaluates spline at every tick from spline.initialS() to spline.finalS()
+	template<typename SplineType>
+	SetpointTable(const SplineType& spline, double period, size_t numThreads = 1,
+			const std::string& sysName = "SetpointTable");
+
+	/** Evaluates spline at profile.eval(t) for every tick from 0 to profile.finalT()
+	 *
+	 * numThreads has no default here so that calls to the constructor above
+	 * aren't ambiguous.
+	 */
+	template<typename SplineType, typename ProfileType>
+	SetpointTable(const SplineType& spline, const ProfileType& profile, double period,
+			size_t numThreads, const std::string& sysName = "SetpointTable");
+
+	virtual ~SetpointTable() { this->mandatoryCleanUp(); }
+
+	double initialT() const { return t_0; }
+	double finalT() const { return t_0 + (table.size() - 1) * period; }
+	double getPeriod() const { return period; }
+
+	size_t size() const { return table.size(); }
+	const T& getSetpoint(size_t i) const { return table[i]; }
+
+protected:
+	template<typename SplineType, typename ProfileType>
+	void render(const SplineType& spline, const ProfileType& profile, double t_f, size_t numThreads);
+
+	template<typename SplineType, typename ProfileType>
+	void renderChunk(const SplineType* spline, const ProfileType* profile, size_t begin, size_t end);
+
+	virtual void operate();
+
+	std::vector<T, Eigen::aligned_allocator<T> > table;
+	double t_0, period, rate;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(SetpointTable);
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/systems/detail/setpoint_table-inl.h>
+
+
+#endif /* BARRETT_SYSTEMS_SETPOINT_TABLE_H_ */
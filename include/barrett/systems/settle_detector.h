@@ -0,0 +1,119 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+
+
+
+/*
+ * settle_detector.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_SETTLE_DETECTOR_H_
+#define BARRETT_SYSTEMS_SETTLE_DETECTOR_H_
+
+
+#include <vector>
+#include <string>
+
+#define EIGEN_USE_NEW_STDVECTOR
+#include <Eigen/StdVector>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/math/traits.h>
+#include <barrett/systems/abstract/single_io.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Detects when a signal has settled, for instance when joint velocities have
+ * died out after a move or joint torques have stopped changing.
+ *
+ * The statistics are taken over the last \c windowSize samples of the input.
+ * The output is true once every element of their mean is within
+ * \c meanThreshold of zero and every element of their standard deviation is
+ * within \c deviationThreshold. A threshold of zero isn't checked. Use both
+ * for velocities (so the signal is near zero and isn't oscillating about zero)
+ * and only the deviation for torques (which settle at some non-zero value).
+ *
+ * The output is false until a full window of samples has been collected. The
+ * system must be operated every cycle, so use ExecutionManager::startManaging()
+ * if nothing else pulls on its output.
+ */
+template<typename T, typename MathTraits = math::Traits<T> >
+class SettleDetector : public SingleIO<T, bool> {
+protected:
+	typedef MathTraits MT;
+
+public:
+	explicit SettleDetector(size_t windowSize, const T& meanThreshold = T(0.0),
+			const T& deviationThreshold = T(0.0), const std::string& sysName = "SettleDetector");
+	virtual ~SettleDetector() { this->mandatoryCleanUp(); }
+
+	size_t getWindowSize() const { return window.size(); }
+
+	bool isSettled() const { return settled; }
+
+	/** Blocks until the input settles, considering only samples taken after
+	 * this method is called.
+	 *
+	 * Returns false if the input hasn't settled within \c timeout seconds (zero
+	 * means wait indefinitely) or if the system isn't being operated.
+	 */
+	bool waitUntilSettled(double timeout = 0.0);
+
+protected:
+	virtual void operate();
+	void recomputeSums();
+
+	T meanThreshold, squaredDeviationThreshold;
+
+	std::vector<T, Eigen::aligned_allocator<T> > window;
+	size_t newest, count;
+	T sum, sumOfSquares;
+	T mean, variance;
+
+	volatile bool settled;
+	volatile bool resetRequested;
+	bool data;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(SettleDetector);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF(MT::RequiresAlignment)
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/systems/detail/settle_detector-inl.h>
+
+
+#endif /* BARRETT_SYSTEMS_SETTLE_DETECTOR_H_ */
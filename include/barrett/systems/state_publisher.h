@@ -0,0 +1,82 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * state_publisher.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_STATE_PUBLISHER_H_
+#define BARRETT_SYSTEMS_STATE_PUBLISHER_H_
+
+
+#include <string>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/thread/shared_memory.h>
+#include <barrett/systems/abstract/system.h>
+#include <barrett/systems/abstract/single_io.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Publishes its input to other processes through shared memory.
+ *
+ * The constructor creates a thread::SharedMemoryChannel<T> named shmName
+ * (failing if it already exists, unless replace is true); the destructor
+ * removes it. Each execution
+ * cycle, operate() writes the input and a time stamp to the channel. Other
+ * processes open the channel by name and read the most recent value whenever
+ * they like. Publishing is a copy into memory: it makes no system calls and
+ * never waits for readers.
+ */
+template<typename T>
+class StatePublisher : public System, public SingleInput<T> {
+public:
+	explicit StatePublisher(const std::string& shmName, bool replace = false,
+			const std::string& sysName = "StatePublisher") :
+		System(sysName), SingleInput<T>(this), channel(shmName, true, replace) {}
+	virtual ~StatePublisher() { mandatoryCleanUp(); }
+
+	const std::string& getChannelName() const { return channel.getName(); }
+
+protected:
+	virtual void operate() {
+		channel.write(this->input.getValue());
+	}
+
+	thread::SharedMemoryChannel<T> channel;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(StatePublisher);
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_STATE_PUBLISHER_H_ */
@@ -0,0 +1,127 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * state_snapshot.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_STATE_SNAPSHOT_H_
+#define BARRETT_SYSTEMS_STATE_SNAPSHOT_H_
+
+
+#include <string>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/os.h>
+#include <barrett/units.h>
+#include <barrett/thread/seqlock.h>
+#include <barrett/systems/abstract/system.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Publishes a WAM's state once per execution cycle for non-real-time readers.
+ *
+ * operate() copies the inputs into a State and publishes it through a
+ * thread::SeqLock. getState() and tryGetState() read the most recent State
+ * without taking the execution manager's mutex, so a monitoring thread (or
+ * Python) can poll as often as it likes without ever delaying the execution
+ * cycle. A reader that overlaps with a write retries; the writer never waits.
+ *
+ * Nothing is published until the StateSnapshot is managed by an
+ * ExecutionManager. See Wam::publishState().
+ */
+template<size_t DOF>
+class StateSnapshot : public System {
+	BARRETT_UNITS_TEMPLATE_TYPEDEFS(DOF);
+
+public:
+	struct State {
+		/// Number of States published so far. Zero until the first cycle.
+		unsigned long cycle;
+		/// highResolutionSystemTime() when the State was published
+		double time;
+
+		jp_type jp;
+		jv_type jv;
+		jt_type jt;
+		cp_type cp;
+		Eigen::Quaterniond to;
+
+		State() : cycle(0), time(0.0), jp(0.0), jv(0.0), jt(0.0), cp(0.0), to(1.0, 0.0, 0.0, 0.0) {}
+
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+
+
+	Input<jp_type> jpInput;
+	Input<jv_type> jvInput;
+	Input<jt_type> jtInput;
+	Input<pose_type> poseInput;
+
+	explicit StateSnapshot(const std::string& sysName = "StateSnapshot") :
+		System(sysName), jpInput(this), jvInput(this), jtInput(this), poseInput(this),
+		state(), snapshot() {}
+	virtual ~StateSnapshot() { mandatoryCleanUp(); }
+
+	/// Returns the most recent State. Never blocks the execution thread.
+	State getState() const { return snapshot.read(); }
+	/// Returns false if a State was being published. Doesn't retry.
+	bool tryGetState(State* s) const { return snapshot.tryRead(s); }
+
+protected:
+	virtual void operate() {
+		++state.cycle;
+		state.time = highResolutionSystemTime();
+		state.jp = jpInput.getValue();
+		state.jv = jvInput.getValue();
+		state.jt = jtInput.getValue();
+		state.cp = poseInput.getValue().template get<0>();
+		state.to = poseInput.getValue().template get<1>();
+
+		snapshot.write(state);
+	}
+
+	State state;  // Only accessed from the execution thread
+	thread::SeqLock<State> snapshot;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(StateSnapshot);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_SYSTEMS_STATE_SNAPSHOT_H_ */
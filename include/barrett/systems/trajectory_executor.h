@@ -0,0 +1,257 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+
+/*
+ * trajectory_executor.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SYSTEMS_TRAJECTORY_EXECUTOR_H_
+#define BARRETT_SYSTEMS_TRAJECTORY_EXECUTOR_H_
+
+
+#include <string>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/math/spline.h>
+#include <barrett/math/trapezoidal_velocity_profile.h>
+#include <barrett/math/s_curve_profile.h>
+#include <barrett/thread/bounded_queue.h>
+#include <barrett/systems/abstract/system.h>
+#include <barrett/systems/abstract/single_io.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+/** Plays a queue of point-to-point moves.
+ *
+ * Each move is a math::Spline from a start point to a destination, timed by a
+ * math::TrapezoidalVelocityProfile. Moves are planned by the thread that calls
+ * enqueue() and handed to the execution thread through a lock-free queue, so
+ * the control loop never allocates or blocks on a move command. Up to
+ * \c NUM_SLOTS moves can be in flight at once. When a move finishes, the next
+ * one starts in the following execution cycle; once the queue is empty, the
+ * output holds the last destination.
+ *
+ * If a jerk limit is set, moves that start from rest are timed by a
+ * math::SCurveProfile instead. Blended moves (see below) always use a
+ * math::TrapezoidalVelocityProfile.
+ *
+ * A move enqueued with \c preempt set cancels all earlier moves, including the
+ * one that is executing. Cancelled moves count as done.
+ *
+ * append() adds a move that starts from the previous move's destination. If
+ * the previous move is still under way when the new one is picked up, the
+ * new move branches off of it \c blendRadius before the corner, and the
+ * velocity remains continuous. Otherwise, the new move starts from rest once
+ * the previous one is done. Both versions are planned by append(); the
+ * execution thread just picks one. Blending requires a math::Spline that
+ * accepts an initial direction, so append() is not available for
+ * Eigen::Quaternion or boost::tuple types.
+ *
+ * The TrajectoryExecutor only runs while something downstream is using its
+ * output (for instance, after Wam::trackReferenceSignal()). If that stops, all
+ * moves are cancelled. The output is undefined until the first move starts.
+ */
+template<typename T>
+class TrajectoryExecutor : public System, public SingleOutput<T> {
+public:
+	typedef unsigned long move_id_type;
+
+	static const size_t NUM_SLOTS = 8;
+
+	explicit TrajectoryExecutor(const std::string& sysName = "TrajectoryExecutor");
+	virtual ~TrajectoryExecutor();
+
+	/** Plans a move and queues it for execution.
+	 *
+	 * If all slots are in use, waits for an earlier move to finish while the
+	 * TrajectoryExecutor is running (see waitUntilDone()), and otherwise throws
+	 * std::runtime_error.
+	 * Returns an ID that can be passed to isDone() and waitUntilDone().
+	 *
+	 * Calls to enqueue() and append() must be serialized: they may only be made
+	 * from one thread at a time.
+	 */
+	move_id_type enqueue(const T& start, const T& destination,
+			double velocity, double acceleration, bool preempt = false);
+
+	/** Plans a move from the destination of the previous move and queues it
+	 * for execution.
+	 *
+	 * \c blendRadius is limited to half the length of the new move and of
+	 * the previous one. If it is zero, or if the new move turns back by more
+	 * than 90 degrees, the new move always starts from rest.
+	 * While the TrajectoryExecutor is running, append() waits for earlier moves
+	 * to finish if there aren't enough free slots. Throws std::logic_error if
+	 * there is no previous move and std::runtime_error if there are not enough
+	 * free slots.
+	 */
+	move_id_type append(const T& destination, double velocity,
+			double acceleration, double blendRadius);
+
+	bool isDone(move_id_type id) const { return completedId >= id; }
+	/// True if all enqueued moves are done.
+	bool isIdle() const { return completedId == enqueuedId; }
+
+	/** Returns once the move is done or the TrajectoryExecutor stops running.
+	 *
+	 * The TrajectoryExecutor is considered stopped if it has no
+	 * ExecutionManager, or if it hasn't been executed for half a second (or 50
+	 * periods, if that's longer): the ExecutionManager was stopped or nothing
+	 * pulls from the output any more.
+	 *
+	 * Returns true if the move is done. Waiting threads poll at the
+	 * ExecutionManager's period: notifying a condition variable from the control
+	 * loop would force a mode switch under Xenomai.
+	 */
+	bool waitUntilDone(move_id_type id) const;
+
+	/** Limits the jerk of moves planned from now on. Zero (the default) means
+	 * no limit.
+	 *
+	 * Like the velocity and acceleration, the jerk applies to the path
+	 * parameter of the move's math::Spline.
+	 */
+	void setJerkLimit(double jerk);
+	double getJerkLimit() const { return jerkLimit; }
+
+	/// The ID of the most recently enqueued move
+	move_id_type getNumEnqueued() const { return enqueuedId; }
+	/// The destination of the most recently enqueued move
+	const T& getFinalDestination() const { return lastDestination; }
+
+protected:
+	static const size_t NO_SLOT = NUM_SLOTS;
+
+	struct Slot {
+		Slot() :
+			id(0), preempt(false), appended(false), spline(NULL), profile(NULL),
+			sCurve(NULL), branchT(0.0), endT(0.0) {}
+
+		double finalT() const {
+			return sCurve != NULL ? sCurve->finalT() : profile->finalT();
+		}
+		double eval(double t) const {
+			return sCurve != NULL ? sCurve->eval(t) : profile->eval(t);
+		}
+		double evalDerivative(double t) const {
+			return sCurve != NULL ? sCurve->evalDerivative(t) : profile->evalDerivative(t);
+		}
+
+		move_id_type id;
+		bool preempt;
+		bool appended;
+		math::Spline<T>* spline;
+		math::TrapezoidalVelocityProfile* profile;
+		math::SCurveProfile* sCurve;  // Used instead of profile, if not NULL
+
+		// For a move that branches off the previous one: the time in the
+		// previous move's profile at which to switch
+		double branchT;
+		// The time at which the execution thread switches to the next move
+		double endT;
+	};
+
+	// A move, and (for append()) the version to use if it can't blend
+	struct Command {
+		size_t primary, alternate;
+	};
+
+	virtual void operate();
+	virtual void onExecutionManagerChanged();
+	void getSamplePeriodFromEM();
+
+	// Called from the execution thread
+	void accept(const Command& cmd);
+	Slot* tail();
+	void start(size_t slot, double t_0);
+	void cancelAll();
+	void retire(size_t slot, bool done = true);
+
+	// Called from other threads
+	void waitForFreeSlots(size_t n);
+	// Sleeps until the next execution cycle. Returns false if the
+	// TrajectoryExecutor isn't running.
+	bool waitForCycle() const;
+	size_t allocateSlot();
+	size_t numFreeSlots() const;
+	void push(size_t primary, size_t alternate = NO_SLOT);
+	const Slot* resolveTail() const;
+	void planFromRest(const T& start, const T& destination, double velocity,
+			double acceleration, Slot* s);
+	bool planBlend(const Slot& prev, const T& destination, double velocity,
+			double acceleration, double blendRadius, Slot* s);
+	void reclaimSlots();
+	void freeSlot(Slot& s);
+
+	double T_s;
+	double jerkLimit;
+
+	Slot slots[NUM_SLOTS];
+	bool slotFree[NUM_SLOTS];  // Only used by non-execution threads
+	thread::BoundedQueue<Command, NUM_SLOTS> commandQueue;
+	thread::BoundedQueue<size_t, NUM_SLOTS> retiredQueue;
+
+	move_id_type enqueuedId;
+	volatile move_id_type completedId;
+	T lastDestination;
+	size_t lastPrimary, lastAlternate;
+
+	// Which version of each Command the execution thread picked
+	volatile move_id_type resolvedId;
+	volatile bool resolvedBlend;
+	// Counts calls to operate(), so other threads can tell it's still running
+	volatile unsigned long numCycles;
+
+	// Execution thread state
+	bool dropAppended;  // The chain that append() extends was cancelled
+	size_t pending[NUM_SLOTS];
+	size_t pendingHead, numPending;
+	Slot* active;
+	size_t activeSlot;
+	double t;
+	T value;
+	bool valueDefined;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(TrajectoryExecutor);
+
+public:
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+}
+}
+
+
+// include template definitions
+#include <barrett/systems/detail/trajectory_executor-inl.h>
+
+
+#endif /* BARRETT_SYSTEMS_TRAJECTORY_EXECUTOR_H_ */
@@ -37,7 +37,6 @@
 
 #include <vector>
 
-#include <boost/thread.hpp>
 #include <Eigen/Core>
 #include <libconfig.h++>
 
@@ -66,6 +65,9 @@
 #include <barrett/systems/tool_orientation_controller.h>
 #include <barrett/systems/tool_force_to_joint_torques.h>
 #include <barrett/systems/tool_torque_to_joint_torques.h>
+#include <barrett/systems/trajectory_executor.h>
+#include <barrett/systems/settle_detector.h>
+#include <barrett/systems/state_snapshot.h>
 
 
 namespace barrett {
@@ -87,6 +89,7 @@ public:
 	ToolVelocity<DOF> toolVelocity;
 	ToolOrientation<DOF> toolOrientation;
 	TupleGrouper<cp_type, Eigen::Quaterniond> toolPose;
+	StateSnapshot<DOF> stateSnapshot;
 
 	Converter<jt_type> supervisoryController;
 	Gain<jt_type, double> jtPassthrough;
@@ -106,6 +109,12 @@ public:
 	ToolTorqueToJointTorques<DOF> tpoTt2jt;
 	Summer<jt_type, 2> tpoSum;
 
+	// moveTo() trajectories
+	TrajectoryExecutor<jp_type> jpTrajectory;
+	TrajectoryExecutor<cp_type> tpTrajectory;
+	TrajectoryExecutor<Eigen::Quaterniond> toTrajectory;
+	TrajectoryExecutor<pose_type> poseTrajectory;
+
 	Summer<jt_type, 3> jtSum;
 	enum {JT_INPUT = 0, GRAVITY_INPUT, SC_INPUT};
 
@@ -163,6 +172,21 @@ public:
      */
 	math::Matrix<6,DOF> getToolJacobian() const;
 
+	/** publishState() method starts (or stops) publishing the WAM's state once per execution cycle.
+	 *
+	 *  While publishing, getPublishedState() returns the joint positions, velocities and torques and the tool pose
+	 *  from the most recent cycle without taking the execution manager's mutex or evaluating the kinematics on the
+	 *  caller's thread. Use it to monitor the WAM from non-real-time threads. Publishing adds a copy of the state to
+	 *  each cycle and keeps the tool pose up to date.
+	 */
+	void publishState(bool publish = true);
+	bool isPublishingState() const { return stateSnapshot.hasDirectExecutionManager(); }
+	/** getPublishedState() returns the most recent state published by publishState().
+	 *
+	 *  The state's cycle count is zero if nothing has been published yet.
+	 */
+	typename StateSnapshot<DOF>::State getPublishedState() const { return stateSnapshot.getState(); }
+
     /** gravityCompensate() method activates Gravity Compensation for WAM
      */
 	void gravityCompensate(bool compensate = true);
@@ -189,17 +213,54 @@ public:
      *	blocking Determines whether program should wait for move to finish before continuing
      *	velocity Speed at which to move
      *	acceleration value in radians per second
+     *
+     *	Each move replaces the one in progress. Non-blocking calls return once the move is queued, which may take
+     *	up to a control cycle if many moves are queued at once. moveTo(), appendMove() and moveThrough() must be
+     *	serialized: call them from one thread at a time.
      */
 	void moveTo(const jp_type& destination, bool blocking = true, double velocity = 0.5, double acceleration = 0.5);
 	void moveTo(const cp_type& destination, bool blocking = true, double velocity = 0.1, double acceleration = 0.2);
 	void moveTo(const Eigen::Quaterniond& destination, bool blocking = true, double velocity = 0.5, double acceleration = 0.5);
 	void moveTo(const pose_type& destination, bool blocking = true, double velocity = 0.1, double acceleration = 0.2);
 	template<typename T> void moveTo(const T& currentPos, /*const typename T::unitless_type& currentVel,*/ const T& destination, bool blocking, double velocity, double acceleration);
+	/** appendMove() method queues a move that starts where the previously queued move ends.
+	 *
+	 *  The WAM doesn't stop at the previous destination: the new move blends with the previous one, cutting the
+	 *  corner within blendRadius (radians or meters) and keeping the velocity continuous. If the previous move is
+	 *  already done (or nearly done) when the new one is queued, the new move starts from rest. If no move is in
+	 *  progress, this behaves like a non-blocking moveTo().
+	 *
+	 *  Moves can be appended while earlier ones are executing. Use moveIsDone() to find out when the last one ends.
+	 */
+	void appendMove(const jp_type& destination, double velocity = 0.5, double acceleration = 0.5, double blendRadius = 0.1);
+	void appendMove(const cp_type& destination, double velocity = 0.1, double acceleration = 0.2, double blendRadius = 0.02);
+	template<typename T> void appendMove(const T& currentPos, const T& destination, double velocity, double acceleration, double blendRadius);
+	/** moveThrough() method moves through a list of joint positions or tool positions using appendMove().
+	 */
+	void moveThrough(const std::vector<jp_type>& waypoints, bool blocking = true, double velocity = 0.5, double acceleration = 0.5, double blendRadius = 0.1);
+	void moveThrough(const std::vector<cp_type>& waypoints, bool blocking = true, double velocity = 0.1, double acceleration = 0.2, double blendRadius = 0.02);
 	/** moveIsDone() method returns false while the trajectory controller for the most recent moveTo() command is still active. 
 	 *
 	 *  Only useful if the moveTo() is non-blocking. 
 	 */
 	bool moveIsDone() const;
+	/** waitUntilSettled() method blocks until the WAM has stopped moving.
+	 *
+	 *  The WAM is settled once the mean and the standard deviation of each joint velocity over the last settleTime
+	 *  seconds are within velocityThreshold (radians per second). Use this instead of a fixed wait after a move, or
+	 *  after a change in the applied torques. Returns false if the WAM hasn't settled within timeout seconds (zero
+	 *  means wait indefinitely).
+	 */
+	bool waitUntilSettled(double velocityThreshold = 0.02, double settleTime = 0.25, double timeout = 5.0);
+	/** setJerkLimit() method makes moveTo() use jerk-limited, S-curve velocity profiles.
+	 *
+	 *  The limit applies to moves planned after the call, in radians per second^3 for joint moves and meters per
+	 *  second^3 for tool moves. Smoother moves excite the cable drives less, which may allow higher accelerations.
+	 *  Zero (the default) restores trapezoidal velocity profiles. The blends between moves queued by appendMove()
+	 *  remain trapezoidal.
+	 */
+	void setJerkLimit(double jerk);
+	double getJerkLimit() const { return jpTrajectory.getJerkLimit(); }
 	/** idle() method Terminates the position controller (if active). 
 	 *
 	 * To prevent uncontrolled falling, you should ensure you have set gravityCompensate(true) before calling idle().
@@ -216,10 +277,11 @@ public:
 
 protected:
 	template<typename T> T currentPosHelper(const T& currentPos);
-	template<typename T> void moveToThread(const T& currentPos, const T& destination, double velocity, double acceleration, bool* started, boost::shared_future<boost::thread*> threadPtrFuture);
 
-	bool doneMoving;
-	boost::thread_group mtThreadGroup;
+	TrajectoryExecutor<jp_type>& trajectoryExecutorFor(const jp_type& /*unused*/) { return jpTrajectory; }
+	TrajectoryExecutor<cp_type>& trajectoryExecutorFor(const cp_type& /*unused*/) { return tpTrajectory; }
+	TrajectoryExecutor<Eigen::Quaterniond>& trajectoryExecutorFor(const Eigen::Quaterniond& /*unused*/) { return toTrajectory; }
+	TrajectoryExecutor<pose_type>& trajectoryExecutorFor(const pose_type& /*unused*/) { return poseTrajectory; }
 
 	// Used to calculate TP and TO if the values aren't already being calculated in the control loop.
 	mutable math::Kinematics<DOF> kin;
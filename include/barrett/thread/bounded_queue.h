@@ -0,0 +1,116 @@
+/*
+ * bounded_queue.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_THREAD_BOUNDED_QUEUE_H_
+#define BARRETT_THREAD_BOUNDED_QUEUE_H_
+
+
+#include <cstddef>
+
+#include <boost/static_assert.hpp>
+
+#include <barrett/detail/ca_macro.h>
+
+
+namespace barrett {
+namespace thread {
+
+
+// A fixed-capacity FIFO that any number of threads can push to and pop from
+// without locking or allocating. push() fails (rather than blocking) when the
+// queue is full, and pop() fails when it is empty. Capacity must be a power of
+// two. T should be trivially copyable.
+//
+// Each slot carries a sequence number that tells producers and consumers
+// whether it is free or full for the current lap around the ring.
+template<typename T, size_t Capacity>
+class BoundedQueue {
+	BOOST_STATIC_ASSERT(Capacity >= 2  &&  (Capacity & (Capacity - 1)) == 0);
+
+public:
+	BoundedQueue() : enqueuePos(0), dequeuePos(0) {
+		for (size_t i = 0; i < Capacity; ++i) {
+			cells[i].seq = i;
+		}
+	}
+
+	bool push(const T& value) {
+		Cell* cell;
+		size_t pos = enqueuePos;
+		while (true) {
+			cell = &cells[pos & MASK];
+			long dif = (long)cell->seq - (long)pos;
+			if (dif == 0) {
+				if (__sync_bool_compare_and_swap(&enqueuePos, pos, pos + 1)) {
+					break;
+				}
+				pos = enqueuePos;
+			} else if (dif < 0) {
+				return false;  // full
+			} else {
+				pos = enqueuePos;  // another producer got here first
+			}
+		}
+
+		cell->data = value;
+		__sync_synchronize();
+		cell->seq = pos + 1;
+		return true;
+	}
+
+	bool pop(T* value) {
+		Cell* cell;
+		size_t pos = dequeuePos;
+		while (true) {
+			cell = &cells[pos & MASK];
+			long dif = (long)cell->seq - (long)(pos + 1);
+			if (dif == 0) {
+				if (__sync_bool_compare_and_swap(&dequeuePos, pos, pos + 1)) {
+					break;
+				}
+				pos = dequeuePos;
+			} else if (dif < 0) {
+				return false;  // empty
+			} else {
+				pos = dequeuePos;
+			}
+		}
+
+		__sync_synchronize();
+		*value = cell->data;
+		__sync_synchronize();
+		cell->seq = pos + Capacity;
+		return true;
+	}
+
+	bool empty() const {
+		return cells[dequeuePos & MASK].seq != dequeuePos + 1;
+	}
+
+	static size_t capacity() { return Capacity; }
+
+protected:
+	static const size_t MASK = Capacity - 1;
+
+	struct Cell {
+		volatile size_t seq;
+		T data;
+	};
+
+	Cell cells[Capacity];
+	volatile size_t enqueuePos;
+	volatile size_t dequeuePos;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(BoundedQueue);
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_THREAD_BOUNDED_QUEUE_H_ */
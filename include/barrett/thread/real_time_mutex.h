@@ -9,6 +9,8 @@
 #define BARRETT_THREAD_REAL_TIME_MUTEX_H_
 
 
+#include <cstddef>
+
 #include <barrett/detail/ca_macro.h>
 #include <barrett/thread/abstract/mutex.h>
 
@@ -34,10 +36,52 @@ public:
 	virtual int fullUnlock();
 	virtual void relock(int lc);
 
+
+	/** Contention statistics for the code that acquires a RealTimeMutex.
+	 *
+	 * A lock site is identified by the return address of the call to lock(),
+	 * try_lock(), or relock(); resolve it with addr2line. (In optimized builds,
+	 * the call made by BARRETT_SCOPED_LOCK() is inlined into the enclosing
+	 * function.) Times are in seconds. Hold times are attributed to the site
+	 * that took the outermost lock.
+	 */
+	struct LockSiteStats {
+		const void* site;
+		unsigned long numLocks;
+		unsigned long numContended;
+		double totalWaitTime, maxWaitTime;
+		double totalHoldTime, maxHoldTime;
+	};
+	/// Locks from sites beyond this many aren't recorded, only counted (see getNumUntrackedLocks()).
+	static const size_t MAX_LOCK_SITES = 16;
+
+	/** Statistics are off by default. When on, each outermost acquisition costs
+	 * an extra try_lock() and two clock reads.
+	 */
+	void enableStatistics(bool enable = true);
+	bool statisticsEnabled() const { return collectStats; }
+	void resetStatistics();
+	size_t getNumLockSites() const { return numSites; }
+	const LockSiteStats& getLockSiteStats(size_t i) const { return sites[i]; }
+	/// Number of locks taken from sites that didn't fit in the table
+	unsigned long getNumUntrackedLocks() const { return numUntrackedLocks; }
+	void logStatistics(const char* name) const;
+
 protected:
+	LockSiteStats* findSite(const void* site);
+	void beginHold(const void* site, bool contended, double waitTime);
+	void endHold();
+
 	detail::mutex_impl* mutex;
 	int lockCount;
 
+	bool collectStats;
+	LockSiteStats sites[MAX_LOCK_SITES];
+	size_t numSites;
+	unsigned long numUntrackedLocks;
+	LockSiteStats* holdSite;
+	double holdStart;
+
 private:
 	DISALLOW_COPY_AND_ASSIGN(RealTimeMutex);
 };
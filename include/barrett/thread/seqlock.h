@@ -0,0 +1,66 @@
+/*
+ * seqlock.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_THREAD_SEQLOCK_H_
+#define BARRETT_THREAD_SEQLOCK_H_
+
+
+#include <barrett/detail/ca_macro.h>
+
+
+namespace barrett {
+namespace thread {
+
+
+// Publishes a copy of a T from one writer to any number of readers without
+// blocking the writer. Readers retry if they overlap with a write, so T should
+// be small and trivially copyable. Callers must serialize calls to write().
+template<typename T>
+class SeqLock {
+public:
+	SeqLock() : seq(0), data() {}
+	explicit SeqLock(const T& initialValue) : seq(0), data(initialValue) {}
+
+	void write(const T& value) {
+		++seq;  // odd: write in progress
+		__sync_synchronize();
+		data = value;
+		__sync_synchronize();
+		++seq;  // even: data is consistent
+	}
+
+	// Returns false (and leaves *value unspecified) if a write was in progress.
+	bool tryRead(T* value) const {
+		unsigned long s1 = seq;
+		__sync_synchronize();
+		*value = data;
+		__sync_synchronize();
+		return (s1 & 1) == 0  &&  s1 == seq;
+	}
+
+	T read() const {
+		T value;
+		while ( !tryRead(&value) ) {}
+		return value;
+	}
+
+	// Incremented by 2 for each call to write()
+	unsigned long getSequence() const { return seq; }
+
+protected:
+	volatile unsigned long seq;
+	T data;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(SeqLock);
+};
+
+
+}
+}
+
+
+#endif /* BARRETT_THREAD_SEQLOCK_H_ */
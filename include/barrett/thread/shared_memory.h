@@ -0,0 +1,135 @@
+/*
+ * shared_memory.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_THREAD_SHARED_MEMORY_H_
+#define BARRETT_THREAD_SHARED_MEMORY_H_
+
+
+#include <string>
+#include <cstring>
+#include <stdexcept>
+#include <new>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/os.h>
+#include <barrett/thread/seqlock.h>
+
+
+namespace barrett {
+namespace thread {
+
+
+// A named POSIX shared memory segment mapped into this process. If create is
+// true, a new segment is created with the given permissions, less the umask
+// (by default, only this user may open it), and removed again by the
+// destructor. Creating a segment that already exists fails unless replace is
+// true, in which case the existing segment (say, one left behind by a crashed
+// process) is discarded. If create is false, an existing segment of at least
+// size bytes is opened. Throws std::runtime_error on failure.
+class SharedMemory {
+public:
+	SharedMemory(const std::string& name, size_t size, bool create,
+			bool replace = false, mode_t mode = S_IRUSR | S_IWUSR);
+	~SharedMemory();
+
+	const std::string& getName() const { return name; }
+	size_t getSize() const { return size; }
+	bool isOwner() const { return owner; }
+	void* get() const { return addr; }
+
+protected:
+	std::string name;
+	size_t size;
+	bool owner;
+	void* addr;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(SharedMemory);
+};
+
+
+// Passes the most recent T between processes through a SeqLock in a
+// SharedMemory segment. One process creates the channel and others open it by
+// name. Any one of them may be the writer, but there must be only one:
+// StatePublisher writes to the channel it creates, while CommandSubscriber
+// reads from its channel and the process that opens it writes. Reads and
+// writes are plain memory accesses: no system calls and no locks, so the
+// writer is never blocked by readers. T must be trivially copyable, and all
+// processes must agree on its layout.
+template<typename T>
+class SharedMemoryChannel {
+public:
+	struct Sample {
+		double time;  ///< As given to write(); by default, the writer's highResolutionSystemTime()
+		T value;
+	};
+
+	// See SharedMemory for the meaning of create, replace, and mode.
+	SharedMemoryChannel(const std::string& name, bool create,
+			bool replace = false, mode_t mode = S_IRUSR | S_IWUSR) :
+		shm(name, sizeof(Segment), create, replace, mode),
+		segment(static_cast<Segment*>(shm.get()))
+	{
+		if (create) {
+			new (&segment->seqLock) SeqLock<Sample>();
+			segment->sampleSize = sizeof(Sample);
+			__sync_synchronize();
+			std::memcpy(segment->magic, MAGIC, sizeof(segment->magic));  // The segment is ready.
+		} else if (std::memcmp(segment->magic, MAGIC, sizeof(segment->magic)) != 0  ||
+				segment->sampleSize != sizeof(Sample)) {
+			(logMessage("SharedMemoryChannel::%s(): Shared memory segment \"%s\" is not a channel "
+					"of this type (or hasn't been initialized yet).")
+					% __func__ % name).template raise<std::runtime_error>();
+		}
+	}
+
+	const std::string& getName() const { return shm.getName(); }
+
+	void write(const T& value) { write(value, highResolutionSystemTime()); }
+	void write(const T& value, double time) {
+		Sample s;
+		s.time = time;
+		s.value = value;
+		segment->seqLock.write(s);
+	}
+
+	// Returns false if nothing has been written yet or if a write was in
+	// progress. Doesn't retry, so it is safe to call from the execution cycle.
+	bool tryRead(Sample* s) const {
+		return getSequence() != 0  &&  segment->seqLock.tryRead(s);
+	}
+
+	// Incremented by 2 for each call to write()
+	unsigned long getSequence() const { return segment->seqLock.getSequence(); }
+
+protected:
+	static const char MAGIC[8];
+
+	struct Segment {
+		char magic[8];
+		size_t sampleSize;
+		SeqLock<Sample> seqLock;
+	};
+
+	SharedMemory shm;
+	Segment* segment;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(SharedMemoryChannel);
+};
+
+template<typename T>
+const char SharedMemoryChannel<T>::MAGIC[8] = "BtShmCh";
+
+
+}
+}
+
+
+#endif /* BARRETT_THREAD_SHARED_MEMORY_H_ */
@@ -24,6 +24,20 @@ using namespace barrett;
 
 const std::string CAL_CONFIG_FILE = barrett::EtcPathRelative("autotension.conf");
 
+// Instead of waiting a fixed time for the WAM to stop moving, wait until the
+// joint velocities have stayed within SETTLE_VELOCITY (rad/s) for SETTLE_TIME
+// seconds. The old fixed waits are kept as timeouts.
+const double SETTLE_VELOCITY = 0.02;
+const double SETTLE_TIME = 0.25;
+// Tension is pulled for a fixed PULL_TIME. The motor creeps slowly as the
+// slack is taken up, and cutting the pull short would under-measure the slack.
+const double PULL_TIME = 5.0;
+// The tang solenoids' actuation isn't observable, so those waits stay fixed:
+// TANG_ACTUATION_TIME after energizing a solenoid, and ENGAGE_DELAY before each
+// attempt to engage a tang.
+const double TANG_ACTUATION_TIME = 2.0;
+const double ENGAGE_DELAY = 1.0;
+
 template<size_t DOF>
 std::vector<int> validate_args(int argc, char** argv) {
 	// Some DOF dependent items
@@ -358,7 +372,7 @@ std::vector<int> AutoTension<DOF>::tensionJoint(std::vector<int> joint_list) {
 			// Pull tension from J2
 			wam.moveTo(jpStart[1], 1.2, 0.75);
 			puck[1]->setProperty(Puck::TENSION, true);
-			btsleep(2.0);
+			btsleep(TANG_ACTUATION_TIME);
 			if (!engage(1)) {
 				puck[1]->setProperty(Puck::TENSION, false);
 				joint_list.resize(0);
@@ -366,7 +380,7 @@ std::vector<int> AutoTension<DOF>::tensionJoint(std::vector<int> joint_list) {
 				return joint_list;
 			} else
 				printf("Successfully engaged joint 2 autotensioner.\n");
-			btsleep(0.5);
+			wam.waitUntilSettled(SETTLE_VELOCITY, SETTLE_TIME, 0.5);
 			if (pullTension(1) < slackThreshold[1])
 				diff_tens = true;
 			puck[1]->setProperty(Puck::TENSION, false);
@@ -414,7 +428,7 @@ std::vector<int> AutoTension<DOF>::tensionJoint(std::vector<int> joint_list) {
 			}
 			printf("Successfully engaged joint 5 autotensioner.\n");
 			updateJ6(0.0, true);
-			btsleep(0.5);
+			wam.waitUntilSettled(SETTLE_VELOCITY, SETTLE_TIME, 0.5);
 			if (pullTension(4) < slackThreshold[4])
 				diff_tens = true;
 			puck[4]->setProperty(Puck::TENSION, false); // Release Tang
@@ -437,7 +451,7 @@ std::vector<int> AutoTension<DOF>::tensionJoint(std::vector<int> joint_list) {
 				return joint_list;
 			} else
 				printf("Successfully engaged joint 1 autotensioner.\n");
-			btsleep(0.5);
+			wam.waitUntilSettled(SETTLE_VELOCITY, SETTLE_TIME, 0.5);
 			j1SlackPulled = pullTension(0);
 			puck[0]->setProperty(Puck::TENSION, false);
 		}
@@ -445,11 +459,11 @@ std::vector<int> AutoTension<DOF>::tensionJoint(std::vector<int> joint_list) {
 		//Engage tang for specified motor
 		if (joint != 6)
 			puck[motor]->setProperty(Puck::TENSION, true);
-		btsleep(2.0);
+		btsleep(TANG_ACTUATION_TIME);
 
 		if (joint == 6) {
 			puck[4]->setProperty(Puck::TENSION, true);
-			btsleep(2.0);
+			btsleep(TANG_ACTUATION_TIME);
 			if (j5TangPos == 0.0) {
 				while (!engage(4, 10.0)) {
 					updateJ5(3.5);
@@ -482,13 +496,13 @@ std::vector<int> AutoTension<DOF>::tensionJoint(std::vector<int> joint_list) {
 			}
 			printf("Successfully engaged joint 6 autotensioner.\n");
 			updateJ5(0.0, true); // Reset J6 Start values
-			btsleep(0.5);
+			wam.waitUntilSettled(SETTLE_VELOCITY, SETTLE_TIME, 0.5);
 			motorSlackPulled = pullTension(5);
 			puck[4]->setProperty(Puck::TENSION, false); // Release Tang
 		} else if (engage(motor)) {
 			printf("Successfully engaged joint %d autotensioner.\n", joint);
 			fflush(stdout);
-			btsleep(0.5);
+			wam.waitUntilSettled(SETTLE_VELOCITY, SETTLE_TIME, 0.5);
 			//Pull Tension
 			motorSlackPulled = pullTension(motor);
 			puck[motor]->setProperty(Puck::TENSION, false);
@@ -551,7 +565,7 @@ std::vector<int> AutoTension<DOF>::tensionJoint(std::vector<int> joint_list) {
 
 template<size_t DOF>
 bool AutoTension<DOF>::engage(int motor, double timeout) {
-	btsleep(1.0); // Let system settle, tang engage
+	btsleep(ENGAGE_DELAY); // Let system settle, tang engage
 	holdJP.setValue(wam.getJointPositions()); // Hold Position
 	motorRamp.setSlope(0.8);
 	motorRamp.setOutput((j2mp * wam.getJointPositions())[motor]); //Set the ramp to the proper start position
@@ -582,11 +596,11 @@ double AutoTension<DOF>::pullTension(int motor) {
 	double start_pos = (j2mp * wam.getJointPositions())[motor]; // record our starting point
 	tensionValue.setValue(tensionDefaults[motor] - exposedGravity.getValue()[motor]); // set the torque - this will be the torque applied to pull tension subtracting the torque already being applied by the gravity compensator
 	systems::connect(tensionValue.output, mtCommand.getElementInput(motor)); // apply the torque
-	sleep(5.0); // wait a few seconds
+	btsleep(PULL_TIME); // wait until the slack has been taken up
 	double end_pos = (j2mp * wam.getJointPositions())[motor]; //record our ending point
 	tensionValue.setValue(0.0);
 	systems::disconnect(tensionValue.output); //stop applying the torque
-	btsleep(2.0);
+	wam.waitUntilSettled(SETTLE_VELOCITY, SETTLE_TIME, 2.0);
 
 	holdJP.setValue(wam.getJointPositions()); // Update setPoint to account for movement
 	printf("Slack taken up from motor %d  = %f radians\n", motor + 1, fabs(start_pos - end_pos));
@@ -35,13 +35,16 @@
 #include <syslog.h>
 #include <unistd.h>
 
+#include <vector>
+
 #include <curses.h>
-#include <gsl/gsl_blas.h>
-#include <gsl/gsl_linalg.h>
+#include <Eigen/StdVector>
 #include <boost/tuple/tuple.hpp>
+#include <boost/bind.hpp>
 
 #include <barrett/exception.h>
 #include <barrett/units.h>
+#include <barrett/math/gravity_calibrator.h>
 #include <barrett/systems.h>
 #include <barrett/products/product_manager.h>
 
@@ -101,10 +104,21 @@ bool validate_args(int argc, char** argv) {
 #define SLOW_ACCEL (0.05)
 #define NUM_POINTS (2000)
 #define CALC_LAMBDA (0.000001)
-int mu_n;
-/* Big arrays of joint torques and joint positions, for a given pose */
-double ** mu_jts; /*[NUM_DOFS][NUM_POINTS];*/
-double ** mu_jps; /*[NUM_DOFS][NUM_POINTS];*/
+/* The WAM is settled once the mean and the standard deviation of each joint
+ * velocity over the last SETTLE_TIME seconds are both within SETTLE_VEL. A
+ * one-count dither of the encoders doesn't prevent this. */
+#define SETTLE_VEL (0.01)
+#define SETTLE_TIME (0.5)
+/* If a pose hasn't been measured after this many seconds, it is measured
+ * whether or not the WAM has settled. */
+#define MEAS_TIMEOUT (20.0)
+
+/* Set by the main thread to start a measurement. Samples are only added to
+ * the calibrator while this is set and the measurement isn't yet complete, so
+ * the main thread may use the calibrator otherwise. */
+volatile bool measuring = false;
+/* Set by the main thread once MEAS_TIMEOUT has passed */
+volatile bool ignore_settling = false;
 
 int done;
 void sigint(int) {
@@ -112,77 +126,84 @@ void sigint(int) {
 }
 
 template <size_t DOF>
-int mu_callback(const boost::tuple<typename units::JointTorques<DOF>::type, typename units::JointPositions<DOF>::type>& t) {
-	size_t j;
-	/* Save the current joint torques for each joint */
-	if (mu_n < NUM_POINTS) {
-		for (j = 0; j < DOF; j++) {
-			mu_jts[j][mu_n] = boost::get<0>(t)[j];
-			mu_jps[j][mu_n] = boost::get<1>(t)[j];
+int mu_callback(math::GravityCalibrator<DOF>* gc,
+		const boost::tuple<typename units::JointTorques<DOF>::type,
+				typename units::JointPositions<DOF>::type, bool>& t) {
+	if (measuring  &&  gc->numSamples() < NUM_POINTS) {
+		if (boost::get<2>(t)  ||  ignore_settling) {
+			gc->addSample(boost::get<0>(t), boost::get<1>(t));
+		} else {
+			gc->resetMeasurement();  /* Not settled (yet, or any more) */
 		}
-		mu_n++;
 	}
 	return 0;
 }
 
-/* Do the averaving */
-int mu_stats(gsl_vector * torques, gsl_vector * positions) {
-	int n;
-	int j;
-	gsl_vector * torque_vars;
-	gsl_vector * position_vars;
-	int dof;
-
-	dof = torques->size;
-
-	torque_vars = gsl_vector_alloc(dof);
-	position_vars = gsl_vector_alloc(dof);
-
-	/* Zero the values */
-	gsl_vector_set_zero(torques);
-	gsl_vector_set_zero(positions);
-	gsl_vector_set_zero(torque_vars);
-	gsl_vector_set_zero(position_vars);
-
-	/* Calculate the average */
-	for (n = 0; n < NUM_POINTS; n++) {
-		for (j = 0; j < dof; j++) {
-			*(gsl_vector_ptr(torques, j)) += mu_jts[j][n];
-			*(gsl_vector_ptr(positions, j)) += mu_jps[j][n];
-		}
-	}
-	gsl_blas_dscal(1.0 / NUM_POINTS, torques);
-	gsl_blas_dscal(1.0 / NUM_POINTS, positions);
-
-	/* Calculate the variance */
-	for (n = 0; n < NUM_POINTS; n++) {
-		for (j = 0; j < dof; j++) {
-			*(gsl_vector_ptr(torque_vars, j)) +=
-					(mu_jts[j][n] - gsl_vector_get(torques, j)) *
-					(mu_jts[j][n] - gsl_vector_get(torques, j));
-			*(gsl_vector_ptr(position_vars, j)) +=
-					(mu_jps[j][n] - gsl_vector_get(positions, j)) *
-					(mu_jps[j][n] - gsl_vector_get(positions, j));
-		}
-	}
-	gsl_blas_dscal(1.0 / NUM_POINTS, torque_vars);
-	gsl_blas_dscal(1.0 / NUM_POINTS, position_vars);
+/* Print the statistics of a completed measurement */
+template <size_t DOF>
+void mu_stats(const math::GravityCalibrator<DOF>& gc) {
+	typename units::JointTorques<DOF>::type torque_vars = gc.getTorqueVariance();
+	typename units::JointPositions<DOF>::type position_vars = gc.getPositionVariance();
 
-	/* Print positions */
 	mvprintw(12, 0, "  Positions:");
 	mvprintw(13, 0, "  (std-dev):");
 	mvprintw(14, 0, "    Torques:");
 	mvprintw(15, 0, "  (std-dev):");
-	for (j = 0; j < dof; j++) {
-		mvprintw(12, 13 + 9 * j, "% 08.5f ", gsl_vector_get(positions, j));
-		mvprintw(13, 13 + 9 * j, "% 08.5f ", sqrt(gsl_vector_get(position_vars, j)));
-		mvprintw(14, 13 + 9 * j, "% 08.5f ", gsl_vector_get(torques, j));
-		mvprintw(15, 13 + 9 * j, "% 08.5f ", sqrt(gsl_vector_get(torque_vars, j)));
+	for (size_t j = 0; j < DOF; j++) {
+		mvprintw(12, 13 + 9 * j, "% 08.5f ", gc.getMeanPosition()[j]);
+		mvprintw(13, 13 + 9 * j, "% 08.5f ", sqrt(position_vars[j]));
+		mvprintw(14, 13 + 9 * j, "% 08.5f ", gc.getMeanTorque()[j]);
+		mvprintw(15, 13 + 9 * j, "% 08.5f ", sqrt(torque_vars[j]));
 	}
+}
 
-	gsl_vector_free(torque_vars);
-	gsl_vector_free(position_vars);
-	return 0;
+/* Start measuring at the current pose */
+template <size_t DOF>
+void mu_start(math::GravityCalibrator<DOF>* gc, double* meas_start) {
+	mvprintw(9, 3, "Waiting for the WAM to settle ...      ");
+	gc->resetMeasurement();
+	*meas_start = highResolutionSystemTime();
+	ignore_settling = false;
+	measuring = true;
+}
+
+/* Returns true once the measurement is complete */
+template <size_t DOF>
+bool mu_measure(const math::GravityCalibrator<DOF>& gc, double meas_start, int pose) {
+	if ( !ignore_settling  &&  highResolutionSystemTime() - meas_start > MEAS_TIMEOUT) {
+		syslog(LOG_ERR, "Pose %d: the WAM didn't settle within %.0f seconds. Measuring anyway.",
+				pose + 1, MEAS_TIMEOUT);
+		mvprintw(10, 3, "WARNING: The WAM didn't settle. Measuring anyway.");
+		ignore_settling = true;
+	}
+	if (gc.numSamples() > 0)
+		mvprintw(9, 3, "Measuring ...                          ");
+	if (gc.numSamples() < NUM_POINTS)
+		return false;
+
+	measuring = false;
+	mu_stats(gc);
+	return true;
+}
+
+/* Add the pose at which the torques were measured to the calibrator */
+template <size_t DOF>
+void mu_add_pose(math::GravityCalibrator<DOF>* gc, struct bt_kinematics * kin, struct bt_calgrav * grav,
+		const typename units::JointTorques<DOF>::type& torques,
+		const typename units::JointPositions<DOF>::type& positions) {
+	typename math::GravityCalibrator<DOF>::gravity_type g[DOF];
+	typename math::GravityCalibrator<DOF>::rotation_type rotToPrev[DOF];
+
+	bt_kinematics_eval(kin, positions.asGslType(), 0);
+	bt_calgrav_eval(grav, kin, 0); /* find g vectors */
+	for (size_t j = 0; j < DOF; j++) {
+		for (int r = 0; r < 3; r++) {
+			g[j][r] = gsl_vector_get(grav->g[j], r);
+			for (int c = 0; c < 3; c++)
+				rotToPrev[j](r, c) = gsl_matrix_get(kin->link[j]->rot_to_prev, r, c);
+		}
+	}
+	gc->addPose(torques, g, rotToPrev);
 }
 
 template<size_t DOF>
@@ -196,23 +217,20 @@ int wam_main(int argc, char** argv, ProductManager& pm, systems::Wam<DOF>& wam)
 	int n;
 
 	/* Stuff that's filled in once */
-	gsl_vector ** poses;
+	std::vector<jp_type, Eigen::aligned_allocator<jp_type> > poses;
 	int num_poses;
 	int pose;
 
 	/* Stuff that's used once for each pose in measure mode */
-	gsl_vector * angle_diff;
-	gsl_vector * moveto_vec;
-	gsl_vector * torques_top;
-	gsl_vector * positions_top;
-	gsl_vector * torques_bottom;
-	gsl_vector * positions_bottom;
-
-	/* For storing the results from measure mode, one vector per pose  */
-	gsl_vector ** torques;
-	gsl_vector ** positions;
-	/* For storing the results from computation mode, one vector per joint */
-	gsl_vector ** mus;
+	jp_type angle_diff(ANGLE_DIFF);
+	jt_type torques_top;
+	jp_type positions_top;
+
+	/* Accumulates measurements, then fits the mus */
+	math::GravityCalibrator<DOF> gc(CALC_LAMBDA);
+	double meas_start = 0.0;
+	struct bt_kinematics * kin;
+	struct bt_calgrav * grav;
 
 	/* Make a list of phases for each pose*/
 	enum PHASE {
@@ -270,10 +288,9 @@ int wam_main(int argc, char** argv, ProductManager& pm, systems::Wam<DOF>& wam)
 		}
 
 		num_poses = config_setting_length(poses_array);
-		poses = (gsl_vector **) malloc(num_poses * sizeof(gsl_vector *));
+		poses.resize(num_poses);
 		for (pose = 0; pose < num_poses; pose++) {
-			poses[pose] = gsl_vector_alloc(n);
-			err = bt_gsl_fill_vector_cfgarray(poses[pose],
+			err = bt_gsl_fill_vector_cfgarray(poses[pose].asGslType(),
 					config_setting_get_elem(poses_array, pose));
 			if (err) {
 				syslog(LOG_ERR, "Pose %d not formatted correctly.", pose);
@@ -287,41 +304,24 @@ int wam_main(int argc, char** argv, ProductManager& pm, systems::Wam<DOF>& wam)
 		config_destroy(&cfg);
 	}
 
-	/* Allocate the global variables */
-	mu_jts = (double **) malloc(n * sizeof(double *));
-	mu_jps = (double **) malloc(n * sizeof(double *));
-	for (j = 0; j < n; j++) {
-		mu_jts[j] = (double *) malloc(NUM_POINTS * sizeof(double));
-		mu_jps[j] = (double *) malloc(NUM_POINTS * sizeof(double));
-	}
-
-	mu_n = NUM_POINTS; /* So we're presently not collecting data */
-
-	/* Allocate some vectors */
-	angle_diff = gsl_vector_alloc(n);
-	gsl_vector_set_all(angle_diff, ANGLE_DIFF);
-	moveto_vec = gsl_vector_alloc(n);
-	torques_top = gsl_vector_alloc(n);
-	positions_top = gsl_vector_alloc(n);
-	torques_bottom = gsl_vector_alloc(n);
-	positions_bottom = gsl_vector_alloc(n);
-	torques = (gsl_vector **) malloc(num_poses * sizeof(gsl_vector *));
-	positions = (gsl_vector **) malloc(num_poses * sizeof(gsl_vector *));
-	for (pose = 0; pose < num_poses; pose++) {
-		torques[pose] = gsl_vector_alloc(n);
-		positions[pose] = gsl_vector_alloc(n);
-	}
-	mus = (gsl_vector **) malloc(n * sizeof(gsl_vector *));
-	for (j = 0; j < n; j++)
-		mus[j] = gsl_vector_alloc(3);
+	/* The kinematics and gravity vectors at each pose are needed for the fit */
+	libconfig::Setting& wamSetting = pm.getConfig().lookup(pm.getWamDefaultConfigPath());
+	bt_kinematics_create(&kin, wamSetting["kinematics"].getCSetting(), n);
+	bt_calgrav_create(&grav, wamSetting["gravity_compensation"].getCSetting(), n);
 
 	// Install callback
-	systems::TupleGrouper<jt_type, jp_type> tg;
-	systems::Callback<boost::tuple<jt_type, jp_type>, int> muCallback(mu_callback<DOF>);
+	systems::SettleDetector<jv_type> sd(
+			(size_t) ceil(SETTLE_TIME / pm.getExecutionManager()->getPeriod()),
+			jv_type(SETTLE_VEL), jv_type(SETTLE_VEL));
+	systems::TupleGrouper<jt_type, jp_type, bool> tg;
+	systems::Callback<boost::tuple<jt_type, jp_type, bool>, int> muCallback(
+			boost::bind(mu_callback<DOF>, &gc, _1));
 	pm.getExecutionManager()->startManaging(muCallback);  // Make sure mu_callback() is called every execution cycle
 
 	systems::connect(wam.jtSum.output, tg.template getInput<0>());
 	systems::connect(wam.jpOutput, tg.template getInput<1>());
+	systems::connect(wam.jvOutput, sd.input);
+	systems::connect(sd.output, tg.template getInput<2>());
 	systems::connect(tg.output, muCallback.input);
 
 	wam.jpController.setControlSignalLimit(jp_type()); // Disable torque saturation because gravity comp isn't on
@@ -367,11 +367,11 @@ int wam_main(int argc, char** argv, ProductManager& pm, systems::Wam<DOF>& wam)
 		switch (phase) {
 		case MU_P_START:
 			mvprintw(9, 3, "Moving to above position ...           ");
-			syslog(LOG_ERR, "Pose is: %s", bt_gsl_vector_sprintf(buf, poses[pose]));
-			gsl_blas_dcopy(poses[pose], moveto_vec);
-			gsl_blas_daxpy(1.0, angle_diff, moveto_vec);
-			syslog(LOG_ERR, "Moving to: %s", bt_gsl_vector_sprintf(buf, moveto_vec));
-			wam.moveTo(jp_type(moveto_vec), false);
+			move(10, 0);
+			clrtoeol();
+			syslog(LOG_ERR, "Pose is: %s", bt_gsl_vector_sprintf(buf, poses[pose].asGslType()));
+			syslog(LOG_ERR, "Moving to: %s", bt_gsl_vector_sprintf(buf, jp_type(poses[pose] + angle_diff).asGslType()));
+			wam.moveTo(jp_type(poses[pose] + angle_diff), false);
 
 			phase = (enum PHASE) ((int) phase + 1);
 			break;
@@ -385,24 +385,22 @@ int wam_main(int argc, char** argv, ProductManager& pm, systems::Wam<DOF>& wam)
 			}
 
 			mvprintw(9, 3, "Moving to position (from above) ...    ");
-			wam.moveTo(jp_type(poses[pose]), false, SLOW_VEL, SLOW_ACCEL);
+			wam.moveTo(poses[pose], false, SLOW_VEL, SLOW_ACCEL);
 
 			phase = (enum PHASE) ((int) phase + 1);
 		case MU_P_FROM_TOP:
 			if (!wam.moveIsDone())
 				break;
-			mvprintw(9, 3, "Starting a measurement ...             ");
-			mu_n = 0;
+			mu_start(&gc, &meas_start);
 			phase = (enum PHASE) ((int) phase + 1);
 			break;
 		case MU_P_MEAS_TOP:
-			if (mu_n < NUM_POINTS)
+			if (!mu_measure(gc, meas_start, pose))
 				break;
-			mu_stats(torques_top, positions_top);
+			torques_top = gc.getMeanTorque();
+			positions_top = gc.getMeanPosition();
 			mvprintw(9, 3, "Moving to below position ...           ");
-			gsl_blas_dcopy(poses[pose], moveto_vec);
-			gsl_blas_daxpy(-1.0, angle_diff, moveto_vec);
-			wam.moveTo(jp_type(moveto_vec), false);
+			wam.moveTo(jp_type(poses[pose] - angle_diff), false);
 
 			phase = (enum PHASE) ((int) phase + 1);
 			break;
@@ -410,31 +408,26 @@ int wam_main(int argc, char** argv, ProductManager& pm, systems::Wam<DOF>& wam)
 			if (!wam.moveIsDone())
 				break;
 			mvprintw(9, 3, "Moving to position (from below) ...    ");
-			wam.moveTo(jp_type(poses[pose]), false, SLOW_VEL, SLOW_ACCEL);
+			wam.moveTo(poses[pose], false, SLOW_VEL, SLOW_ACCEL);
 
 			phase = (enum PHASE) ((int) phase + 1);
 			break;
 		case MU_P_FROM_BOT:
 			if (!wam.moveIsDone())
 				break;
-			mvprintw(9, 3, "Starting a measurement ...             ");
-			mu_n = 0;
+			mu_start(&gc, &meas_start);
 			phase = (enum PHASE) ((int) phase + 1);
 			break;
 		case MU_P_MEAS_BOT:
-			if (mu_n < NUM_POINTS)
+			if (!mu_measure(gc, meas_start, pose))
 				break;
-			mu_stats(torques_bottom, positions_bottom);
 			phase = (enum PHASE) ((int) phase + 1);
 			break;
 		case MU_P_DONE:
-			/* Get the midpoint position and torque ... */
-			gsl_vector_set_zero(torques[pose]);
-			gsl_blas_daxpy(0.5, torques_top, torques[pose]);
-			gsl_blas_daxpy(0.5, torques_bottom, torques[pose]);
-			gsl_vector_set_zero(positions[pose]);
-			gsl_blas_daxpy(0.5, positions_top, positions[pose]);
-			gsl_blas_daxpy(0.5, positions_bottom, positions[pose]);
+			/* Use the midpoint position and torque */
+			mu_add_pose(&gc, kin, grav,
+					jt_type(0.5 * (torques_top + gc.getMeanTorque())),
+					jp_type(0.5 * (positions_top + gc.getMeanPosition())));
 			pose++;
 			phase = MU_P_START;
 			if (pose == num_poses)
@@ -442,6 +435,7 @@ int wam_main(int argc, char** argv, ProductManager& pm, systems::Wam<DOF>& wam)
 			break;
 		}
 	}
+	measuring = false;
 
 	/* Stop ncurses ... */
 	clear();
@@ -450,169 +444,19 @@ int wam_main(int argc, char** argv, ProductManager& pm, systems::Wam<DOF>& wam)
 		syslog(LOG_ERR, "%s:%d freopen(stdout) failed.", __FILE__, __LINE__);
 	}
 
-
-	/* Free unneeded variables */
-	for (j = 0; j < n; j++) {
-		free(mu_jts[j]);
-		free(mu_jps[j]);
-	}
-	free(mu_jts);
-	free(mu_jps);
-	gsl_vector_free(angle_diff);
-	gsl_vector_free(moveto_vec);
-	gsl_vector_free(torques_top);
-	gsl_vector_free(positions_top);
-	gsl_vector_free(torques_bottom);
-	gsl_vector_free(positions_bottom);
+	bt_calgrav_destroy(grav);
+	bt_kinematics_destroy(kin);
 
 
 	if (done == 1) {
-		struct bt_kinematics * kin;
-		struct bt_calgrav * grav;
+		typename math::GravityCalibrator<DOF>::mu_type mus[DOF];
+
+		printf(">>> Calibration completed!\n");
 
 		/* Here we have the "Iterative Algorithm"
 		 * described in the Chris Dellin document entitled
 		 * "Newton-Euler First-Moment Gravity Compensation" */
-
-		/* Here we have the matrix composed of L matrices (negative) */
-		gsl_matrix * nLL;
-
-		/* We have a GT matrix and a Y vector for each link */
-		gsl_matrix ** GT;
-		gsl_vector ** Y;
-
-		/* We have a solution vector P for each link */
-		gsl_vector ** P;
-
-		printf(">>> Calibration completed!\n");
-
-		/* Start calculating ...
-		 * We have vectors of torque and position
-		 * in torques[] and positions[] */
-
-		libconfig::Setting& wamSetting = pm.getConfig().lookup(pm.getWamDefaultConfigPath());
-		bt_kinematics_create(&kin, wamSetting["kinematics"].getCSetting(), n);
-		bt_calgrav_create(&grav, wamSetting["gravity_compensation"].getCSetting(), n);
-
-		/* Make the nLL matrix */
-		nLL = gsl_matrix_calloc(3 * num_poses, 3 + 2 * num_poses);
-		for (pose = 0; pose < num_poses; pose++) {
-			gsl_matrix_set(nLL, 3 * pose + 0, 3 + 2 * pose + 0, -1.0);
-			gsl_matrix_set(nLL, 3 * pose + 1, 3 + 2 * pose + 1, -1.0);
-		}
-
-		/* Make each link's GT matrix */
-		/* Make each link's Y torque solution matrix */
-		Y = (gsl_vector **) malloc(n * sizeof(gsl_vector *));
-		GT = (gsl_matrix **) malloc(n * sizeof(gsl_matrix *));
-		for (j = 0; j < n; j++) {
-			Y[j] = gsl_vector_alloc(3 * num_poses);
-			GT[j] = gsl_matrix_calloc(3 * num_poses, 3 + 2 * num_poses);
-		}
-
-		for (pose = 0; pose < num_poses; pose++) {
-			/* Put the robot in the pose (by position) */
-			bt_kinematics_eval(kin, positions[pose], 0);
-			bt_calgrav_eval(grav, kin, 0); /* find g vectors */
-			for (j = 0; j < n; j++) {
-				/* GT: Gravity skew matrix */
-				gsl_matrix_set(GT[j], 3 * pose + 0, 1, -gsl_vector_get(grav->g[j], 2));
-				gsl_matrix_set(GT[j], 3 * pose + 0, 2, gsl_vector_get(grav->g[j], 1));
-				gsl_matrix_set(GT[j], 3 * pose + 1, 0, gsl_vector_get(grav->g[j], 2));
-				gsl_matrix_set(GT[j], 3 * pose + 1, 2, -gsl_vector_get(grav->g[j], 0));
-				gsl_matrix_set(GT[j], 3 * pose + 2, 0, -gsl_vector_get(grav->g[j], 1));
-				gsl_matrix_set(GT[j], 3 * pose + 2, 1, gsl_vector_get(grav->g[j], 0));
-				/* GT: -R*L */
-				gsl_matrix_set(GT[j], 3 * pose + 0, 3 + 2 * pose + 0, -gsl_matrix_get(kin->link[j]->rot_to_prev, 0, 0));
-				gsl_matrix_set(GT[j], 3 * pose + 0, 3 + 2 * pose + 1, -gsl_matrix_get(kin->link[j]->rot_to_prev, 1, 0));
-				gsl_matrix_set(GT[j], 3 * pose + 1, 3 + 2 * pose + 0, -gsl_matrix_get(kin->link[j]->rot_to_prev, 0, 1));
-				gsl_matrix_set(GT[j], 3 * pose + 1, 3 + 2 * pose + 1, -gsl_matrix_get(kin->link[j]->rot_to_prev, 1, 1));
-				gsl_matrix_set(GT[j], 3 * pose + 2, 3 + 2 * pose + 0, -gsl_matrix_get(kin->link[j]->rot_to_prev, 0, 2));
-				gsl_matrix_set(GT[j], 3 * pose + 2, 3 + 2 * pose + 1, -gsl_matrix_get(kin->link[j]->rot_to_prev, 1, 2));
-				/* Y */
-				gsl_vector_set(Y[j], 3 * pose + 0,
-						gsl_vector_get(torques[pose], j) * gsl_matrix_get(kin->link[j]->rot_to_prev, 2, 0));
-				gsl_vector_set(Y[j], 3 * pose + 1,
-						gsl_vector_get(torques[pose], j) * gsl_matrix_get(kin->link[j]->rot_to_prev, 2, 1));
-				gsl_vector_set(Y[j], 3 * pose + 2,
-						gsl_vector_get(torques[pose], j) * gsl_matrix_get(kin->link[j]->rot_to_prev, 2, 2));
-				if (j < n - 1)
-					gsl_vector_set(Y[j], 3 * pose + 2,
-							gsl_vector_get(Y[j], 3 * pose + 2) - gsl_vector_get(torques[pose], j + 1));
-			}
-		}
-
-		/* Make a space for each link's P solution vector */
-		P = (gsl_vector **) malloc(n * sizeof(gsl_vector *));
-		for (j = 0; j < n; j++)
-			P[j] = gsl_vector_alloc(3 + 2 * num_poses);
-
-		/* Do the regression for each link */
-		{
-			int i;
-			gsl_vector * b;
-			gsl_matrix * m2x2;
-			gsl_matrix * m2x2inverse;
-			gsl_matrix * m2x3;
-			gsl_permutation * permutation;
-
-			b = gsl_vector_alloc(3 * num_poses);
-			m2x2 = gsl_matrix_alloc(3 + 2 * num_poses, 3 + 2 * num_poses);
-			m2x2inverse = gsl_matrix_alloc(3 + 2 * num_poses, 3 + 2 * num_poses);
-			permutation = gsl_permutation_alloc(3 + 2 * num_poses);
-			m2x3 = gsl_matrix_alloc(3 + 2 * num_poses, 3 * num_poses);
-
-			for (j = n - 1; j >= 0; j--) {
-				int signum; /* For the inverse */
-
-				/* b = Y - nLL P(j+1) */
-				gsl_blas_dcopy(Y[j], b);
-				if (j < n - 1)
-					gsl_blas_dgemv(CblasNoTrans, 1.0, nLL, P[j + 1], 1.0, b);
-
-				/* m2x2 = GT[j]' * GT[j] */
-				gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, GT[j], GT[j], 0.0, m2x2);
-
-				/* Increment the diagonal of m2x2 by CALC_LAMBDA */
-				for (i = 0; i < 3 + 2 * num_poses; i++)
-					*(gsl_matrix_ptr(m2x2, i, i)) += CALC_LAMBDA;
-
-				/* Calculate the inverse of m2x2 */
-				gsl_linalg_LU_decomp(m2x2, permutation, &signum);
-				gsl_linalg_LU_invert(m2x2, permutation, m2x2inverse);
-
-				/* m2x3 = m2x2inverse * GT[j]' */
-				gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, m2x2inverse, GT[j], 0.0, m2x3);
-
-				/* P[j] = m2x3 * b */
-				gsl_blas_dgemv(CblasNoTrans, 1.0, m2x3, b, 0.0, P[j]);
-			}
-
-			gsl_vector_free(b);
-			gsl_matrix_free(m2x2);
-			gsl_matrix_free(m2x2inverse);
-			gsl_permutation_free(permutation);
-			gsl_matrix_free(m2x3);
-
-			/* Copy the results */
-			for (j = 0; j < n; j++) {
-				gsl_vector_set(mus[j], 0, gsl_vector_get(P[j], 0));
-				gsl_vector_set(mus[j], 1, gsl_vector_get(P[j], 1));
-				gsl_vector_set(mus[j], 2, gsl_vector_get(P[j], 2));
-			}
-
-			/* Clean up */
-			gsl_matrix_free(nLL);
-			for (j = 0; j < n; j++) {
-				gsl_matrix_free(GT[j]);
-				gsl_vector_free(Y[j]);
-				gsl_vector_free(P[j]);
-			}
-			free(GT);
-			free(Y);
-			free(P);
-		}
-
+		gc.solve(mus);
 
 		char* dataConfigFile = new char[strlen(DATA_CONFIG_FILE.c_str()) + strlen(pm.getWamDefaultConfigPath()) - 2 + 1];
 		sprintf(dataConfigFile, DATA_CONFIG_FILE.c_str(), pm.getWamDefaultConfigPath());
@@ -625,9 +469,9 @@ int wam_main(int argc, char** argv, ProductManager& pm, systems::Wam<DOF>& wam)
 				.add("mus", libconfig::Setting::TypeList);
 		for (size_t i = 0; i < DOF; ++i) {
 			libconfig::Setting& rowSetting = musSetting.add(libconfig::Setting::TypeList);
-			rowSetting.add(libconfig::Setting::TypeFloat) = gsl_vector_get(mus[i], 0);
-			rowSetting.add(libconfig::Setting::TypeFloat) = gsl_vector_get(mus[i], 1);
-			rowSetting.add(libconfig::Setting::TypeFloat) = gsl_vector_get(mus[i], 2);
+			rowSetting.add(libconfig::Setting::TypeFloat) = mus[i][0];
+			rowSetting.add(libconfig::Setting::TypeFloat) = mus[i][1];
+			rowSetting.add(libconfig::Setting::TypeFloat) = mus[i][2];
 		}
 
 		dataConfig.writeFile(dataConfigFile);
@@ -649,16 +493,5 @@ int wam_main(int argc, char** argv, ProductManager& pm, systems::Wam<DOF>& wam)
 	wam.moveHome();
 	pm.getSafetyModule()->waitForMode(SafetyModule::IDLE);
 
-	/* Free the variables */
-	for (pose = 0; pose < num_poses; pose++) {
-		gsl_vector_free(torques[pose]);
-		gsl_vector_free(positions[pose]);
-	}
-	free(torques);
-	free(positions);
-	for (j = 0; j < n; j++)
-		gsl_vector_free(mus[j]);
-	free(mus);
-
 	return 0;
 }
@@ -60,6 +60,13 @@ using detail::waitForEnter;
 const std::string CAL_CONFIG_FILE = barrett::EtcPathRelative("calibration.conf");
 const std::string DATA_CONFIG_FILE = barrett::EtcPathRelative("calibration_data/%s/zerocal.conf");
 
+// The zero position is recorded once the joint velocities have stayed within
+// SETTLE_VELOCITY (rad/s) for SETTLE_TIME seconds, so the reading isn't taken
+// while the WAM is still ringing from the last adjustment.
+const double SETTLE_VELOCITY = 0.01;
+const double SETTLE_TIME = 0.25;
+const double SETTLE_TIMEOUT = 2.0;
+
 
 // Convenience class that wraps ncurses text attributes.
 class ScopedAttr {
@@ -161,7 +168,7 @@ public:
 		CalibrationStep("Joint " + boost::lexical_cast<std::string>((int)setting[0])),
 		j((int)setting[0] - 1), calPos(setting[1]), endCondition(setting[2].c_str()),
 		wam(*wamPtr), calOffset(*calOffsetPtr), zeroPos(*zeroPosPtr), zeroAngle(*zeroAnglePtr),
-		state(0), digit(DEFAULT_DIGIT)
+		state(0), digit(DEFAULT_DIGIT), notSettled(false)
 	{
 		assert(j >= 0);
 		assert(j < DOF);
@@ -178,6 +185,7 @@ public:
 			// Reset
 			state = 0;
 			digit = DEFAULT_DIGIT;
+			notSettled = false;
 		}
 	}
 
@@ -198,6 +206,7 @@ public:
 
 		// Adjust the offset
 		default:
+			notSettled = false;
 			switch (k) {
 			case K_LEFT:
 				digit = std::min(MAX_DIGIT, digit+1);
@@ -216,7 +225,7 @@ public:
 				break;
 
 			case K_ENTER:
-				if (wam.moveIsDone()) {
+				if (wam.moveIsDone()  &&  wam.waitUntilSettled(SETTLE_VELOCITY, SETTLE_TIME, SETTLE_TIMEOUT)) {
 					LowLevelWam<DOF>& llw = wam.getLowLevelWam();
 
 					// Record actual joint position, not commanded joint position
@@ -240,6 +249,7 @@ public:
 
 					return false;  // Move on to the next joint!
 				}
+				notSettled = true;
 				break;
 
 			default:
@@ -292,6 +302,9 @@ public:
 
 				line += 2;
 				mvprintw(line++,left, "Press [Enter] once %s.", endCondition.c_str());
+				if (notSettled) {
+					mvprintw(line++,left, "The WAM is still moving. Press [Enter] again once it has stopped.");
+				}
 				break;
 			}
 		}
@@ -317,6 +330,7 @@ protected:
 	v_type& zeroAngle;
 
 	int state, digit;
+	bool notSettled;  // The last [Enter] was ignored because the WAM was moving
 };
 
 // The Exit menu item.
@@ -0,0 +1,73 @@
+/*
+ * profile_benchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+// Compares math::SCurveProfile to math::TrapezoidalVelocityProfile: move
+// durations at equal peak jerk, and the cost of eval(). Doesn't need a WAM.
+//
+// A trapezoidal profile changes its acceleration by at least a within a single
+// control cycle, so its peak jerk at the control rate is at least a/T_s. For
+// the same peak jerk, its acceleration must be limited to j*T_s.
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <barrett/os.h>
+#include <barrett/math/s_curve_profile.h>
+#include <barrett/math/trapezoidal_velocity_profile.h>
+
+
+using namespace barrett;
+
+
+template<typename Profile>
+double evalCost(const Profile& p, int numSamples) {
+	double sum = 0.0;
+	double dt = p.finalT() / numSamples;
+
+	double start = highResolutionSystemTime();
+	for (int i = 0; i < numSamples; ++i) {
+		sum += p.eval(i * dt);
+	}
+	double elapsed = highResolutionSystemTime() - start;
+
+	// Use the result so the loop isn't optimized away.
+	if (sum < 0.0) {
+		printf("%g\n", sum);
+	}
+	return elapsed / numSamples;
+}
+
+int main(int argc, char** argv) {
+	double v = 0.5, a = 0.5, j = 5.0, T_s = 0.002;
+	if (argc >= 4) {
+		v = atof(argv[1]);
+		a = atof(argv[2]);
+		j = atof(argv[3]);
+	}
+	if (argc >= 5) {
+		T_s = atof(argv[4]);
+	}
+	const double a_eq = j * T_s;
+
+	printf("v = %g, a = %g, j = %g, T_s = %g\n", v, a, j, T_s);
+	printf("Move duration (s)\n");
+	printf("%10s %14s %14s %18s\n", "length", "S-curve", "trapezoid", "trapezoid, equal j");
+	for (double l = 0.01; l < 5.0; l *= 2.0) {
+		math::SCurveProfile s(v, a, j, l);
+		math::TrapezoidalVelocityProfile t(v, a, 0.0, l);
+		math::TrapezoidalVelocityProfile tj(v, a_eq, 0.0, l);
+		printf("%10.3f %14.4f %14.4f %18.4f\n", l, s.finalT(), t.finalT(), tj.finalT());
+	}
+
+	const int numSamples = 1000000;
+	math::SCurveProfile s(v, a, j, 1.0);
+	math::TrapezoidalVelocityProfile t(v, a, 0.0, 1.0);
+	printf("\neval() cost (ns/sample)\n");
+	printf("  S-curve:   %.1f\n", evalCost(s, numSamples) * 1e9);
+	printf("  trapezoid: %.1f\n", evalCost(t, numSamples) * 1e9);
+
+	return 0;
+}
@@ -0,0 +1,45 @@
+/*
+ * csv_to_traj.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cstdio>
+#include <string>
+#include <stdexcept>
+
+#include <barrett/log.h>
+
+using namespace barrett;
+
+
+int main(int argc, char** argv) {
+	if (argc < 2 || argc > 3) {
+		printf("Usage: %s <path/to/trajectory.csv> [<path/to/trajectory.traj>]\n", argv[0]);
+		return 1;
+	}
+
+	std::string outName;
+	if (argc == 3) {
+		outName = argv[2];
+	} else {
+		outName = argv[1];
+		size_t dot = outName.rfind(".csv");
+		if (dot != std::string::npos && dot == outName.size() - 4)
+			outName.erase(dot);
+		outName += ".traj";
+	}
+
+	try {
+		log::TrajectoryFile::convertCSV(argv[1], outName.c_str());
+		log::TrajectoryFile tf(outName.c_str());
+		printf("Converted %zu samples of %s data to: %s\n", tf.numRecords(),
+				tf.getSampleType() == log::TrajectoryFile::POSE ? "pose_type" : "jp_type",
+				outName.c_str());
+	} catch (std::runtime_error& e) {
+		printf("ERROR: %s\n", e.what());
+		return 1;
+	}
+
+	return 0;
+}
@@ -6,18 +6,19 @@
  */
 
 #include <string>
+#include <algorithm>
 #include <boost/tuple/tuple.hpp>
 #include <boost/ref.hpp>
 #include <boost/bind.hpp>
 #include <boost/thread.hpp>
 #include <boost/filesystem.hpp>
-#include <boost/lexical_cast.hpp>
-#include <boost/tokenizer.hpp>
 #include <libconfig.h++>
 #include <Eigen/Core>
 
 #include <barrett/exception.h>
 #include <barrett/units.h>
+#include <barrett/log.h>
+#include <barrett/math/trajectory_simplifier.h>
 #include <barrett/systems.h>
 #include <barrett/products/product_manager.h>
 #define BARRETT_SMF_VALIDATE_ARGS
@@ -35,6 +36,12 @@ enum STATE {
 char* ctrlMode = NULL;
 bool vcMode = false;
 
+// Recordings have a sample every control cycle, but the splines only need
+// enough knots to stay within these tolerances of the recording.
+const double JP_TOLERANCE = 1e-3;  // rad
+const double CP_TOLERANCE = 5e-4;  // m
+const double Q_TOLERANCE = 1e-3;  // rad
+
 bool validate_args(int argc, char** argv) {
 	switch (argc) {
 	case 2:
@@ -102,9 +109,9 @@ protected:
 	math::Spline<jp_type>* jpSpline;
 	math::Spline<cp_type>* cpSpline;
 	math::Spline<Eigen::Quaterniond>* qSpline;
-	systems::Callback<double, jp_type>* jpTrajectory;
-	systems::Callback<double, cp_type>* cpTrajectory;
-	systems::Callback<double, Eigen::Quaterniond>* qTrajectory;
+	systems::SetpointTable<jp_type>* jpTrajectory;
+	systems::SetpointTable<cp_type>* cpTrajectory;
+	systems::SetpointTable<Eigen::Quaterniond>* qTrajectory;
 	systems::TupleGrouper<cp_type, Eigen::Quaterniond> poseTg;
 	systems::Ramp time;
 
@@ -164,100 +171,75 @@ bool Play<DOF>::init() {
 	cms = new ControlModeSwitcher<DOF>(pm, wam,
 			setting["control_mode_switcher"]);
 
-	//Create stream from input file
-	std::ifstream fs(playName.c_str());
-	std::string line;
-
-	// Check to see the data type specified on the first line (jp_type or pose_type)
-	// this will inform us if we are tracking 4DOF WAM Joint Angles, 7DOF WAM Joint Angles, or WAM Poses
-	std::getline(fs, line);
-	// Using a boost tokenizer to parse the data of the file into our vector.
-	boost::char_separator<char> sep(",");
-	typedef boost::tokenizer<boost::char_separator<char> > t_tokenizer;
-	t_tokenizer tok(line, sep);
-	if (strcmp(line.c_str(), "pose_type") == 0) {
-		// Create our spline and trajectory if the first line of the parsed file informs us of a pose_type
-		inputType = 1;
-		cpVec = new std::vector<input_cp_type,
-				Eigen::aligned_allocator<input_cp_type> >();
-		qVec = new std::vector<input_quat_type,
-				Eigen::aligned_allocator<input_quat_type> >();
-
-		float fLine[8];
-		input_cp_type cpSamp;
-		input_quat_type qSamp;
-		while (true) {
-			std::getline(fs, line);
-			if (!fs.good())
-				break;
-			t_tokenizer tok(line, sep);
-			int j = 0;
-			for (t_tokenizer::iterator beg = tok.begin(); beg != tok.end();
-					++beg) {
-				fLine[j] = boost::lexical_cast<float>(*beg);
-				j++;
+	// Recordings made by teach are trajectory files. Older recordings are CSV
+	// files, which are converted to a temporary trajectory file first.
+	std::string trajName(playName);
+	char tmpFile[] = "/tmp/btXXXXXX";
+	bool converted = false;
+	try {
+		if (!log::TrajectoryFile::isTrajectoryFile(playName.c_str())) {
+			if (mkstemp(tmpFile) == -1) {
+				printf("EXITING: Couldn't create temporary file!\n");
+				return false;
 			}
-			boost::get<0>(cpSamp) = fLine[0];
-			boost::get<0>(qSamp) = boost::get<0>(cpSamp);
-
-			boost::get<1>(cpSamp) << fLine[1], fLine[2], fLine[3];
-			boost::get<1>(qSamp) = Eigen::Quaterniond(fLine[4], fLine[5],
-					fLine[6], fLine[7]);
-			boost::get<1>(qSamp).normalize();
-			cpVec->push_back(cpSamp);
-			qVec->push_back(qSamp);
+			converted = true;
+			log::TrajectoryFile::convertCSV(playName.c_str(), tmpFile);
+			trajName = tmpFile;
 		}
-		// Make sure the vectors created are the same size
-		assert(cpVec->size() == qVec->size());
-		// Create our splines between points
-		cpSpline = new math::Spline<cp_type>(*cpVec);
-		qSpline = new math::Spline<Eigen::Quaterniond>(*qVec);
-		// Create trajectories from the splines
-		cpTrajectory = new systems::Callback<double, cp_type>(
-				boost::ref(*cpSpline));
-		qTrajectory = new systems::Callback<double, Eigen::Quaterniond>(
-				boost::ref(*qSpline));
-	} else if (strcmp(line.c_str(), "jp_type") == 0) {
-		// Create our spline and trajectory if the first line of the parsed file informs us of a jp_type
-		std::vector<input_jp_type, Eigen::aligned_allocator<input_jp_type> > jp_vec;
-		float fLine[DOF + 1];
-		input_jp_type samp;
-		while (true) {
-			std::getline(fs, line);
-			if (!fs.good())
-				break;
-			t_tokenizer tok(line, sep);
-			int j = 0;
-			for (t_tokenizer::iterator beg = tok.begin(); beg != tok.end();
-					++beg) {
-				fLine[j] = boost::lexical_cast<float>(*beg);
-				j++;
+
+		log::TrajectoryFile tf(trajName.c_str());
+		const double period = pm.getExecutionManager()->getPeriod();
+		const size_t renderThreads = std::max(1u,
+				boost::thread::hardware_concurrency());
+		if (tf.getSampleType() == log::TrajectoryFile::POSE) {
+			// Create our spline and trajectory if the file contains poses
+			inputType = 1;
+			std::vector<input_cp_type, Eigen::aligned_allocator<input_cp_type> > cpSamples;
+			std::vector<input_quat_type, Eigen::aligned_allocator<input_quat_type> > qSamples;
+			tf.getPoses(&cpSamples, &qSamples);
+			for (size_t i = 0; i < qSamples.size(); ++i) {
+				boost::get<1>(qSamples[i]).normalize();
 			}
-			boost::get<0>(samp) = fLine[0];
-			// To handle the different WAM configurations
-			if (j == 4)
-				boost::get<1>(samp) << fLine[1], fLine[2], fLine[3];
-			else if (j == 5)
-				boost::get<1>(samp) << fLine[1], fLine[2], fLine[3], fLine[4];
-			else if (j == 8)
-				boost::get<1>(samp) << fLine[1], fLine[2], fLine[3], fLine[4], fLine[5], fLine[6], fLine[7];
-			jp_vec.push_back(samp);
+			cpVec = new std::vector<input_cp_type,
+					Eigen::aligned_allocator<input_cp_type> >();
+			qVec = new std::vector<input_quat_type,
+					Eigen::aligned_allocator<input_quat_type> >();
+			math::simplifyTrajectory(cpSamples, qSamples, CP_TOLERANCE,
+					Q_TOLERANCE, cpVec, qVec);
+			printf("Simplified %zu samples to %zu knots\n", cpSamples.size(),
+					cpVec->size());
+			// Create our splines between points
+			cpSpline = new math::Spline<cp_type>(*cpVec);
+			qSpline = new math::Spline<Eigen::Quaterniond>(*qVec);
+			// Pre-render a setpoint for every control cycle
+			cpTrajectory = new systems::SetpointTable<cp_type>(*cpSpline,
+					period, renderThreads);
+			qTrajectory = new systems::SetpointTable<Eigen::Quaterniond>(
+					*qSpline, period, renderThreads);
+		} else {
+			// Create our spline and trajectory if the file contains joint positions
+			std::vector<input_jp_type, Eigen::aligned_allocator<input_jp_type> > jp_samples, jp_vec;
+			tf.getJointPositions(&jp_samples);
+			math::simplifyTrajectory(jp_samples, JP_TOLERANCE, &jp_vec);
+			printf("Simplified %zu samples to %zu knots\n", jp_samples.size(),
+					jp_vec.size());
+			// Create our splines between points
+			jpSpline = new math::Spline<jp_type>(jp_vec);
+			// Pre-render a setpoint for every control cycle
+			jpTrajectory = new systems::SetpointTable<jp_type>(*jpSpline,
+					period, renderThreads);
 		}
-		// Create our splines between points
-		jpSpline = new math::Spline<jp_type>(jp_vec);
-		// Create our trajectory
-		jpTrajectory = new systems::Callback<double, jp_type>(
-				boost::ref(*jpSpline));
-	} else {
-		// The first line does not contain "jp_type or pose_type" return false and exit.
-		printf(
-				"EXITING: First line of file must specify jp_type or pose_type data.");
+	} catch (std::exception& e) {
+		// The file is malformed or was recorded on a different WAM configuration.
+		printf("EXITING: %s\n", e.what());
+		if (converted)
+			remove(tmpFile);
 		btsleep(1.5);
 		return false;
 	}
+	if (converted)
+		remove(tmpFile);
 
-	//Close the file
-	fs.close();
 	printf("\nFile Contains data in the form of: %s\n\n",
 			inputType == 0 ? "jp_type" : "pose_type");
 
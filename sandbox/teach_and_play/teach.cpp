@@ -79,8 +79,7 @@ class Teach {
 protected:
 	systems::Wam<DOF>& wam;
 	ProductManager& pm;
-	std::string tmpStr, saveName, fileOut;
-	char* tmpFile;
+	std::string saveName, fileOut;
 	struct LateInitializedDataMembers;
 	LateInitializedDataMembers* d;
 	int dLine, dX, dY, key;
@@ -91,12 +90,12 @@ protected:
 	systems::TupleGrouper<double, pose_type> poseLogTg;
 	typedef boost::tuple<double, jp_type> jp_sample_type;
 	typedef boost::tuple<double, pose_type> pose_sample_type;
-	systems::PeriodicDataLogger<jp_sample_type>* jpLogger;
-	systems::PeriodicDataLogger<pose_sample_type>* poseLogger;
+	systems::PeriodicDataLogger<jp_sample_type, log::TrajectoryWriter<jp_sample_type> >* jpLogger;
+	systems::PeriodicDataLogger<pose_sample_type, log::TrajectoryWriter<pose_sample_type> >* poseLogger;
 
 public:
 	Teach(systems::Wam<DOF>& wam_, ProductManager& pm_, std::string filename_) :
-			wam(wam_), pm(pm_), tmpStr("/tmp/btXXXXXX"), saveName(filename_), dLine(
+			wam(wam_), pm(pm_), saveName(filename_), dLine(
 					0), dX(0), dY(0), key(0), initCurses(true), displaying(
 					true), time(NULL) {
 	}
@@ -104,7 +103,6 @@ public:
 	init();
 
 	~Teach() {
-		delete[] tmpFile;
 	}
 
 	void
@@ -118,12 +116,9 @@ public:
 
 template<size_t DOF>
 bool Teach<DOF>::init() {
-	tmpFile = new char[tmpStr.length() + 1];
-	strcpy(tmpFile, tmpStr.c_str());
-	if (mkstemp(tmpFile) == -1) {
-		printf("ERROR: Couldn't create temporary file!\n");
-		return false;
-	}
+	// Samples are written straight to a trajectory file that play can load
+	// without any conversion.
+	fileOut = "recorded/" + saveName + ".traj";
 
 	pm.getSafetyModule()->setVelocityLimit(1.5);
 	pm.getSafetyModule()->setTorqueLimit(3.0);
@@ -133,14 +128,16 @@ bool Teach<DOF>::init() {
 	pm.getExecutionManager()->startManaging(time); //starting time manager
 
 	if (recordType == 0)
-		jpLogger = new systems::PeriodicDataLogger<jp_sample_type>(
+		jpLogger = new systems::PeriodicDataLogger<jp_sample_type,
+				log::TrajectoryWriter<jp_sample_type> >(
 				pm.getExecutionManager(),
-				new barrett::log::RealTimeWriter<jp_sample_type>(tmpFile,
+				new barrett::log::TrajectoryWriter<jp_sample_type>(fileOut.c_str(),
 						pm.getExecutionManager()->getPeriod()), 1);
 	else
-		poseLogger = new systems::PeriodicDataLogger<pose_sample_type>(
+		poseLogger = new systems::PeriodicDataLogger<pose_sample_type,
+				log::TrajectoryWriter<pose_sample_type> >(
 				pm.getExecutionManager(),
-				new barrett::log::RealTimeWriter<pose_sample_type>(tmpFile,
+				new barrett::log::TrajectoryWriter<pose_sample_type>(fileOut.c_str(),
 						pm.getExecutionManager()->getPeriod()), 1);
 	return true;
 }
@@ -207,32 +204,14 @@ void Teach<DOF>::display() {
 
 template<size_t DOF>
 void Teach<DOF>::createSpline() {
-	saveName = "recorded/" + saveName;
 	if (recordType == 0) {
 		jpLogger->closeLog();
 		disconnect(jpLogger->input);
-		// Build spline between recorded points
-		log::Reader<jp_sample_type> lr(tmpFile);
-		lr.exportCSV(saveName.c_str());
 	}
 	else{
 		poseLogger->closeLog();
 		disconnect(poseLogger->input);
-		log::Reader<pose_sample_type> pr(tmpFile);
-		pr.exportCSV(saveName.c_str());
 	}
-	// Adding our datatype as the first line of the recorded trajectory
-	fileOut = saveName + ".csv";
-	std::ifstream in(saveName.c_str());
-	std::ofstream out(fileOut.c_str());
-	if (recordType == 0)
-		out << "jp_type\n";
-	else
-		out << "pose_type\n";
-	out << in.rdbuf();
-	out.close();
-	in.close();
-	remove(saveName.c_str());
 	printf("Trajectory saved to the location: %s \n\n ", fileOut.c_str());
 }
 
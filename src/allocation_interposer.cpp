@@ -0,0 +1,108 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+
+/*
+ * allocation_interposer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *
+ * Replaces the C allocation functions so that detail::AllocationTracker can
+ * count them. The default operator new and operator delete call malloc() and
+ * free(), so they are covered as well. This file is built into its own library
+ * (barrett_allocation_interposer) that programs opt into by linking against it
+ * or loading it with LD_PRELOAD.
+ */
+
+#include <cstddef>
+#include <cerrno>
+
+#include <barrett/detail/allocation_tracker.h>
+
+
+extern "C" {
+
+// glibc's implementations
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+
+
+void* malloc(size_t size)
+{
+	barrett::detail::AllocationTracker::noteAllocation(size);
+	return __libc_malloc(size);
+}
+
+void* calloc(size_t n, size_t size)
+{
+	barrett::detail::AllocationTracker::noteAllocation(n * size);
+	return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+	barrett::detail::AllocationTracker::noteAllocation(size);
+	return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size)
+{
+	barrett::detail::AllocationTracker::noteAllocation(size);
+	return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size)
+{
+	barrett::detail::AllocationTracker::noteAllocation(size);
+	return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** memptr, size_t alignment, size_t size)
+{
+	if (alignment % sizeof(void*) != 0  ||  (alignment & (alignment - 1)) != 0) {
+		return EINVAL;
+	}
+
+	barrett::detail::AllocationTracker::noteAllocation(size);
+	void* ptr = __libc_memalign(alignment, size);
+	if (ptr == NULL) {
+		return ENOMEM;
+	}
+	*memptr = ptr;
+	return 0;
+}
+
+void free(void* ptr)
+{
+	if (ptr != NULL) {
+		barrett::detail::AllocationTracker::noteFree();
+	}
+	__libc_free(ptr);
+}
+
+}
@@ -0,0 +1,184 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+
+/*
+ * allocation_tracker.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+
+#include <barrett/os.h>
+#include <barrett/detail/stacktrace.h>
+#include <barrett/systems/abstract/system.h>
+#include <barrett/detail/allocation_tracker.h>
+
+
+namespace barrett {
+namespace detail {
+
+
+__thread AllocationTracker* AllocationTracker::current = NULL;
+volatile bool AllocationTracker::interposerLinked = false;
+
+
+AllocationTracker::AllocationTracker(bool printBacktraces_) :
+	printBacktraces(printBacktraces_), currentSystem(NULL), prevCurrent(NULL), inTracker(false)
+{
+	reset();
+}
+
+AllocationTracker::~AllocationTracker()
+{
+	assert(current != this);
+}
+
+void AllocationTracker::reset()
+{
+	numCycles = numAllocatingCycles = 0;
+	numAllocations = numFrees = 0;
+	numBytes = 0;
+	cycleCount = 0;
+	numSystems = 0;
+}
+
+void AllocationTracker::logStatistics(const char* name) const
+{
+	logMessage("detail::AllocationTracker \"%s\" stats:") % name;
+	if ( !isInterposerLinked() ) {
+		logMessage("  (barrett_allocation_interposer is not linked; nothing was counted)");
+	}
+	logMessage("  cycles = %lu, allocating cycles = %lu") % numCycles % numAllocatingCycles;
+	logMessage("  allocations = %lu, frees = %lu, bytes = %lu") % numAllocations % numFrees % numBytes;
+	for (size_t i = 0; i < numSystems; ++i) {
+		const SystemStats& s = systems[i];
+		logMessage("  %s: allocations = %lu, frees = %lu, bytes = %lu")
+				% (s.sys == NULL ? "(no System)" : s.name) % s.numAllocations % s.numFrees % s.numBytes;
+	}
+}
+
+void AllocationTracker::noteAllocation(size_t size)
+{
+	interposerLinked = true;
+
+	AllocationTracker* at = current;
+	if (at != NULL) {
+		at->record(size, true);
+	}
+}
+
+void AllocationTracker::noteFree()
+{
+	AllocationTracker* at = current;
+	if (at != NULL) {
+		at->record(0, false);
+	}
+}
+
+void AllocationTracker::beginCycle()
+{
+	prevCurrent = current;
+	current = this;
+	cycleCount = 0;
+}
+
+void AllocationTracker::endCycle()
+{
+	current = prevCurrent;
+	prevCurrent = NULL;
+
+	++numCycles;
+	if (cycleCount != 0) {
+		++numAllocatingCycles;
+	}
+}
+
+AllocationTracker::SystemStats* AllocationTracker::findSystem(const systems::System* sys)
+{
+	for (size_t i = 0; i < numSystems; ++i) {
+		if (systems[i].sys == sys) {
+			return &systems[i];
+		}
+	}
+
+	if (numSystems == MAX_SYSTEMS) {
+		// Table is full: lump the rest together
+		systems[MAX_SYSTEMS - 1].sys = NULL;
+		return &systems[MAX_SYSTEMS - 1];
+	}
+
+	SystemStats* s = &systems[numSystems++];
+	s->sys = sys;
+	s->name[0] = '\0';
+	if (sys != NULL) {
+		// Copy the name so it can be reported after the System is destroyed.
+		// Reading a std::string doesn't allocate.
+		strncat(s->name, sys->getName().c_str(), MAX_NAME_LENGTH - 1);
+	}
+	s->numAllocations = s->numFrees = 0;
+	s->numBytes = 0;
+	return s;
+}
+
+void AllocationTracker::record(size_t size, bool isAllocation)
+{
+	if (inTracker) {
+		return;
+	}
+	inTracker = true;
+
+	SystemStats* s = findSystem(currentSystem);
+	++cycleCount;
+	if (isAllocation) {
+		++numAllocations;
+		numBytes += size;
+		++s->numAllocations;
+		s->numBytes += size;
+	} else {
+		++numFrees;
+		++s->numFrees;
+	}
+
+	if (printBacktraces) {
+		if (isAllocation) {
+			fprintf(stderr, "detail::AllocationTracker: %lu-byte allocation in %s\n",
+					(unsigned long) size, currentSystem == NULL ? "(no System)" : s->name);
+		} else {
+			fprintf(stderr, "detail::AllocationTracker: free in %s\n",
+					currentSystem == NULL ? "(no System)" : s->name);
+		}
+		print_stacktrace(stderr);
+	}
+
+	inTracker = false;
+}
+
+
+}
+}
@@ -30,6 +30,8 @@
  *      Author: dc
  */
 
+#include <vector>
+#include <utility>
 #include <stdexcept>
 
 #include <barrett/os.h>
@@ -45,7 +47,7 @@ namespace bus {
 
 
 BusManager::BusManager(CommunicationsBus* _bus) :
-	bus(_bus), deleteBus(false), messageBuffers()
+	bus(_bus), deleteBus(false), messageBuffers(), observers()
 {
 	if (bus == NULL) {
 		bus = new CANSocket;
@@ -54,7 +56,7 @@ BusManager::BusManager(CommunicationsBus* _bus) :
 }
 
 BusManager::BusManager(int port) :
-	bus(NULL), deleteBus(true), messageBuffers()
+	bus(NULL), deleteBus(true), messageBuffers(), observers()
 {
 	bus = new CANSocket(port);
 }
@@ -94,7 +96,7 @@ int BusManager::receive(int expectedBusId, unsigned char* data, size_t& len, boo
 
 		if ((highResolutionSystemTime() - start) > CommunicationsBus::TIMEOUT) {
 			m.unlock();
-			logMessage("BusManager::receive(): timed out", true);
+			logMessageRT("BusManager::receive(): timed out", true);
 			return 2;
 		}
 
@@ -119,7 +121,10 @@ int BusManager::updateBuffers() const
 	while (true) {
 		ret = receiveRaw(busId, data, len, false);  // non-blocking read
 		if (ret == 0) {  // successfully received a message
-			if (busId != 1344) storeMessage(busId, data, len); // disregard safetyboard broadcast message
+			notifyObservers(busId, data, len);
+			if (busId != SAFETY_MODULE_BROADCAST_BUS_ID) {  // disregard safetyboard broadcast message
+				storeMessage(busId, data, len);
+			}
 		} else if (ret == 1) {  // would block
 			return 0;
 		} else {  // error
@@ -148,6 +153,35 @@ bool BusManager::retrieveMessage(int busId, unsigned char* data, size_t& len) co
 	return true;
 }
 
+void BusManager::addObserver(int busId, MessageObserver* mo)
+{
+	BARRETT_SCOPED_LOCK(getMutex());
+	observers.push_back(std::make_pair(busId, mo));
+}
+
+void BusManager::removeObserver(MessageObserver* mo)
+{
+	BARRETT_SCOPED_LOCK(getMutex());
+
+	std::vector<std::pair<int, MessageObserver*> >::iterator i = observers.begin();
+	while (i != observers.end()) {
+		if (i->second == mo) {
+			i = observers.erase(i);
+		} else {
+			++i;
+		}
+	}
+}
+
+void BusManager::notifyObservers(int busId, const unsigned char* data, size_t len) const
+{
+	for (size_t i = 0; i < observers.size(); ++i) {
+		if (observers[i].first == busId) {
+			observers[i].second->messageReceived(busId, data, len);
+		}
+	}
+}
+
 
 }
 }
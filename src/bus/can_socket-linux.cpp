@@ -184,30 +184,30 @@ int CANSocket::send(int busId, const unsigned char* data, size_t len) const
 
 		switch (ret) {
 		case -EAGAIN: // -EWOULDBLOCK
-			logMessage("CANSocket::%s: "
+			logMessageRT("CANSocket::%s: "
 					"send(): data would block during non-blocking send (output buffer full)")
 					% __func__;
 			return 1;
 			break;
 		case -ETIMEDOUT:
-			logMessage("CANSocket::%s: "
+			logMessageRT("CANSocket::%s: "
 					"send(): timed out")
 					% __func__;
 			return 2;
 			break;
 		case -EBADF:
-			logMessage("CANSocket::%s: "
+			logMessageRT("CANSocket::%s: "
 					"send(): aborted because socket was closed")
 					% __func__;
 			return 2;
 		default:
-			logMessage("CANSocket::%s: "
+			logMessageRT("CANSocket::%s: "
 					"send(): (%d) %s")
 					% __func__ % -ret % strerror(-ret);
 			return 2;
 		}
 	} else if (ret != sizeof(struct can_frame)) {
-		logMessage("CANSocket::%s: sent incomplete CAN frame (ret = %d")
+		logMessageRT("CANSocket::%s: sent incomplete CAN frame (ret = %d")
 				% __func__ % ret;
 		return 2;
 	}
@@ -233,30 +233,30 @@ int CANSocket::receiveRaw(int& busId, unsigned char* data, size_t& len, bool blo
 			return 1;
 			break;
 		case -ETIMEDOUT:
-			logMessage("CANSocket::%s: "
+			logMessageRT("CANSocket::%s: "
 					"recv(): timed out")
 					% __func__;
 			return 2;
 			break;
 		case -EBADF:
-			logMessage("CANSocket::%s: "
+			logMessageRT("CANSocket::%s: "
 					"recv(): aborted because socket was closed")
 					% __func__;
 			return 2;
 			break;
 		default:
-			logMessage("CANSocket::%s: "
+			logMessageRT("CANSocket::%s: "
 					"recv(): (%d) %s")
 					% __func__ % -ret % strerror(-ret);
 			return 2;
 			break;
 		}
 	} else if (ret != sizeof(struct can_frame)) {
-		logMessage("CANSocket::%s: received incomplete CAN frame (ret = %d")
+		logMessageRT("CANSocket::%s: received incomplete CAN frame (ret = %d")
 				% __func__ % ret;
 		return 2;
 	} else if (frame.can_id & CAN_ERR_FLAG) {
-		logMessage("CANSocket::%s: CAN_ERR_FLAG was set") % __func__;
+		logMessageRT("CANSocket::%s: CAN_ERR_FLAG was set") % __func__;
 		return 2;
 	}
 
@@ -229,24 +229,24 @@ int CANSocket::send(int busId, const unsigned char* data, size_t len) const
 
 		switch (ret) {
 		case -EAGAIN: // -EWOULDBLOCK
-			logMessage("CANSocket::%s: "
+			logMessageRT("CANSocket::%s: "
 					"rt_dev_send(): data would block during non-blocking send (output buffer full)")
 					% __func__;
 			return 1;
 			break;
 		case -ETIMEDOUT:
-			logMessage("CANSocket::%s: "
+			logMessageRT("CANSocket::%s: "
 					"rt_dev_send(): timed out")
 					% __func__;
 			return 2;
 			break;
 		case -EBADF:
-			logMessage("CANSocket::%s: "
+			logMessageRT("CANSocket::%s: "
 					"rt_dev_send(): aborted because socket was closed")
 					% __func__;
 			return 2;
 		default:
-			logMessage("CANSocket::%s: "
+			logMessageRT("CANSocket::%s: "
 					"rt_dev_send(): (%d) %s")
 					% __func__ % -ret % strerror(-ret);
 			return 2;
@@ -272,19 +272,19 @@ int CANSocket::receiveRaw(int& busId, unsigned char* data, size_t& len, bool blo
 			return 1;
 			break;
 		case -ETIMEDOUT:
-			logMessage("CANSocket::%s: "
+			logMessageRT("CANSocket::%s: "
 					"rt_dev_recv(): timed out")
 					% __func__;
 			return 2;
 			break;
 		case -EBADF:
-			logMessage("CANSocket::%s: "
+			logMessageRT("CANSocket::%s: "
 					"rt_dev_recv(): aborted because socket was closed")
 					% __func__;
 			return 2;
 			break;
 		default:
-			logMessage("CANSocket::%s: "
+			logMessageRT("CANSocket::%s: "
 					"rt_dev_recv(): (%d) %s")
 					% __func__ % -ret % strerror(-ret);
 			return 2;
@@ -298,10 +298,10 @@ int CANSocket::receiveRaw(int& busId, unsigned char* data, size_t& len, bool blo
 
 	if (frame.can_id & CAN_ERR_FLAG) {
 		if (frame.can_id & CAN_ERR_BUSOFF) {
-			logMessage("CANSocket::%s: bus-off") % __func__;
+			logMessageRT("CANSocket::%s: bus-off") % __func__;
 		}
 		if (frame.can_id & CAN_ERR_CRTL) {
-			logMessage("CANSocket::%s: controller problem") % __func__;
+			logMessageRT("CANSocket::%s: controller problem") % __func__;
 		}
 		return 2;
 	}
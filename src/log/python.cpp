@@ -0,0 +1,188 @@
+/*
+	Copyright 2012 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * python.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <sstream>
+#include <stdexcept>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/python.hpp>
+
+#include <barrett/log/trajectory_file.h>
+
+#include "../python.h"
+#include "../numpy.h"
+
+
+using namespace barrett;
+using namespace boost::python;
+
+
+// Owns a read-only mapping of a file. Arrays viewing the mapping hold a
+// reference to one of these (wrapped in a PyCapsule), so the file stays
+// mapped until the last such array is gone.
+struct FileMap {
+	void* addr;
+	size_t length;
+};
+
+void FileMap_destroy(PyObject* capsule) {
+	FileMap* fm = static_cast<FileMap*>(PyCapsule_GetPointer(capsule, "barrett.log.FileMap"));
+	munmap(fm->addr, fm->length);
+	delete fm;
+}
+
+// Maps a binary log written by log::Writer or log::RealTimeWriter. The log is
+// a sequence of packed records, so dtype must describe one record (for
+// example, a boost::tuple<double, jp_type> with a 7-DOF WAM is
+// [('t', 'f8'), ('jp', 'f8', 7)]). Returns a read-only, 1-D structured array
+// with one element per record. Nothing is parsed or copied: pages are read
+// from the file as the array is accessed.
+object mapBinaryLog(const char* fileName, object dtype) {
+	PyArray_Descr* descr = NULL;
+	if ( !PyArray_DescrConverter(dtype.ptr(), &descr) ) {
+		throw_error_already_set();
+	}
+	object descrObj(handle<>(reinterpret_cast<PyObject*>(descr)));
+	const size_t recordLength = extract<size_t>(descrObj.attr("itemsize"));
+	if (recordLength == 0) {
+		throw(std::invalid_argument("(log::mapBinaryLog()): The dtype must have a non-zero size."));
+	}
+
+	int fd = open(fileName, O_RDONLY);
+	if (fd == -1) {
+		std::stringstream ss;
+		ss << "(log::mapBinaryLog()): Could not open the file '" << fileName << "'.";
+		throw(std::runtime_error(ss.str()));
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		::close(fd);
+		std::stringstream ss;
+		ss << "(log::mapBinaryLog()): Could not stat the file '" << fileName << "'.";
+		throw(std::runtime_error(ss.str()));
+	}
+	const size_t length = st.st_size;
+	if (length % recordLength != 0) {
+		::close(fd);
+		std::stringstream ss;
+		ss << "(log::mapBinaryLog()): The size of the file '" << fileName
+				<< "' is not evenly divisible by the record length (" << recordLength
+				<< " bytes). Check the dtype.";
+		throw(std::runtime_error(ss.str()));
+	}
+
+	npy_intp dims[1] = { static_cast<npy_intp>(length / recordLength) };
+	if (length == 0) {  // mmap() can't map an empty file
+		::close(fd);
+		Py_INCREF(descr);  // PyArray_NewFromDescr() steals a reference.
+		PyObject* a = PyArray_NewFromDescr(&PyArray_Type, descr, 1, dims, NULL, NULL, 0, NULL);
+		if (a == NULL) {
+			throw_error_already_set();
+		}
+		return object(handle<>(a));
+	}
+
+	void* addr = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);  // The mapping stays valid after the descriptor is closed.
+	if (addr == MAP_FAILED) {
+		std::stringstream ss;
+		ss << "(log::mapBinaryLog()): Could not map the file '" << fileName << "'.";
+		throw(std::runtime_error(ss.str()));
+	}
+	madvise(addr, length, MADV_SEQUENTIAL);
+
+	FileMap* fm = new FileMap;
+	fm->addr = addr;
+	fm->length = length;
+	PyObject* capsule = PyCapsule_New(fm, "barrett.log.FileMap", FileMap_destroy);
+	if (capsule == NULL) {
+		munmap(addr, length);
+		delete fm;
+		throw_error_already_set();
+	}
+	handle<> capsuleHandle(capsule);
+
+	// Records are packed, so fields aren't necessarily aligned. Without
+	// NPY_ARRAY_WRITEABLE, Python code can't modify the mapping.
+	Py_INCREF(descr);
+	PyObject* a = PyArray_NewFromDescr(&PyArray_Type, descr, 1, dims, NULL, addr,
+			NPY_ARRAY_C_CONTIGUOUS, NULL);
+	if (a == NULL) {
+		throw_error_already_set();
+	}
+	handle<> arrayHandle(a);
+
+	// PyArray_SetBaseObject() steals a reference.
+	if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(a), capsuleHandle.release()) < 0) {
+		throw_error_already_set();
+	}
+	return object(arrayHandle);
+}
+
+
+// Returns a read-only (numRecords, width + 1) array viewing the file's
+// mapping. Column 0 holds the time stamps.
+object TrajectoryFile_getRecords(object self) {
+	const log::TrajectoryFile& tf = extract<const log::TrajectoryFile&>(self);
+	npy_intp dims[2] = { static_cast<npy_intp>(tf.numRecords()), static_cast<npy_intp>(tf.getWidth() + 1) };
+	return numpyView(tf.numRecords() ? tf.getRecord(0) : NULL, 2, dims, self);
+}
+
+
+void pythonLogInterface() {
+	def("mapBinaryLog", &mapBinaryLog);
+
+	// close() is not wrapped: it would unmap the memory viewed by the arrays
+	// that getRecords() returns. The file is closed when the object is
+	// garbage collected.
+	scope s = class_<log::TrajectoryFile, boost::noncopyable>("TrajectoryFile", init<const char*>())
+		.def("isTrajectoryFile", &log::TrajectoryFile::isTrajectoryFile)
+		.staticmethod("isTrajectoryFile")
+		.def("convertCSV", &log::TrajectoryFile::convertCSV)
+		.staticmethod("convertCSV")
+
+		.def("getSampleType", &log::TrajectoryFile::getSampleType)
+		.def("getWidth", &log::TrajectoryFile::getWidth)
+		.def("getRecordPeriod", &log::TrajectoryFile::getRecordPeriod)
+		.def("numRecords", &log::TrajectoryFile::numRecords)
+		.def("getRecords", &TrajectoryFile_getRecords)
+	;
+
+	enum_<log::TrajectoryFile::SampleType>("SampleType")
+		.value("JOINT_POSITIONS", log::TrajectoryFile::JOINT_POSITIONS)
+		.value("POSE", log::TrajectoryFile::POSE)
+	;
+}
@@ -0,0 +1,279 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ */
+
+
+/*
+ * trajectory_file.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstdlib>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/static_assert.hpp>
+
+#include <barrett/log/trajectory_file.h>
+
+
+namespace barrett {
+namespace log {
+
+
+// The records that follow the header must be aligned for doubles.
+BOOST_STATIC_ASSERT(sizeof(TrajectoryFile::Header) % sizeof(double) == 0);
+
+const char TrajectoryFile::Header::MAGIC[8] = { 'B', 'T', 'T', 'R', 'A', 'J', '\0', '\0' };
+const uint32_t TrajectoryFile::Header::VERSION;
+const size_t TrajectoryFile::POSE_WIDTH;
+
+
+TrajectoryFile::Header::Header(SampleType type, size_t width_, double recordPeriod_) :
+	version(VERSION), headerLength(sizeof(Header)), sampleType(type), width(width_),
+	recordLength((width_ + 1) * sizeof(double)), flags(0), recordPeriod(recordPeriod_)
+{
+	std::memcpy(magic, MAGIC, sizeof(magic));
+}
+
+
+TrajectoryFile::TrajectoryFile(const char* fileName) :
+	map(MAP_FAILED), mapLength(0), header(NULL), records(NULL), recordCount(0)
+{
+	int fd = open(fileName, O_RDONLY);
+	if (fd == -1) {
+		std::stringstream ss;
+		ss << "(log::TrajectoryFile::TrajectoryFile()): Could not open the file '" << fileName << "'.";
+		throw(std::runtime_error(ss.str()));
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) == 0  &&  static_cast<size_t>(st.st_size) >= sizeof(Header)) {
+		mapLength = st.st_size;
+		map = mmap(NULL, mapLength, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	::close(fd);  // The mapping stays valid after the descriptor is closed.
+
+	if (map == MAP_FAILED) {
+		std::stringstream ss;
+		ss << "(log::TrajectoryFile::TrajectoryFile()): Could not map the file '" << fileName
+				<< "'. It may be too short to be a trajectory file.";
+		throw(std::runtime_error(ss.str()));
+	}
+
+	// Samples are usually copied out front to back.
+	madvise(map, mapLength, MADV_SEQUENTIAL);
+
+	header = static_cast<const Header*>(map);
+	try {
+		validateHeader(*header, fileName);
+
+		if (header->headerLength > mapLength  ||
+				(mapLength - header->headerLength) % header->recordLength != 0) {
+			std::stringstream ss;
+			ss << "(log::TrajectoryFile::TrajectoryFile()): The file '" << fileName
+					<< "' is corrupted. Its size is not evenly divisible by the record length ("
+					<< header->recordLength << " bytes).";
+			throw(std::runtime_error(ss.str()));
+		}
+	} catch (...) {
+		close();
+		throw;
+	}
+
+	recordCount = (mapLength - header->headerLength) / header->recordLength;
+	records = reinterpret_cast<const double*>(static_cast<const char*>(map) + header->headerLength);
+}
+
+TrajectoryFile::~TrajectoryFile()
+{
+	close();
+}
+
+bool TrajectoryFile::isTrajectoryFile(const char* fileName)
+{
+	char magic[sizeof(Header::MAGIC)];
+	std::ifstream ifs(fileName, std::ios_base::binary);
+	ifs.read(magic, sizeof(magic));
+	return ifs.good()  &&  std::memcmp(magic, Header::MAGIC, sizeof(magic)) == 0;
+}
+
+void TrajectoryFile::writeHeader(std::ostream& os, SampleType type, size_t width, double recordPeriod)
+{
+	Header h(type, width, recordPeriod);
+	os.write(reinterpret_cast<const char*>(&h), sizeof(h));
+	if ( !os.good() ) {
+		throw(std::runtime_error("(log::TrajectoryFile::writeHeader()): Could not write the header."));
+	}
+}
+
+void TrajectoryFile::convertCSV(const char* csvFileName, const char* outputFileName)
+{
+	std::ifstream ifs(csvFileName);
+	if ( !ifs.good() ) {
+		std::stringstream ss;
+		ss << "(log::TrajectoryFile::convertCSV()): Could not open the file '" << csvFileName << "'.";
+		throw(std::runtime_error(ss.str()));
+	}
+
+	std::string line;
+	std::getline(ifs, line);
+	line.erase(line.find_last_not_of(" \t\r") + 1);
+
+	SampleType type;
+	if (line == "jp_type") {
+		type = JOINT_POSITIONS;
+	} else if (line == "pose_type") {
+		type = POSE;
+	} else {
+		std::stringstream ss;
+		ss << "(log::TrajectoryFile::convertCSV()): The first line of '" << csvFileName
+				<< "' must be \"jp_type\" or \"pose_type\".";
+		throw(std::runtime_error(ss.str()));
+	}
+
+	// The output file is opened once the width of the records is known.
+	std::ofstream ofs;
+	size_t width = 0;
+	size_t lineNumber = 1;
+	std::vector<double> record;
+	while (std::getline(ifs, line)) {
+		++lineNumber;
+		if (line.find_first_not_of(" \t\r") == std::string::npos) {
+			continue;
+		}
+
+		record.clear();
+		const char* pos = line.c_str();
+		char* end = NULL;
+		bool valid = true;
+		while (true) {
+			double x = std::strtod(pos, &end);
+			if (end == pos) {
+				valid = false;
+				break;
+			}
+			record.push_back(x);
+
+			while (*end == ' '  ||  *end == '\t'  ||  *end == '\r') {
+				++end;
+			}
+			if (*end == '\0') {
+				break;
+			} else if (*end != ',') {
+				valid = false;
+				break;
+			}
+			pos = end + 1;
+		}
+
+		if (width == 0  &&  valid  &&  record.size() > 1) {
+			width = record.size() - 1;
+		}
+		if ( !valid  ||  width == 0  ||  record.size() != width + 1  ||  (type == POSE  &&  width != POSE_WIDTH) ) {
+			std::stringstream ss;
+			ss << "(log::TrajectoryFile::convertCSV()): Line " << lineNumber << " of '" << csvFileName
+					<< "' is malformed.";
+			throw(std::runtime_error(ss.str()));
+		}
+
+		if (type == POSE) {
+			// The CSV lists the quaternion as (w, x, y, z).
+			std::rotate(record.begin() + 4, record.begin() + 5, record.end());
+		}
+
+		if ( !ofs.is_open() ) {
+			ofs.open(outputFileName, std::ios_base::binary);
+			writeHeader(ofs, type, width);
+		}
+		ofs.write(reinterpret_cast<const char*>(&record[0]), record.size() * sizeof(double));
+	}
+
+	if ( !ofs.is_open() ) {
+		std::stringstream ss;
+		ss << "(log::TrajectoryFile::convertCSV()): The file '" << csvFileName << "' contains no samples.";
+		throw(std::runtime_error(ss.str()));
+	}
+
+	ofs.close();
+	if (ofs.fail()) {
+		std::stringstream ss;
+		ss << "(log::TrajectoryFile::convertCSV()): Could not write the file '" << outputFileName << "'.";
+		throw(std::runtime_error(ss.str()));
+	}
+}
+
+void TrajectoryFile::close()
+{
+	if (map != MAP_FAILED) {
+		munmap(map, mapLength);
+		map = MAP_FAILED;
+	}
+	mapLength = 0;
+	header = NULL;
+	records = NULL;
+	recordCount = 0;
+}
+
+void TrajectoryFile::validateHeader(const Header& h, const char* fileName)
+{
+	std::stringstream ss;
+	ss << "(log::TrajectoryFile::validateHeader()): The file '" << fileName << "' ";
+
+	if (std::memcmp(h.magic, Header::MAGIC, sizeof(h.magic)) != 0) {
+		ss << "is not a trajectory file.";
+	} else if (h.version != Header::VERSION) {
+		ss << "has an unsupported version (" << h.version << ").";
+	} else if (h.flags != 0) {
+		ss << "uses unsupported features (flags " << h.flags << ").";
+	} else if (h.headerLength < sizeof(Header)  ||  h.headerLength % sizeof(double) != 0) {
+		ss << "has an invalid header length (" << h.headerLength << " bytes).";
+	} else if (h.sampleType != JOINT_POSITIONS  &&  h.sampleType != POSE) {
+		ss << "has an unknown sample type (" << h.sampleType << ").";
+	} else if (h.width == 0  ||  (h.sampleType == POSE  &&  h.width != POSE_WIDTH)) {
+		ss << "has an invalid width (" << h.width << ").";
+	} else if (h.recordLength != (h.width + 1) * sizeof(double)) {
+		ss << "has an invalid record length (" << h.recordLength << " bytes).";
+	} else {
+		return;
+	}
+
+	throw(std::runtime_error(ss.str()));
+}
+
+
+}
+}
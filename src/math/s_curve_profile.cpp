@@ -0,0 +1,162 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+
+/*
+ * s_curve_profile.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include <barrett/os.h>
+#include <barrett/math/s_curve_profile.h>
+
+
+namespace barrett {
+namespace math {
+
+
+const int SCurveProfile::NUM_SEGMENTS;
+
+
+SCurveProfile::SCurveProfile(double velocity, double acceleration, double jerk,
+		double pathLength) :
+	v(velocity), a(acceleration), j(jerk), l(pathLength)
+{
+	init();
+}
+
+void SCurveProfile::init()
+{
+	if (v <= 0.0  ||  a <= 0.0  ||  j <= 0.0  ||  l < 0.0) {
+		(logMessage("SCurveProfile::%s(): velocity, acceleration, and jerk must "
+				"be positive and pathLength must not be negative. Got v=%g, "
+				"a=%g, j=%g, l=%g.")
+				% __func__ % v % a % j % l).raise<std::invalid_argument>();
+	}
+
+	// T_j: duration of each jerk segment
+	// T_a: duration of the acceleration phase (segments 1-3)
+	// T_v: duration of the constant velocity segment
+	double T_j = 0.0, T_a = 0.0, T_v = 0.0;
+	if (l > 0.0) {
+		if (v * j >= a * a) {
+			T_j = a / j;
+			T_a = T_j + v / a;
+		} else {
+			T_j = std::sqrt(v / j);
+			T_a = 2.0 * T_j;
+		}
+
+		if (v * T_a <= l) {
+			T_v = (l - v * T_a) / v;
+		} else {
+			// The path is too short to reach the velocity limit. Find the peak
+			// velocity, first assuming the acceleration limit is reached.
+			double aj = a * a / j;
+			double v_p = (std::sqrt(aj * aj + 4.0 * a * l) - aj) / 2.0;
+			if (v_p >= aj) {
+				T_j = a / j;
+				T_a = T_j + v_p / a;
+			} else {
+				// Neither limit is reached: l = 2 * j * T_j^3
+				T_j = std::pow(l / (2.0 * j), 1.0 / 3.0);
+				T_a = 2.0 * T_j;
+			}
+		}
+	}
+
+	const double T_ca = std::max(0.0, T_a - 2.0 * T_j);
+	const double durations[NUM_SEGMENTS] = { T_j, T_ca, T_j, T_v, T_j, T_ca, T_j };
+	const double jerks[NUM_SEGMENTS] = { j, 0.0, -j, 0.0, -j, 0.0, j };
+
+	double s = 0.0, sd = 0.0, sdd = 0.0;
+	segT[0] = 0.0;
+	for (int i = 0; i < NUM_SEGMENTS; ++i) {
+		const double tau = durations[i];
+
+		segS[i] = s;
+		segV[i] = sd;
+		segA[i] = sdd;
+		segJ[i] = jerks[i];
+		segT[i+1] = segT[i] + tau;
+
+		s += tau * (sd + tau * (sdd / 2.0 + tau * jerks[i] / 6.0));
+		sd += tau * (sdd + tau * jerks[i] / 2.0);
+		sdd += tau * jerks[i];
+	}
+}
+
+inline int SCurveProfile::segment(double t) const
+{
+	int i = NUM_SEGMENTS - 1;
+	while (i > 0  &&  t < segT[i]) {
+		--i;
+	}
+	return i;
+}
+
+double SCurveProfile::eval(double t) const
+{
+	if (t <= 0.0) {
+		return 0.0;
+	} else if (t >= finalT()) {
+		return l;
+	}
+
+	int i = segment(t);
+	double tau = t - segT[i];
+	return segS[i] + tau * (segV[i] + tau * (segA[i] / 2.0 + tau * segJ[i] / 6.0));
+}
+
+double SCurveProfile::evalDerivative(double t) const
+{
+	if (t <= 0.0  ||  t >= finalT()) {
+		return 0.0;
+	}
+
+	int i = segment(t);
+	double tau = t - segT[i];
+	return segV[i] + tau * (segA[i] + tau * segJ[i] / 2.0);
+}
+
+double SCurveProfile::evalSecondDerivative(double t) const
+{
+	if (t <= 0.0  ||  t >= finalT()) {
+		return 0.0;
+	}
+
+	int i = segment(t);
+	return segA[i] + (t - segT[i]) * segJ[i];
+}
+
+
+}
+}
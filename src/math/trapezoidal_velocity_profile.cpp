@@ -65,6 +65,21 @@ double TrapezoidalVelocityProfile::eval(double t) const
 	return x;
 }
 
+double TrapezoidalVelocityProfile::evalDerivative(double t) const
+{
+	if (t < 0.0) {
+		return 0.0;
+	} else if (t < impl->time_endup) {
+		return impl->v_init + (impl->v_init < impl->vel ? impl->acc : -impl->acc) * t;
+	} else if (t < impl->time_startdown) {
+		return impl->vel;
+	} else if (t < impl->time_end) {
+		return impl->acc * (impl->time_end - t);
+	} else {
+		return 0.0;
+	}
+}
+
 
 }
 }
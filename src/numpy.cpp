@@ -0,0 +1,61 @@
+/*
+	Copyright 2012 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * numpy.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <boost/python.hpp>
+
+#define BARRETT_NUMPY_IMPORT_ARRAY
+#include "numpy.h"
+
+
+using namespace boost::python;
+
+
+void importNumpy() {
+	if (_import_array() < 0) {
+		throw_error_already_set();
+	}
+}
+
+object numpyView(const double* data, int nd, npy_intp* dims, object owner) {
+	// Without NPY_ARRAY_WRITEABLE, Python code can't modify the C++ buffer.
+	PyObject* a = PyArray_New(&PyArray_Type, nd, dims, NPY_DOUBLE, NULL,
+			const_cast<double*>(data), 0, NPY_ARRAY_CARRAY_RO, NULL);
+	if (a == NULL) {
+		throw_error_already_set();
+	}
+	handle<> h(a);
+
+	// PyArray_SetBaseObject() steals a reference.
+	Py_INCREF(owner.ptr());
+	if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(a), owner.ptr()) < 0) {
+		throw_error_already_set();
+	}
+	return object(h);
+}
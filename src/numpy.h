@@ -0,0 +1,133 @@
+/*
+	Copyright 2012 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * numpy.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef BARRETT_SRC_NUMPY_H_
+#define BARRETT_SRC_NUMPY_H_
+
+
+#include <boost/python.hpp>
+
+#include <barrett/math/matrix.h>
+
+
+// BARRETT_WITH_NUMPY is defined if NumPy's headers were found at configure
+// time. Without them, toNumpy() and fromNumpy() fall back to Python lists and
+// the bindings that view C++ buffers (numpyView()) aren't available.
+#ifdef BARRETT_WITH_NUMPY
+
+// Every translation unit shares the API table that importNumpy() fills in.
+#define PY_ARRAY_UNIQUE_SYMBOL barrett_ARRAY_API
+#ifndef BARRETT_NUMPY_IMPORT_ARRAY
+#  define NO_IMPORT_ARRAY
+#endif
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+
+
+// Must be called before any other function in this file.
+void importNumpy();
+
+// Returns a read-only array viewing data. The memory isn't copied, so owner
+// (which must keep data valid) is kept alive for as long as the array is.
+boost::python::object numpyView(const double* data, int nd, npy_intp* dims, boost::python::object owner);
+
+// Returns a new array holding a copy of m. Vectors become 1-D arrays; other
+// matrices keep their (row-major) shape. The elements are copied in one block.
+template<int R, int C, typename Units>
+boost::python::object toNumpy(const barrett::math::Matrix<R,C, Units>& m)
+{
+	npy_intp dims[2] = { m.rows(), m.cols() };
+	int nd = (C == 1) ? 1 : 2;
+
+	PyObject* a = PyArray_SimpleNew(nd, dims, NPY_DOUBLE);
+	if (a == NULL) {
+		boost::python::throw_error_already_set();
+	}
+	std::memcpy(PyArray_DATA(reinterpret_cast<PyArrayObject*>(a)), m.data(), m.size() * sizeof(double));
+	return boost::python::object(boost::python::handle<>(a));
+}
+
+// Copies any array-like object with the same number of elements as m into m.
+// Raises ValueError if the sizes don't match.
+template<int R, int C, typename Units>
+void fromNumpy(const boost::python::object& o, barrett::math::Matrix<R,C, Units>* m)
+{
+	PyObject* a = PyArray_FROMANY(o.ptr(), NPY_DOUBLE, 0, 2, NPY_ARRAY_IN_ARRAY);
+	if (a == NULL) {
+		boost::python::throw_error_already_set();
+	}
+	boost::python::handle<> h(a);
+
+	if (PyArray_SIZE(reinterpret_cast<PyArrayObject*>(a)) != m->size()) {
+		PyErr_Format(PyExc_ValueError, "Expected an array of %d elements.", static_cast<int>(m->size()));
+		boost::python::throw_error_already_set();
+	}
+	std::memcpy(m->data(), PyArray_DATA(reinterpret_cast<PyArrayObject*>(a)), m->size() * sizeof(double));
+}
+
+#else
+
+// Returns a new list holding a copy of m. Vectors become flat lists; other
+// matrices become lists of rows.
+template<int R, int C, typename Units>
+boost::python::object toNumpy(const barrett::math::Matrix<R,C, Units>& m)
+{
+	boost::python::list l;
+	for (int i = 0; i < m.rows(); ++i) {
+		if (C == 1) {
+			l.append(m(i,0));
+		} else {
+			boost::python::list row;
+			for (int j = 0; j < m.cols(); ++j) {
+				row.append(m(i,j));
+			}
+			l.append(row);
+		}
+	}
+	return l;
+}
+
+// Copies a flat sequence with the same number of elements as m into m.
+// Raises ValueError if the sizes don't match.
+template<int R, int C, typename Units>
+void fromNumpy(const boost::python::object& o, barrett::math::Matrix<R,C, Units>* m)
+{
+	if (boost::python::len(o) != m->size()) {
+		PyErr_Format(PyExc_ValueError, "Expected a sequence of %d elements.", static_cast<int>(m->size()));
+		boost::python::throw_error_already_set();
+	}
+	for (int i = 0; i < m->size(); ++i) {
+		m->data()[i] = boost::python::extract<double>(o[i]);
+	}
+}
+
+#endif
+
+
+#endif /* BARRETT_SRC_NUMPY_H_ */
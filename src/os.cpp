@@ -33,10 +33,15 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <cstring>
 #include <cassert>
 
 #include <syslog.h>
 #include <signal.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
 #include <sys/mman.h>
 
 #ifdef BARRETT_XENOMAI
@@ -49,6 +54,7 @@
 
 #include <barrett/detail/stacktrace.h>
 #include <barrett/detail/os.h>
+#include <barrett/thread/bounded_queue.h>
 #include <barrett/os.h>
 
 
@@ -122,28 +128,93 @@ void btsleep(double duration_s, bool realtime)
 }
 
 #ifndef BARRETT_XENOMAI
-// Record the time program execution began
-const boost::posix_time::ptime START_OF_PROGRAM_TIME = boost::posix_time::microsec_clock::local_time();
+namespace {
+struct timespec programStartTime() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts;
+}
+}
+// Record the time program execution began. Measuring relative to this keeps
+// the magnitude of the result small, preserving its resolution as a double.
+const struct timespec START_OF_PROGRAM_TIME = programStartTime();
 #endif
 double highResolutionSystemTime()
 {
 #ifdef BARRETT_XENOMAI
 	return 1e-9 * rt_timer_read();
 #else
-	return (boost::posix_time::microsec_clock::local_time() - START_OF_PROGRAM_TIME).total_nanoseconds() * 1e-9;
+	// CLOCK_MONOTONIC is serviced by the vDSO (no system call), has nanosecond
+	// resolution, and is never stepped. It is the same clock that
+	// PeriodicLoopTimer sleeps on.
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - START_OF_PROGRAM_TIME.tv_sec) + 1e-9 * (now.tv_nsec - START_OF_PROGRAM_TIME.tv_nsec);
 #endif
 }
 
 
 
-PeriodicLoopTimer::PeriodicLoopTimer(double period_, int threadPriority) :
-		firstRun(true), period(period_), releasePoint(-1.0)
+#ifndef BARRETT_XENOMAI
+namespace {
+
+const long NS_PER_S = 1000000000L;
+
+// Touch this much of the stack so the pages are resident before the loop
+// starts. (Page faults in the loop would cause latency spikes.)
+const size_t PREFAULT_STACK_SIZE = 64 * 1024;
+
+void addNanoseconds(struct timespec* ts, long ns) {
+	ts->tv_nsec += ns;
+	while (ts->tv_nsec >= NS_PER_S) {
+		ts->tv_nsec -= NS_PER_S;
+		++ts->tv_sec;
+	}
+}
+
+// Returns a - b in nanoseconds
+long long nanosecondsBetween(const struct timespec& a, const struct timespec& b) {
+	return (long long)(a.tv_sec - b.tv_sec) * NS_PER_S + (a.tv_nsec - b.tv_nsec);
+}
+
+void prefaultStack() {
+	unsigned char stack[PREFAULT_STACK_SIZE];
+
+	// Write through a volatile pointer. Otherwise the compiler can see that
+	// the array is never read and drop the writes.
+	volatile unsigned char* p = stack;
+	for (size_t i = 0; i < PREFAULT_STACK_SIZE; ++i) {
+		p[i] = 0;
+	}
+}
+
+// Only needs to succeed once per process.
+void lockMemory() {
+	static bool locked = false;
+	if ( !locked ) {
+		if (mlockall(MCL_CURRENT|MCL_FUTURE) == 0) {
+			locked = true;
+		} else {
+			barrett::logMessage("PeriodicLoopTimer: WARNING: mlockall(): (%d) %s")
+					% errno % strerror(errno);
+		}
+	}
+}
+
+}
+#endif
+
+PeriodicLoopTimer::PeriodicLoopTimer(double period_, int threadPriority, int cpu) :
+		firstRun(true), period(period_), numMissed(0),
+		period_ns(static_cast<long>(period_ * 1e9)), releasePoint()
 {
+	startRealTimeLogging();
+
 #ifdef BARRETT_XENOMAI
 	int ret;
 
 	// Try to become a Xenomai task
-	ret = rt_task_shadow(NULL, NULL, threadPriority, 0);
+	ret = rt_task_shadow(NULL, NULL, threadPriority, (cpu >= 0) ? T_CPU(cpu) : 0);
 	// EBUSY indicates the current thread is already a Xenomai task
 	if (ret != 0  &&  ret != -EBUSY) {
 		(logMessage("PeriodicLoopTimer::%s: rt_task_shadow(): (%d) %s")
@@ -155,6 +226,42 @@ PeriodicLoopTimer::PeriodicLoopTimer(double period_, int threadPriority) :
 		(logMessage("PeriodicLoopTimer::%s: rt_task_set_periodic(): (%d) %s")
 				% __func__ % -ret % strerror(-ret)).raise<std::runtime_error>();
 	}
+#else
+	int ret;
+
+	if (period_ns <= 0) {
+		(logMessage("PeriodicLoopTimer::%s: period must be positive. Got %g s.")
+				% __func__ % period).raise<std::invalid_argument>();
+	}
+
+	if (threadPriority > 0) {
+		struct sched_param sp;
+		memset(&sp, 0, sizeof(sp));
+		sp.sched_priority = threadPriority;
+		ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+		if (ret != 0) {
+			logMessage("PeriodicLoopTimer::%s: WARNING: Couldn't set SCHED_FIFO priority %d: (%d) %s")
+					% __func__ % threadPriority % ret % strerror(ret);
+		}
+	}
+
+	if (cpu >= 0) {
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		CPU_SET(cpu, &cpuSet);
+		ret = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+		if (ret != 0) {
+			logMessage("PeriodicLoopTimer::%s: WARNING: Couldn't pin thread to CPU %d: (%d) %s")
+					% __func__ % cpu % ret % strerror(ret);
+		}
+	}
+
+	// Only real-time threads need their memory locked and their stack
+	// prefaulted. (Unit tests, for example, pass a priority of 0.)
+	if (threadPriority > 0) {
+		lockMemory();
+		prefaultStack();
+	}
 #endif
 }
 
@@ -168,24 +275,42 @@ unsigned long PeriodicLoopTimer::wait()
 		(logMessage("%s: rt_task_wait_period(): (%d) %s") % __func__ % -ret % strerror(-ret)).raise<std::runtime_error>();
 	}
 
+	numMissed += missedReleasePoints;
 	return missedReleasePoints;
 #else
-	const double now = highResolutionSystemTime();
-	const double remainder = releasePoint - now;
-	if (remainder <= 0) {
-		releasePoint = now + period;
-
-		if (firstRun) {
-			firstRun = false;
-			return 0;
-		} else {
-			return ceil(-remainder / period);
-		}
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	if (firstRun) {
+		firstRun = false;
+		releasePoint = now;
+		addNanoseconds(&releasePoint, period_ns);
+		return 0;
+	}
+
+	const long long late_ns = nanosecondsBetween(now, releasePoint);
+	if (late_ns >= 0) {
+		// The release point has already passed. Count every release point
+		// between it and now, then start a new period.
+		unsigned long missedReleasePoints = (late_ns + period_ns - 1) / period_ns;
+		numMissed += missedReleasePoints;
+
+		releasePoint = now;
+		addNanoseconds(&releasePoint, period_ns);
+		return missedReleasePoints;
 	} else {
-		// Calculate the new releasePoint based on the old one.
-		// This eliminates drift (on average) due to over/under sleeping.
-		releasePoint += period;
-		btsleep(remainder);
+		// Sleeping until an absolute deadline and calculating the new
+		// releasePoint based on the old one eliminates drift due to
+		// over/under sleeping.
+		int ret;
+		do {
+			ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &releasePoint, NULL);
+		} while (ret == EINTR);
+		if (ret != 0) {
+			(logMessage("%s: clock_nanosleep(): (%d) %s") % __func__ % ret % strerror(ret)).raise<std::runtime_error>();
+		}
+
+		addNanoseconds(&releasePoint, period_ns);
 		return 0;
 	}
 #endif
@@ -199,8 +324,152 @@ detail::LogFormatter logMessage(const std::string& message, bool outputToStderr)
 }
 
 
+namespace {
+
+const long RT_LOG_POLLING_PERIOD_US = 10000;
+
+// True if the calling thread is scheduled in real time, and so mustn't block
+// on I/O.
+bool inRealTimeThread()
+{
+#ifdef BARRETT_XENOMAI
+	if (rt_task_self() != NULL) {
+		return true;
+	}
+#endif
+
+	int policy;
+	struct sched_param sp;
+	return pthread_getschedparam(pthread_self(), &policy, &sp) == 0  &&
+			(policy == SCHED_FIFO  ||  policy == SCHED_RR);
+}
+
+// Formats and prints records queued by logMessageRT(). The destructor runs at
+// program exit and prints any records still in the queue.
+class RealTimeLogger {
+public:
+	static const size_t QUEUE_SIZE = barrett::detail::REAL_TIME_LOG_QUEUE_SIZE;
+
+	RealTimeLogger() : started(0), numDropped(0), numDroppedReported(0), thread() {}
+	~RealTimeLogger() {
+		if (started) {
+			thread.interrupt();
+			thread.join();
+		}
+		flush();
+	}
+
+	void start() {
+		if (__sync_bool_compare_and_swap(&started, 0, 1)) {
+			boost::thread tmpThread(&RealTimeLogger::run, this);
+			thread.swap(tmpThread);
+		}
+	}
+
+	void submit(const barrett::detail::RealTimeLogRecord& record) {
+		// Starting the logger from here could create a thread from a real-time
+		// thread. Until somebody starts it, print the record right away, as
+		// logMessage() would, unless that could block a real-time thread.
+		if ( !started ) {
+			if (inRealTimeThread()) {
+				__sync_fetch_and_add(&numDropped, 1);
+			} else {
+				print(record);
+			}
+		} else if ( !queue.push(record) ) {
+			__sync_fetch_and_add(&numDropped, 1);
+		}
+	}
+
+	unsigned long getNumDropped() const { return numDropped; }
+
+protected:
+	void run() {
+		try {
+			while (true) {
+				flush();
+				boost::this_thread::sleep(boost::posix_time::microseconds(RT_LOG_POLLING_PERIOD_US));
+			}
+		} catch (const boost::thread_interrupted& e) {
+			// Interruption requested by the destructor. Do nothing.
+		}
+	}
+
+	void flush() {
+		barrett::detail::RealTimeLogRecord record;
+		while (queue.pop(&record)) {
+			print(record);
+		}
+
+		unsigned long nd = numDropped;
+		if (nd != numDroppedReported) {
+			barrett::logMessage("logMessageRT(): WARNING: %lu message(s) dropped because the queue was full "
+					"or a real-time thread logged before logging was started", true)
+					% (nd - numDroppedReported);
+			numDroppedReported = nd;
+		}
+	}
+
+	static void print(const barrett::detail::RealTimeLogRecord& record) {
+		typedef barrett::detail::RealTimeLogRecord::Arg Arg;
+
+		std::string message;
+		try {
+			boost::format f(std::string("[%.6f] ") + record.fmt);
+			f % record.time;
+			for (size_t i = 0; i < record.numArgs; ++i) {
+				const Arg& a = record.args[i];
+				switch (a.type) {
+				case Arg::CHAR:   f % a.c;  break;
+				case Arg::LONG:   f % a.l;  break;
+				case Arg::ULONG:  f % a.ul; break;
+				case Arg::DOUBLE: f % a.d;  break;
+				case Arg::STRING: f % a.s;  break;
+				}
+			}
+			message = f.str();
+		} catch (const boost::io::format_error& e) {
+			message = std::string("logMessageRT(): Could not format message \"") + record.fmt + "\": " + e.what();
+		}
+
+		// Use a trivial format string in case message contains '%'
+		barrett::logMessage("%s", record.ose) % message;
+	}
+
+	barrett::thread::BoundedQueue<barrett::detail::RealTimeLogRecord, QUEUE_SIZE> queue;
+	volatile int started;
+	volatile unsigned long numDropped;
+	unsigned long numDroppedReported;
+	boost::thread thread;
+};
+
+RealTimeLogger realTimeLogger;
+
+}
+
+detail::RealTimeLogFormatter logMessageRT(const char* message, bool outputToStderr)
+{
+	return detail::RealTimeLogFormatter(message, outputToStderr, highResolutionSystemTime());
+}
+
+unsigned long getNumDroppedRealTimeLogMessages()
+{
+	return realTimeLogger.getNumDropped();
+}
+
+void startRealTimeLogging()
+{
+	realTimeLogger.start();
+}
+
+
 namespace detail {
 
+void submitRealTimeLogRecord(const RealTimeLogRecord& record)
+{
+	realTimeLogger.submit(record);
+}
+
 void LogFormatter::print()
 {
 	// Make sure we only print once
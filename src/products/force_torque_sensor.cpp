@@ -59,15 +59,23 @@ void ForceTorqueSensor::setPuck(Puck* puck)
 /** update Method establishes new force and torque values from the sensor */
 void ForceTorqueSensor::update(bool realtime)
 {
-	int ret;
-
-	ret = Puck::sendGetPropertyRequest(*bus, id, propId);
+	requestUpdate();
+	receiveUpdate(realtime);
+}
+/** requestUpdate Method asks the sensor for new force and torque values */
+void ForceTorqueSensor::requestUpdate()
+{
+	int ret = Puck::sendGetPropertyRequest(*bus, id, propId);
 	if (ret != 0) {
 		(logMessage("ForceTorqueSensor::%s(): Failed to send request. "
 				"Puck::sendGetPropertyRequest() returned error %d.")
 				% __func__ % ret).raise<std::runtime_error>();
 	}
-
+}
+/** receiveUpdate Method receives new force and torque values */
+void ForceTorqueSensor::receiveUpdate(bool realtime)
+{
+	int ret;
 
 	// Receive force message
 	ret = Puck::receiveGetPropertyReply<ForceParser>(*bus, id, propId, &cf, true, realtime);
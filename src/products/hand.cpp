@@ -199,8 +199,12 @@ void Hand::update(unsigned int sensors, bool realtime)
 		ul.lock();
 	}
 
-
-	// Send requests
+	requestUpdate(sensors);
+	receiveUpdate(sensors, realtime);
+}
+/** requestUpdate Method */
+void Hand::requestUpdate(unsigned int sensors) const
+{
 	if (sensors & S_POSITION) {
 		group.sendGetPropertyRequest(group.getPropertyId(Puck::P));
 	}
@@ -209,10 +213,19 @@ void Hand::update(unsigned int sensors, bool realtime)
 	}
 	if (hasTactSensors()  &&  sensors & S_TACT_FULL) {
 		group.setProperty(Puck::TACT, TactilePuck::FULL_FORMAT);
+		for (size_t i = 0; i < tactilePucks.size(); ++i) {
+			tactilePucks[i]->tact = TactilePuck::FULL_FORMAT;
+		}
+	} else if (hasTactSensors()  &&  sensors & S_TACT_TOP10) {
+		group.setProperty(Puck::TACT, TactilePuck::TOP10_FORMAT);
+		for (size_t i = 0; i < tactilePucks.size(); ++i) {
+			tactilePucks[i]->tact = TactilePuck::TOP10_FORMAT;
+		}
 	}
-
-
-	// Receive replies
+}
+/** receiveUpdate Method */
+void Hand::receiveUpdate(unsigned int sensors, bool realtime)
+{
 	if (sensors & S_POSITION) {
 		group.receiveGetPropertyReply<MotorPuck::CombinedPositionParser<int> >(group.getPropertyId(Puck::P), encoderTmp.data(), realtime);
 
@@ -244,6 +257,10 @@ void Hand::update(unsigned int sensors, bool realtime)
 		for (size_t i = 0; i < tactilePucks.size(); ++i) {
 			tactilePucks[i]->receiveFull(realtime);
 		}
+	} else if (hasTactSensors()  &&  sensors & S_TACT_TOP10) {
+		for (size_t i = 0; i < tactilePucks.size(); ++i) {
+			tactilePucks[i]->receiveTop10(realtime);
+		}
 	}
 }
 
@@ -73,6 +73,9 @@ ProductManager::ProductManager(const char* configFile, bus::CommunicationsBus* _
 
 	logMessage("ProductManager::%s()") % __func__;
 
+	// The Pucks' reply parsers report errors with logMessageRT().
+	startRealTimeLogging();
+
 	char cfSource[8] = "param";
 	if (configFile == NULL  ||  configFile[0] == '\0') {
 		configFile = std::getenv("BARRETT_CONFIG_FILE");
@@ -202,21 +202,21 @@ int Puck::StandardParser::parse(int id,
 {
 	bool err = false;
 	if (len != 4 && len != 6) {
-		logMessage("%s: expected message length of 4 or 6, got message length of %d")
+		logMessageRT("%s: expected message length of 4 or 6, got message length of %d")
 				% __func__ % len;
 		err = true;
 	}
 	if (!(data[0] & Puck::SET_MASK)) {
-		logMessage("%s: expected SET command, got GET request") % __func__;
+		logMessageRT("%s: expected SET command, got GET request") % __func__;
 		err = true;
 	}
 	if ((propId & Puck::PROPERTY_MASK) != (data[0] & Puck::PROPERTY_MASK)) {
-		logMessage("%s: expected property = %d, got property %d")
+		logMessageRT("%s: expected property = %d, got property %d")
 				% __func__ % (propId & Puck::PROPERTY_MASK) % (data[0] & Puck::PROPERTY_MASK);
 		err = true;
 	}
 	if (data[1] != 0) {
-		logMessage("%s: expected second data byte to be 0, got value of %d")
+		logMessageRT("%s: expected second data byte to be 0, got value of %d")
 				% __func__ % data[1];
 		err = true;
 	}
@@ -0,0 +1,142 @@
+/*
+	Copyright 2012 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * hand.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <vector>
+
+#include <boost/python.hpp>
+
+#include <barrett/products/hand.h>
+#include <barrett/products/tactile_puck.h>
+
+#include "../../numpy.h"
+
+
+using namespace barrett;
+using namespace boost::python;
+
+
+const size_t DOF = Hand::DOF;
+
+const unsigned int F1 = Hand::F1;
+const unsigned int F2 = Hand::F2;
+const unsigned int F3 = Hand::F3;
+const unsigned int SPREAD = Hand::SPREAD;
+const unsigned int GRASP = Hand::GRASP;
+const unsigned int WHOLE_HAND = Hand::WHOLE_HAND;
+
+const unsigned int S_POSITION = Hand::S_POSITION;
+const unsigned int S_FINGERTIP_TORQUE = Hand::S_FINGERTIP_TORQUE;
+const unsigned int S_TACT_FULL = Hand::S_TACT_FULL;
+const unsigned int S_TACT_TOP10 = Hand::S_TACT_TOP10;
+const unsigned int S_ALL = Hand::S_ALL;
+
+
+void (Hand::*Hand_open)(unsigned int, bool) const = &Hand::open;
+void (Hand::*Hand_close)(unsigned int, bool) const = &Hand::close;
+
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(Hand_open_overloads, open, 0, 2)
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(Hand_close_overloads, close, 0, 2)
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(Hand_doneMoving_overloads, doneMoving, 0, 2)
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(Hand_waitUntilDoneMoving_overloads, waitUntilDoneMoving, 0, 2)
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(Hand_update_overloads, update, 0, 2)
+
+
+void Hand_trapezoidalMoveArray(const Hand& hand, object jp, unsigned int whichDigits = Hand::WHOLE_HAND, bool blocking = true) {
+	Hand::jp_type tmp;
+	fromNumpy(jp, &tmp);
+	hand.trapezoidalMove(tmp, whichDigits, blocking);
+}
+BOOST_PYTHON_FUNCTION_OVERLOADS(Hand_trapezoidalMoveArray_overloads, Hand_trapezoidalMoveArray, 2, 4)
+
+object Hand_getInnerLinkPosition(const Hand& hand) {
+	return toNumpy(hand.getInnerLinkPosition());
+}
+object Hand_getOuterLinkPosition(const Hand& hand) {
+	return toNumpy(hand.getOuterLinkPosition());
+}
+
+// Returns a list with one read-only array per TactilePuck. The arrays view the
+// Pucks' buffers, so they are refreshed in place by each update() that
+// includes S_TACT_FULL. They keep the Hand alive.
+//
+// Without NumPy, the list holds a copy of each TactilePuck's data instead, so
+// it must be fetched again after each update().
+list Hand_getTactileData(object self) {
+	const Hand& hand = extract<const Hand&>(self);
+	const std::vector<TactilePuck*>& tps = hand.getTactilePucks();
+
+#ifdef BARRETT_WITH_NUMPY
+	npy_intp dims[1] = { TactilePuck::NUM_SENSORS };
+#endif
+	list data;
+	for (size_t i = 0; i < tps.size(); ++i) {
+#ifdef BARRETT_WITH_NUMPY
+		data.append(numpyView(tps[i]->getFullData().data(), 1, dims, self));
+#else
+		data.append(toNumpy(tps[i]->getFullData()));
+#endif
+	}
+	return data;
+}
+
+
+void pythonProductsHandInterface() {
+	scope s = class_<Hand, boost::noncopyable>("Hand", no_init)
+		.def("initialize", &Hand::initialize)
+		.def("idle", &Hand::idle)
+		.def("doneMoving", &Hand::doneMoving, Hand_doneMoving_overloads())
+		.def("waitUntilDoneMoving", &Hand::waitUntilDoneMoving, Hand_waitUntilDoneMoving_overloads())
+		.def("open", Hand_open, Hand_open_overloads())
+		.def("close", Hand_close, Hand_close_overloads())
+		.def("trapezoidalMove", &Hand_trapezoidalMoveArray, Hand_trapezoidalMoveArray_overloads())
+
+		.def("update", &Hand::update, Hand_update_overloads())
+		.def("getInnerLinkPosition", &Hand_getInnerLinkPosition)
+		.def("getOuterLinkPosition", &Hand_getOuterLinkPosition)
+		.def("hasFingertipTorqueSensors", &Hand::hasFingertipTorqueSensors)
+		.def("hasTactSensors", &Hand::hasTactSensors)
+		.def("getTactileData", &Hand_getTactileData)
+	;
+
+	s.attr("DOF") = DOF;
+
+	s.attr("F1") = F1;
+	s.attr("F2") = F2;
+	s.attr("F3") = F3;
+	s.attr("SPREAD") = SPREAD;
+	s.attr("GRASP") = GRASP;
+	s.attr("WHOLE_HAND") = WHOLE_HAND;
+
+	s.attr("S_POSITION") = S_POSITION;
+	s.attr("S_FINGERTIP_TORQUE") = S_FINGERTIP_TORQUE;
+	s.attr("S_TACT_FULL") = S_TACT_FULL;
+	s.attr("S_TACT_TOP10") = S_TACT_TOP10;
+	s.attr("S_ALL") = S_ALL;
+}
@@ -33,9 +33,11 @@
 
 void pythonProductsProductManagerInterface();
 void pythonProductsPuckInterface();
+void pythonProductsHandInterface();
 
 
 void pythonProductsInterface() {
 	pythonProductsProductManagerInterface();
 	pythonProductsPuckInterface();
+	pythonProductsHandInterface();
 }
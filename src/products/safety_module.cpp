@@ -41,6 +41,8 @@
 #include <boost/lexical_cast.hpp>
 
 #include <barrett/os.h>
+#include <barrett/thread/abstract/mutex.h>
+#include <barrett/bus/bus_manager.h>
 #include <barrett/products/puck.h>
 #include <barrett/products/safety_module.h>
 
@@ -49,7 +51,8 @@ namespace barrett {
 
 
 SafetyModule::SafetyModule(Puck* puck) :
-	SpecialPuck(Puck::PT_Safety)
+	SpecialPuck(Puck::PT_Safety), monitoredBus(NULL), modePropId(-1), penPropId(-1),
+	modeRequestPending(false), modeRequestTime(0.0), monitor(this), telemetryBuffer(), telemetry()
 {
 	setPuck(puck);
 
@@ -58,6 +61,55 @@ SafetyModule::SafetyModule(Puck* puck) :
 	setDefaultSafetyLimits();
 }
 
+SafetyModule::~SafetyModule()
+{
+	stopMonitoring();
+}
+
+void SafetyModule::setPuck(Puck* puck)
+{
+	stopMonitoring();
+	SpecialPuck::setPuck(puck);
+	startMonitoring();
+}
+
+void SafetyModule::startMonitoring()
+{
+	assert(monitoredBus == NULL);
+
+	// Don't report what was observed on another Puck's bus.
+	telemetryBuffer = Telemetry();
+	telemetry.write(telemetryBuffer);
+
+	if (p == NULL) {
+		return;
+	}
+	// Pucks only hold a const reference to their bus, but registering an
+	// observer modifies the BusManager.
+	bus::BusManager* bm = dynamic_cast<bus::BusManager*>(
+			const_cast<bus::CommunicationsBus*>(&p->getBus()));
+	if (bm == NULL) {
+		return;
+	}
+
+	modePropId = p->getPropertyIdNoThrow(Puck::MODE);
+	penPropId = p->getPropertyIdNoThrow(Puck::PEN);
+
+	bm->addObserver(Puck::StandardParser::busId(p->getId(), modePropId), &monitor);
+	bm->addObserver(bus::BusManager::SAFETY_MODULE_BROADCAST_BUS_ID, &monitor);
+	monitoredBus = bm;
+	modeRequestPending = false;
+}
+
+void SafetyModule::stopMonitoring()
+{
+	if (monitoredBus != NULL) {
+		// Once this returns, the BusMonitor won't be called again.
+		monitoredBus->removeObserver(&monitor);
+		monitoredBus = NULL;
+	}
+}
+
 enum SafetyModule::SafetyMode SafetyModule::getMode(bool realtime) const {
 	int mode = p->getProperty(Puck::MODE, realtime);
 	if (mode < 0  ||  mode > 2) {
@@ -135,7 +187,18 @@ void SafetyModule::getPendantState(PendantState* ps, bool realtime) const
 	typedef const std::bitset<32> bits_type;
 
 	assert(ps != NULL);
-	int pen = p->getProperty(Puck::PEN);
+	int pen = p->getProperty(Puck::PEN, realtime);
+	if ( !decodePendantState(pen, ps) ) {
+		(logMessage("SafetyModule::%s(): Bad PEN value: %s")
+				% __func__ % bits_type(pen).to_string()).raise<std::runtime_error>();
+	}
+}
+
+bool SafetyModule::decodePendantState(int pen, PendantState* ps)
+{
+	typedef const std::bitset<32> bits_type;
+
+	assert(ps != NULL);
 	bits_type bits(pen);
 
 	if (bits[27]) {
@@ -157,20 +220,132 @@ void SafetyModule::getPendantState(PendantState* ps, bool realtime) const
 	ps->displayedCharacter = (pen >> 16) & 0xff;  // Select bits 16 through 23
 
 	for (int i = 0; i < PendantState::NUM_PARAMS; ++i) {
-		bits_type paramBits((pen >> (3 * i)) & 0x7);  // Select three bits...
-		if (paramBits.count() != 1) {  // exactly one of which should be set.
-			(logMessage("SafetyModule::%s(): Bad PEN value for Parameter %d: %s")
-					% __func__ % i % bits.to_string()).raise<std::runtime_error>();
+		if ( !decodeSafetyParameter(pen, static_cast<enum PendantState::ParameterNames>(i), &ps->safetyParameters[i]) ) {
+			return false;
 		}
+	}
+
+	return true;
+}
+
+bool SafetyModule::decodeSafetyParameter(int pen, enum PendantState::ParameterNames param,
+		enum PendantState::Parameter* state)
+{
+	typedef const std::bitset<3> bits_type;
 
-		if (paramBits[0]) {
-			ps->safetyParameters[i] = PendantState::SAFE;
-		} else if (paramBits[1]) {
-			ps->safetyParameters[i] = PendantState::WARNING;
+	assert(state != NULL);
+	bits_type paramBits((pen >> (3 * param)) & 0x7);  // Select three bits...
+	if (paramBits.count() != 1) {  // exactly one of which should be set.
+		return false;
+	}
+
+	if (paramBits[0]) {
+		*state = PendantState::SAFE;
+	} else if (paramBits[1]) {
+		*state = PendantState::WARNING;
+	} else {
+		*state = PendantState::FAULT;
+	}
+	return true;
+}
+
+bool SafetyModule::getObservedMode(enum SafetyMode* mode, double maxAge_s) const
+{
+	Telemetry t = telemetry.read();
+	if ( !t.modeValid  ||  highResolutionSystemTime() - t.modeTime > maxAge_s) {
+		return false;
+	}
+
+	*mode = t.mode;
+	return true;
+}
+
+void SafetyModule::pollMode(double period_s)
+{
+	if ( !isMonitoringBus()  ||  modePropId < 0 ) {
+		return;
+	}
+
+	double now = highResolutionSystemTime();
+	if (modeRequestPending) {
+		// Receiving the reply passes it to the BusMonitor.
+		int mode;
+		int ret = Puck::receiveGetPropertyReply(p->getBus(), p->getId(), modePropId, &mode, false, true);
+		if (ret == 1  &&  now - modeRequestTime <= bus::CommunicationsBus::TIMEOUT) {
+			return;  // Not here yet
+		}
+		modeRequestPending = false;
+	}
+
+	if (now - modeRequestTime >= period_s) {
+		if (Puck::sendGetPropertyRequest(p->getBus(), p->getId(), modePropId) == 0) {
+			modeRequestPending = true;
+			modeRequestTime = now;
+		}
+	}
+}
+
+void SafetyModule::processProperty(int propId, int value, bool broadcast)
+{
+	double now = highResolutionSystemTime();
+
+	if (broadcast) {
+		++telemetryBuffer.numBroadcasts;
+		telemetryBuffer.broadcastProperty = propId;
+		telemetryBuffer.broadcastValue = value;
+		telemetryBuffer.broadcastTime = now;
+	}
+
+	if (propId == modePropId) {
+		if (value >= ESTOP  &&  value <= ACTIVE) {
+			telemetryBuffer.modeValid = true;
+			telemetryBuffer.mode = static_cast<enum SafetyMode>(value);
+			telemetryBuffer.modeTime = now;
+		}
+	} else if (propId == penPropId) {
+		if (decodePendantState(value, &telemetryBuffer.pendantState)) {
+			telemetryBuffer.pendantStateValid = true;
+			telemetryBuffer.pendantStateTime = now;
 		} else {
-			ps->safetyParameters[i] = PendantState::FAULT;
+			telemetryBuffer.pendantStateValid = false;
 		}
+
+		// Decoded separately so that a malformed field elsewhere in PEN
+		// doesn't hide them.
+		enum PendantState::Parameter velocity, torque;
+		if (decodeSafetyParameter(value, PendantState::VELOCITY, &velocity)  &&
+				decodeSafetyParameter(value, PendantState::TORQUE, &torque)) {
+			telemetryBuffer.limitStatesValid = true;
+			telemetryBuffer.velocityState = velocity;
+			telemetryBuffer.torqueState = torque;
+			telemetryBuffer.limitStatesTime = now;
+		} else {
+			telemetryBuffer.limitStatesValid = false;
+		}
+	} else if ( !broadcast ) {
+		return;
 	}
+
+	telemetry.write(telemetryBuffer);
+}
+
+// Called with the bus mutex held, so calls to processProperty() are serialized.
+void SafetyModule::BusMonitor::messageReceived(int busId, const unsigned char* data, size_t len)
+{
+	// Replies and broadcasts both use the SET format: property, 0, value (LE).
+	if ((len != 4  &&  len != 6)  ||  !(data[0] & Puck::SET_MASK)  ||  data[1] != 0) {
+		return;
+	}
+
+	// Assemble the value unsigned (shifting a negative int is undefined),
+	// starting from all ones if it is negative so that it is sign-extended.
+	unsigned int value = (data[len - 1] & 0x80) ? ~0u : 0u;
+	for (int i = len - 1; i >= 2; --i) {
+		value = (value << 8) | data[i];
+	}
+
+	sm->processProperty(data[0] & Puck::PROPERTY_MASK, static_cast<int>(value),
+			busId == bus::BusManager::SAFETY_MODULE_BROADCAST_BUS_ID);
 }
 
 
@@ -61,8 +61,8 @@ void TactilePuck::setPuck(Puck* puck)
 					% __func__ % id).raise<std::runtime_error>();
 		}
 
-		tact = NONE;
-		p->setProperty(Puck::TACT, tact);
+		setTactState(NONE);
+		inContact = false;
 
 		tare();
 	}
@@ -78,8 +78,7 @@ void TactilePuck::requestFull()
 					% __func__ % ret).raise<std::runtime_error>();
 		}
 	} else {
-		tact = FULL_FORMAT;
-		p->setProperty(Puck::TACT, tact);
+		setTactState(FULL_FORMAT);
 	}
 }
 void TactilePuck::receiveFull(bool realtime)
@@ -93,43 +92,104 @@ void TactilePuck::receiveFull(bool realtime)
 					% __func__ % ret % (i+1) % NFM % id).raise<std::runtime_error>();
 		}
 	}
+	updateContactState();
 }
 
-//void TactilePuck::updateTop10(bool realtime)
-//{
-//	int ret;
-//
-//	if (tact == TOP10_FORMAT) {
-//		ret = Puck::sendGetPropertyRequest(*bus, id, propId);
-//		if (ret != 0) {
-//			(logMessage("TactilePuck::%s(): Failed to send request. "
-//					"Puck::sendGetPropertyRequest() returned error %d.")
-//					% __func__ % ret).raise<std::runtime_error>();
-//		}
-//	} else {
-//		tact = TOP10_FORMAT;
-//		p->setProperty(Puck::TACT, tact);
-//	}
-//
-//	ret = Puck::receiveGetPropertyReply<Top10TactParser>(*bus, id, propId, &top10, true, realtime);
-//	if (ret != 0) {
-//		(logMessage("TactilePuck::%s(): Failed to receive reply. "
-//				"Puck::receiveGetPropertyReply() returned error %d while receiving TOP10 TACT reply from ID=%d.")
-//				% __func__ % ret % id).raise<std::runtime_error>();
-//	}
-//}
+void TactilePuck::requestTop10()
+{
+	if (tact == TOP10_FORMAT) {
+		int ret = Puck::sendGetPropertyRequest(*bus, id, propId);
+		if (ret != 0) {
+			(logMessage("TactilePuck::%s(): Failed to send request. "
+					"Puck::sendGetPropertyRequest() returned error %d.")
+					% __func__ % ret).raise<std::runtime_error>();
+		}
+	} else {
+		setTactState(TOP10_FORMAT);
+	}
+}
+void TactilePuck::receiveTop10(bool realtime)
+{
+	int ret = Puck::receiveGetPropertyReply<Top10TactParser>(*bus, id, propId, &full, true, realtime);
+	if (ret != 0) {
+		(logMessage("TactilePuck::%s(): Failed to receive reply. "
+				"Puck::receiveGetPropertyReply() returned error %d while receiving TOP10 TACT reply from ID=%d.")
+				% __func__ % ret % id).raise<std::runtime_error>();
+	}
+	updateContactState();
+}
+
+void TactilePuck::setMode(enum TactMode newMode, double contactThreshold_, double releaseThreshold_)
+{
+	if (releaseThreshold_ > contactThreshold_) {
+		(logMessage("TactilePuck::%s(): releaseThreshold (%f) must not be greater than contactThreshold (%f).")
+				% __func__ % releaseThreshold_ % contactThreshold_).raise<std::invalid_argument>();
+	}
+
+	mode = newMode;
+	contactThreshold = contactThreshold_;
+	releaseThreshold = releaseThreshold_;
+}
+
+bool TactilePuck::usingTop10() const
+{
+	switch (mode) {
+	case TM_TOP10:
+		return true;
+	case TM_AUTO:
+		return !inContact;
+	default:
+		return false;
+	}
+}
+
+void TactilePuck::request()
+{
+	if (usingTop10()) {
+		requestTop10();
+	} else {
+		requestFull();
+	}
+}
+void TactilePuck::receive(bool realtime)
+{
+	// The format was chosen by the matching request() call
+	if (tact == TOP10_FORMAT) {
+		receiveTop10(realtime);
+	} else {
+		receiveFull(realtime);
+	}
+}
+
+void TactilePuck::setTactState(enum TactState newState)
+{
+	// Changing the TACT property also causes the Puck to send a reading in the
+	// new format, so this doubles as a request.
+	tact = newState;
+	p->setProperty(Puck::TACT, tact);
+}
+
+void TactilePuck::updateContactState()
+{
+	double max = full.maxCoeff();
+	if (inContact) {
+		inContact = max >= releaseThreshold;
+	} else {
+		inContact = max >= contactThreshold;
+	}
+}
 
 
 int TactilePuck::FullTactParser::parse(int id, int propId, result_type* result, const unsigned char* data, size_t len)
 {
 	if (len != 8) {
-		logMessage("%s: expected message length of 8, got message length of %d") % __func__ % len;
+		logMessageRT("%s: expected message length of 8, got message length of %d") % __func__ % len;
 		return 1;
 	}
 
 	size_t i = data[0] >> 4;  // sequence number
 	if (i > NUM_FULL_MESSAGES - 1) {
-		logMessage("%s: invalid sequence number: %d") % __func__ % i;
+		logMessageRT("%s: invalid sequence number: %d") % __func__ % i;
 		return 1;
 	}
 	i *= NUM_SENSORS_PER_FULL_MESSAGE;  // first cell index
@@ -145,5 +205,30 @@ int TactilePuck::FullTactParser::parse(int id, int propId, result_type* result,
     return 0;
 }
 
+int TactilePuck::Top10TactParser::parse(int id, int propId, result_type* result, const unsigned char* data, size_t len)
+{
+	if (len != 8) {
+		logMessageRT("%s: expected message length of 8, got message length of %d") % __func__ % len;
+		return 1;
+	}
+
+	// Bit i of the mask is set if cell i is one of the top ten
+	long mask = ((long)data[0] << 16)  |  ((long)data[1] << 8)  |  (long)data[2];
+
+	size_t n = 0;  // index of the next 4-bit reading
+	for (size_t i = 0; i < NUM_SENSORS; ++i) {
+		if ((mask & (1L << i))  &&  n < NUM_TOP10_VALUES) {
+			int nibble = data[3 + n/2];
+			nibble = (n % 2 == 0) ? ((nibble & 0x00F0) >> 4) : (nibble & 0x000F);
+			(*result)[i] = nibble / TOP10_SCALE_FACTOR;
+			++n;
+		} else {
+			(*result)[i] = 0.0;
+		}
+	}
+
+	return 0;
+}
+
 
 }
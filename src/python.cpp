@@ -45,6 +45,7 @@
 #include <barrett/systems/wam.h>
 
 #include "python.h"
+#include "numpy.h"
 
 
 using namespace barrett;
@@ -63,20 +64,121 @@ bool isWamActivated(ProductManager& pm) {
 
 
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(Wam_gravityCompensate_overloads, gravityCompensate, 0, 1)
+
+// The WAM's state is written by the real-time thread, so the getters return a
+// snapshot (copied in a single block) rather than a view of a live buffer.
+template<size_t DOF>
+object Wam_getJointPositions(const systems::Wam<DOF>& wam) {
+	return toNumpy(wam.getJointPositions());
+}
+template<size_t DOF>
+object Wam_getJointVelocities(const systems::Wam<DOF>& wam) {
+	return toNumpy(wam.getJointVelocities());
+}
+template<size_t DOF>
+object Wam_getJointTorques(const systems::Wam<DOF>& wam) {
+	return toNumpy(wam.getJointTorques());
+}
+template<size_t DOF>
+object Wam_getHomePosition(const systems::Wam<DOF>& wam) {
+	return toNumpy(wam.getHomePosition());
+}
+template<size_t DOF>
+object Wam_getToolPosition(const systems::Wam<DOF>& wam) {
+	return toNumpy(wam.getToolPosition());
+}
+template<size_t DOF>
+object Wam_getToolVelocity(const systems::Wam<DOF>& wam) {
+	return toNumpy(wam.getToolVelocity());
+}
+template<size_t DOF>
+object Wam_getToolJacobian(const systems::Wam<DOF>& wam) {
+	return toNumpy(wam.getToolJacobian());
+}
+
+// Reads the state published by Wam::publishState() without taking the
+// execution manager's mutex. Returns a dict of the State's fields; the tool
+// orientation is given as (w, x, y, z).
+template<size_t DOF>
+dict Wam_getPublishedState(const systems::Wam<DOF>& wam) {
+	typename systems::StateSnapshot<DOF>::State state = wam.getPublishedState();
+	math::Vector<4>::type to;
+	to << state.to.w(), state.to.x(), state.to.y(), state.to.z();
+
+	dict d;
+	d["cycle"] = state.cycle;
+	d["time"] = state.time;
+	d["jp"] = toNumpy(state.jp);
+	d["jv"] = toNumpy(state.jv);
+	d["jt"] = toNumpy(state.jt);
+	d["cp"] = toNumpy(state.cp);
+	d["to"] = toNumpy(to);
+	return d;
+}
+
+// Moves to a joint position given as any sequence of DOF numbers
+template<size_t DOF>
+void Wam_moveTo(systems::Wam<DOF>& wam, object destination, bool blocking = true, double velocity = 0.5, double acceleration = 0.5) {
+	typename systems::Wam<DOF>::jp_type jp;
+	fromNumpy(destination, &jp);
+
+	ScopedGilRelease gr;
+	wam.moveTo(jp, blocking, velocity, acceleration);
+}
+template<size_t DOF>
+void Wam_moveHome(systems::Wam<DOF>& wam, bool blocking = true) {
+	ScopedGilRelease gr;
+	wam.moveHome(blocking);
+}
+template<size_t DOF>
+bool Wam_waitUntilSettled(systems::Wam<DOF>& wam, double velocityThreshold = 0.02, double settleTime = 0.25, double timeout = 5.0) {
+	ScopedGilRelease gr;
+	return wam.waitUntilSettled(velocityThreshold, settleTime, timeout);
+}
+
 template<size_t DOF>
 void wrapWam() {
 	std::string name = "Wam" + boost::lexical_cast<std::string>(DOF);
-	class_<systems::Wam<DOF>, boost::noncopyable>(name.c_str(), no_init)
+	scope s = class_<systems::Wam<DOF>, boost::noncopyable>(name.c_str(), no_init)
 		.def("gravityCompensate", &systems::Wam<DOF>::gravityCompensate,
 				Wam_gravityCompensate_overloads())
+
+		.def("getJointPositions", &Wam_getJointPositions<DOF>)
+		.def("getJointVelocities", &Wam_getJointVelocities<DOF>)
+		.def("getJointTorques", &Wam_getJointTorques<DOF>)
+		.def("getHomePosition", &Wam_getHomePosition<DOF>)
+		.def("getToolPosition", &Wam_getToolPosition<DOF>)
+		.def("getToolVelocity", &Wam_getToolVelocity<DOF>)
+		.def("getToolJacobian", &Wam_getToolJacobian<DOF>)
+
+		.def("moveTo", &Wam_moveTo<DOF>,
+				(arg("destination"), arg("blocking")=true, arg("velocity")=0.5, arg("acceleration")=0.5))
+		.def("moveHome", &Wam_moveHome<DOF>, (arg("blocking")=true))
+		.def("moveIsDone", &systems::Wam<DOF>::moveIsDone)
+		.def("idle", &systems::Wam<DOF>::idle)
+		.def("waitUntilSettled", &Wam_waitUntilSettled<DOF>,
+				(arg("velocityThreshold")=0.02, arg("settleTime")=0.25, arg("timeout")=5.0))
+
+		.def("publishState", &systems::Wam<DOF>::publishState, (arg("publish")=true))
+		.def("isPublishingState", &systems::Wam<DOF>::isPublishingState)
+		.def("getPublishedState", &Wam_getPublishedState<DOF>)
 	;
+
+	s.attr("DOF") = DOF;
 }
 
 
 BOOST_PYTHON_MODULE(libbarrett)
 {
+#ifdef BARRETT_WITH_NUMPY
+	importNumpy();
+#endif
+
 	makeNamespace("bus", pythonBusInterface);
 	pythonProductsInterface();  // The products sub-folder doesn't correspond to a namespace
+#ifdef BARRETT_WITH_NUMPY
+	makeNamespace("log", pythonLogInterface);  // Maps logs as NumPy arrays
+#endif
 
 
 	// WARNING! The python wrappers below are experimental. They are partially
@@ -32,13 +32,29 @@
 #define BARRETT_SRC_PYTHON_H_
 
 
+#include <boost/python.hpp>
+
+
 // These functions do the work of building the python wrappers.
 void pythonBusInterface();
 void pythonProductsInterface();
+void pythonLogInterface();
 
 
 class Namespace {};
 void makeNamespace(const char* name, void(&buildFunction)());
 
 
+// Releases the GIL while in scope, so other Python threads can run while a
+// wrapper blocks. Python objects must not be touched in that scope.
+class ScopedGilRelease {
+public:
+	ScopedGilRelease() : state(PyEval_SaveThread()) {}
+	~ScopedGilRelease() { PyEval_RestoreThread(state); }
+
+private:
+	PyThreadState* state;
+};
+
+
 #endif /* BARRETT_SRC_PYTHON_H_ */
@@ -264,4 +264,26 @@ assert LL.encodeBusId(10, 5) == 0x145
 assert LL.decodeBusId(0x082) == (4, 2)
 assertHasattrs(LL, "GROUP_MASK FROM_MASK TO_MASK SET_MASK PROPERTY_MASK WAKE_UP_TIME TURN_OFF_TIME")
 
+### log (only built if NumPy was found)
+if 'log' in globals():
+	import os, tempfile
+	import numpy
+	assertHasattrs(log, "mapBinaryLog TrajectoryFile")
+
+	dt = numpy.dtype([('t', 'f8'), ('jp', 'f8', 4)])
+	records = numpy.zeros(10, dt)
+	records['t'] = numpy.arange(10) * 0.002
+	records['jp'] = numpy.arange(40).reshape(10, 4)
+	fd, fileName = tempfile.mkstemp()
+	os.close(fd)
+	records.tofile(fileName)
+
+	logData = log.mapBinaryLog(fileName, dt)
+	assert logData.shape == (10,)
+	assert (logData == records).all()
+	assert not logData.flags.writeable
+	shouldRaise(RuntimeError, log.mapBinaryLog, fileName, [('t', 'f8'), ('jp', 'f8', 7)])
+	del logData
+	os.remove(fileName)
+
 print "Success! All tests passed."
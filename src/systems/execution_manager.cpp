@@ -76,8 +76,28 @@ void ExecutionManager::stopManaging(System& sys)
 	sys.unsetDirectExecutionManager();
 }
 
+void ExecutionManager::prefault()
+{
+	BARRETT_SCOPED_LOCK(getMutex());
+
+	// Systems use a fresh token to recognize ones they've already visited.
+	++ut;
+
+	managed_system_list_type::iterator i(managedSystems.begin()), iEnd(managedSystems.end());
+	for (; i != iEnd; ++i) {
+		i->prefaultUpstream(ut);
+	}
+}
+
+void ExecutionManager::setAllocationTracker(barrett::detail::AllocationTracker* at)
+{
+	BARRETT_SCOPED_LOCK(getMutex());
+	allocationTracker = at;
+}
+
 void ExecutionManager::runExecutionCycle() {
 	BARRETT_SCOPED_LOCK(getMutex());
+	barrett::detail::AllocationTracker::CycleScope as(allocationTracker);
 
 	++ut;
 
@@ -0,0 +1,173 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * force_torque_sensor_source.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+#include <cassert>
+
+#include <barrett/os.h>
+#include <barrett/thread/abstract/mutex.h>
+#include <barrett/products/force_torque_sensor.h>
+#include <barrett/systems/force_torque_sensor_source.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+ForceTorqueSensorSource::ForceTorqueSensorSource(ExecutionManager* em,
+		ForceTorqueSensor* _fts, const std::string& sysName) :
+	System(sysName),
+	forceOutput(this, &forceOutputValue),
+	torqueOutput(this, &torqueOutputValue),
+	timeOutput(this, &timeOutputValue),
+	fts(_fts), filtering(false), cfFilter(), ctFilter(),
+	tareSamples(0), tareSamplesRemaining(0),
+	cfBias(0.0), cfSum(0.0), ctBias(0.0), ctSum(0.0),
+	cf(0.0), ct(0.0), time(0.0)
+{
+	assert(fts != NULL);
+
+	// Sample every execution cycle so the filter state and timestamps stay
+	// current even when nothing is connected to the outputs.
+	if (em != NULL) {
+		em->startManaging(*this);
+	}
+
+	getSamplePeriodFromEM();
+}
+
+ForceTorqueSensorSource::~ForceTorqueSensorSource()
+{
+	mandatoryCleanUp();
+}
+
+void ForceTorqueSensorSource::setLowPass(double forceOmega_p, double torqueOmega_p)
+{
+	BARRETT_SCOPED_LOCK(getEmMutex());
+
+	cfFilter.setLowPass(cf_type(forceOmega_p));
+	ctFilter.setLowPass(ct_type(torqueOmega_p));
+	filtering = true;
+}
+
+void ForceTorqueSensorSource::clearLowPass()
+{
+	BARRETT_SCOPED_LOCK(getEmMutex());
+	filtering = false;
+}
+
+void ForceTorqueSensorSource::tare(size_t numSamples)
+{
+	if (numSamples == 0) {
+		(logMessage("ForceTorqueSensorSource::%s(): numSamples must be positive.")
+				% __func__).raise<std::invalid_argument>();
+	}
+
+	BARRETT_SCOPED_LOCK(getEmMutex());
+
+	cfSum.setZero();
+	ctSum.setZero();
+	tareSamples = tareSamplesRemaining = numSamples;
+
+	// Otherwise the filters would start from outputs biased the old way.
+	cfFilter.reset();
+	ctFilter.reset();
+}
+
+void ForceTorqueSensorSource::setBias(const cf_type& forceBias, const ct_type& torqueBias)
+{
+	BARRETT_SCOPED_LOCK(getEmMutex());
+
+	cfBias = forceBias;
+	ctBias = torqueBias;
+	tareSamplesRemaining = 0;
+
+	cfFilter.reset();
+	ctFilter.reset();
+}
+
+void ForceTorqueSensorSource::prefault()
+{
+	// One round trip creates the bus's receive buffer for the sensor.
+	BARRETT_SCOPED_LOCK(fts->getPuck()->getBus().getMutex());
+	fts->update(true);
+}
+
+void ForceTorqueSensorSource::operate()
+{
+	{
+		BARRETT_SCOPED_LOCK(fts->getPuck()->getBus().getMutex());
+		fts->requestUpdate();
+		fts->receiveUpdate(true);
+	}
+	time = highResolutionSystemTime();
+
+	if (tareSamplesRemaining != 0) {
+		cfSum += fts->getForce();
+		ctSum += fts->getTorque();
+
+		if (--tareSamplesRemaining == 0) {
+			cfBias = cfSum / tareSamples;
+			ctBias = ctSum / tareSamples;
+		} else {
+			forceOutputValue->setUndefined();
+			torqueOutputValue->setUndefined();
+			timeOutputValue->setUndefined();
+			return;
+		}
+	}
+
+	if (filtering) {
+		cf = cfFilter.eval(fts->getForce() - cfBias);
+		ct = ctFilter.eval(fts->getTorque() - ctBias);
+	} else {
+		cf = fts->getForce() - cfBias;
+		ct = fts->getTorque() - ctBias;
+	}
+
+	forceOutputValue->setData(&cf);
+	torqueOutputValue->setData(&ct);
+	timeOutputValue->setData(&time);
+}
+
+void ForceTorqueSensorSource::getSamplePeriodFromEM()
+{
+	if (hasExecutionManager()) {
+		assert(getExecutionManager()->getPeriod() > 0.0);
+		cfFilter.setSamplePeriod(getExecutionManager()->getPeriod());
+		ctFilter.setSamplePeriod(getExecutionManager()->getPeriod());
+	} else {
+		cfFilter.setSamplePeriod(0.0);
+		ctFilter.setSamplePeriod(0.0);
+	}
+}
+
+
+}
+}
@@ -0,0 +1,238 @@
+/*
+	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+/*
+ * hand_sensor_scheduler.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+
+#include <barrett/os.h>
+#include <barrett/thread/abstract/mutex.h>
+#include <barrett/products/hand.h>
+#include <barrett/products/tactile_puck.h>
+#include <barrett/systems/hand_sensor_scheduler.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+HandSensorScheduler::HandSensorScheduler(ExecutionManager* em, Hand* _hand,
+		size_t fingertipTorqueDivider, double busTimeBudget_s,
+		const std::string& sysName) :
+	System(sysName),
+	innerJpOutput(this, &innerJpOutputValue),
+	outerJpOutput(this, &outerJpOutputValue),
+	positionTimeOutput(this, &positionTimeOutputValue),
+	fingertipTorqueOutput(this, &fingertipTorqueOutputValue),
+	fingertipTorqueTimeOutput(this, &fingertipTorqueTimeOutputValue),
+	tactOutput(this, &tactOutputValue),
+	tactTimeOutput(this, &tactTimeOutputValue),
+	hand(_hand), busTimeBudget(0.0), schedule(fingertipTorqueDivider), nextPad(0),
+	innerJp(0.0), outerJp(0.0), ftt(0.0), tact(),
+	positionTime(0.0), fttTime(0.0), tactTime(0.0)
+{
+	assert(hand != NULL);
+	setBusTimeBudget(busTimeBudget_s);
+
+	// Update every execution cycle so that slower streams keep their place in
+	// the schedule even when nothing is connected to their outputs.
+	if (em != NULL) {
+		em->startManaging(*this);
+	}
+}
+
+HandSensorScheduler::~HandSensorScheduler()
+{
+	mandatoryCleanUp();
+}
+
+double HandSensorScheduler::defaultBusTimeBudget(double period_s)
+{
+	return std::max(0.0, period_s - frameTime(WAM_FRAMES));
+}
+
+void HandSensorScheduler::setBusTimeBudget(double budget_s)
+{
+	if (budget_s < 0.0) {
+		(logMessage("HandSensorScheduler::%s(): budget_s must not be negative. Got %f.")
+				% __func__ % budget_s).raise<std::invalid_argument>();
+	}
+	busTimeBudget = budget_s;
+}
+
+void HandSensorScheduler::prefault()
+{
+	// Read every stream once so that the first cycle to read each one doesn't
+	// pay for creating its receive buffers.
+	BARRETT_SCOPED_LOCK(hand->getPucks()[0]->getBus().getMutex());
+
+	unsigned int sensors = Hand::S_POSITION;
+	if (hand->hasFingertipTorqueSensors()) {
+		sensors |= Hand::S_FINGERTIP_TORQUE;
+	}
+	hand->update(sensors, true);
+
+	if (hand->hasTactSensors()) {
+		const std::vector<TactilePuck*>& pads = hand->getTactilePucks();
+		for (size_t i = 0; i < pads.size(); ++i) {
+			pads[i]->update(true);
+		}
+	}
+}
+
+void HandSensorScheduler::operate()
+{
+	const std::vector<TactilePuck*>& pads = hand->getTactilePucks();
+
+	double budget = busTimeBudget;
+	if (budget == 0.0  &&  hasExecutionManager()) {
+		budget = defaultBusTimeBudget(getExecutionManager()->getPeriod());
+	}
+
+	// Plan this cycle's traffic. Positions are always read.
+	bool hasTact = hand->hasTactSensors()  &&  pads.size() != 0;
+	bool readFtt, readTact;
+	schedule.next(budget, hand->hasFingertipTorqueSensors(),
+			hasTact ? pads[nextPad]->getNumReplyMessages() : 0, &readFtt, &readTact);
+
+	unsigned int sensors = Hand::S_POSITION;
+	if (readFtt) {
+		sensors |= Hand::S_FINGERTIP_TORQUE;
+	}
+	TactilePuck* pad = readTact ? pads[nextPad] : NULL;
+
+
+	{
+		BARRETT_SCOPED_LOCK(hand->getPucks()[0]->getBus().getMutex());
+
+		// Send all requests before waiting on any replies
+		hand->requestUpdate(sensors);
+		if (pad != NULL) {
+			pad->request();
+		}
+
+		hand->receiveUpdate(sensors, true);
+		double now = highResolutionSystemTime();
+
+		innerJp = hand->getInnerLinkPosition();
+		outerJp = hand->getOuterLinkPosition();
+		positionTime = now;
+
+		if (sensors & Hand::S_FINGERTIP_TORQUE) {
+			const std::vector<int>& sg = hand->getFingertipTorque();
+			for (size_t i = 0; i < DOF; ++i) {
+				ftt[i] = sg[i];
+			}
+			fttTime = now;
+
+			fingertipTorqueOutputValue->setData(&ftt);
+			fingertipTorqueTimeOutputValue->setData(&fttTime);
+		}
+
+		if (pad != NULL) {
+			pad->receive(true);
+			tact.row(nextPad) = pad->getData().transpose();
+			tactTime = highResolutionSystemTime();
+
+			tactOutputValue->setData(&tact);
+			tactTimeOutputValue->setData(&tactTime);
+
+			nextPad = (nextPad + 1) % pads.size();
+		}
+	}
+
+	innerJpOutputValue->setData(&innerJp);
+	outerJpOutputValue->setData(&outerJp);
+	positionTimeOutputValue->setData(&positionTime);
+	// The fingertip torque and tactile outputs stay undefined until their
+	// first read completes.
+}
+
+
+HandSensorScheduler::Schedule::Schedule(size_t fingertipTorqueDivider) :
+	fttDivider(1), cycle(0), fttPending(false), tactFirst(false), numDeferred(0)
+{
+	setFingertipTorqueDivider(fingertipTorqueDivider);
+}
+
+void HandSensorScheduler::Schedule::setFingertipTorqueDivider(size_t divider)
+{
+	if (divider == 0) {
+		(logMessage("HandSensorScheduler::Schedule::%s(): divider must be positive.")
+				% __func__).raise<std::invalid_argument>();
+	}
+	fttDivider = divider;
+}
+
+void HandSensorScheduler::Schedule::next(double budget_s, bool hasFtt, size_t tactFrames,
+		bool* readFtt, bool* readTact)
+{
+	if (hasFtt  &&  cycle % fttDivider == 0) {
+		// If the previous read was deferred, it stays pending.
+		fttPending = true;
+	}
+	++cycle;
+
+	double busTime = frameTime(1 + DOF);
+
+	// Whichever stream was deferred last goes first, so neither starves when
+	// only one of them fits alongside the positions.
+	if (tactFirst) {
+		*readTact = tactFrames != 0  &&  fits(&busTime, 1 + tactFrames, budget_s);
+		*readFtt = fttPending  &&  fits(&busTime, 1 + DOF, budget_s);
+	} else {
+		*readFtt = fttPending  &&  fits(&busTime, 1 + DOF, budget_s);
+		*readTact = tactFrames != 0  &&  fits(&busTime, 1 + tactFrames, budget_s);
+	}
+
+	if (fttPending  &&  !*readFtt) {
+		tactFirst = false;
+	} else if (tactFrames != 0  &&  !*readTact) {
+		tactFirst = true;
+	}
+	if (*readFtt) {
+		fttPending = false;
+	}
+}
+
+bool HandSensorScheduler::Schedule::fits(double* busTime, size_t numFrames, double budget_s)
+{
+	double t = *busTime + frameTime(numFrames);
+	if (t > budget_s) {
+		++numDeferred;
+		return false;
+	}
+	*busTime = t;
+	return true;
+}
+
+
+}
+}
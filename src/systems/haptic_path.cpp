@@ -0,0 +1,300 @@
+/*
+	Copyright 2012 Barrett Technology <support@barrett.com>
+
+	This file is part of libbarrett.
+
+	This version of libbarrett is free software: you can redistribute it
+	and/or modify it under the terms of the GNU General Public License as
+	published by the Free Software Foundation, either version 3 of the
+	License, or (at your option) any later version.
+
+	This version of libbarrett is distributed in the hope that it will be
+	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License along
+	with this version of libbarrett.  If not, see
+	<http://www.gnu.org/licenses/>.
+
+	Further, non-binding information about licensing is available at:
+	<http://wiki.barrett.com/libbarrett/wiki/LicenseNotes>
+*/
+
+
+/*
+ * haptic_path.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+#include <cassert>
+
+#include <barrett/os.h>
+#include <barrett/units.h>
+#include <barrett/math/spline.h>
+#include <barrett/math/utils.h>
+#include <barrett/cdlbt/spline.h>
+#include <barrett/systems/haptic_path.h>
+
+
+namespace barrett {
+namespace systems {
+
+
+HapticPath::HapticPath(const std::vector<cp_type>& path,
+		const std::string& sysName) :
+	HapticObject(sysName),
+	tangentDirectionOutput(this, &tangentDirectionOutputValue),
+	minDist(0.0), minDistSquared(0.0), nearestIndex(0), uNearest(0.0)
+{
+	// Sample the path
+	std::vector<cp_type> coarsePath;
+	cp_type prev = path[0];
+	for (size_t i = 0; i < path.size(); ++i) {
+		if ((path[i] - prev).norm() > COARSE_STEP) {
+			coarsePath.push_back(path[i]);
+			prev = path[i];
+		}
+	}
+	if (coarsePath.size() < 2) {
+		(logMessage("HapticPath::%s(): The path must be longer than %g m.")
+				% __func__ % (2.0 * COARSE_STEP)).raise<std::invalid_argument>();
+	}
+	math::Spline<cp_type> spline(coarsePath);
+
+	// Between knots, each coordinate of the spline is a cubic in s, so four
+	// samples determine it exactly.
+	const double* ss = spline.getImplementation()->ss;
+	segments.resize(coarsePath.size() - 1);
+	for (size_t i = 0; i < segments.size(); ++i) {
+		Segment& seg = segments[i];
+		seg.s0 = spline.initialS() + ss[i];
+		seg.ds = ss[i+1] - ss[i];
+
+		cp_type p0 = spline.eval(seg.s0);
+		cp_type p1 = spline.eval(seg.s0 + seg.ds / 3.0);
+		cp_type p2 = spline.eval(seg.s0 + 2.0 * seg.ds / 3.0);
+		cp_type p3 = spline.eval(seg.s0 + seg.ds);
+		seg.c0 = p0;
+		seg.c1 = (-11.0*p0 + 18.0*p1 -  9.0*p2 + 2.0*p3) / 2.0;
+		seg.c2 = ( 18.0*p0 - 45.0*p1 + 36.0*p2 - 9.0*p3) / 2.0;
+		seg.c3 = ( -9.0*p0 + 27.0*p1 - 27.0*p2 + 9.0*p3) / 2.0;
+
+		// The bounding box includes the ends and any extrema in between.
+		for (size_t j = 0; j < 3; ++j) {
+			seg.lower[j] = std::min(p0[j], p3[j]);
+			seg.upper[j] = std::max(p0[j], p3[j]);
+
+			// Roots of c1 + 2*c2*u + 3*c3*u^2
+			double a = 3.0 * seg.c3[j], b = 2.0 * seg.c2[j], c = seg.c1[j];
+			double roots[2];
+			int numRoots = 0;
+			if (std::fabs(a) < 1e-12) {
+				if (std::fabs(b) > 1e-12) {
+					roots[numRoots++] = -c / b;
+				}
+			} else {
+				double disc = b*b - 4.0*a*c;
+				if (disc >= 0.0) {
+					roots[numRoots++] = (-b + std::sqrt(disc)) / (2.0*a);
+					roots[numRoots++] = (-b - std::sqrt(disc)) / (2.0*a);
+				}
+			}
+			for (int k = 0; k < numRoots; ++k) {
+				if (roots[k] > 0.0  &&  roots[k] < 1.0) {
+					double x = seg.eval(roots[k])[j];
+					seg.lower[j] = std::min(seg.lower[j], x);
+					seg.upper[j] = std::max(seg.upper[j], x);
+				}
+			}
+		}
+	}
+
+	// Build the tree. It has fewer than 2*n nodes, so reserve() prevents
+	// reallocation during buildTree().
+	tree.reserve(2 * segments.size());
+	Node root;
+	root.begin = 0;
+	root.end = segments.size();
+	root.firstChild = 0;
+	tree.push_back(root);
+	buildTree(0);
+}
+
+HapticPath::~HapticPath()
+{
+	mandatoryCleanUp();
+}
+
+void HapticPath::buildTree(size_t node)
+{
+	size_t begin = tree[node].begin;
+	size_t end = tree[node].end;
+
+	if (end - begin <= SEGMENTS_PER_LEAF) {
+		tree[node].firstChild = 0;
+		tree[node].lower = segments[begin].lower;
+		tree[node].upper = segments[begin].upper;
+		for (size_t i = begin + 1; i < end; ++i) {
+			for (size_t j = 0; j < 3; ++j) {
+				tree[node].lower[j] = std::min(tree[node].lower[j], segments[i].lower[j]);
+				tree[node].upper[j] = std::max(tree[node].upper[j], segments[i].upper[j]);
+			}
+		}
+		return;
+	}
+
+	// Consecutive segments are close together, so split by index.
+	size_t first = tree.size();
+	Node child;
+	child.firstChild = 0;
+	child.begin = begin;
+	child.end = begin + (end - begin) / 2;
+	tree.push_back(child);
+	child.begin = child.end;
+	child.end = end;
+	tree.push_back(child);
+	tree[node].firstChild = first;
+
+	buildTree(first);
+	buildTree(first + 1);
+
+	for (size_t j = 0; j < 3; ++j) {
+		tree[node].lower[j] = std::min(tree[first].lower[j], tree[first + 1].lower[j]);
+		tree[node].upper[j] = std::max(tree[first].upper[j], tree[first + 1].upper[j]);
+	}
+}
+
+void HapticPath::operate()
+{
+	const cp_type& cp = input.getValue();
+
+	// Start with the segments around the previous nearest point. The tool
+	// doesn't move far in one cycle, so this bound prunes most of the tree.
+	minDistSquared = std::numeric_limits<double>::max();
+	size_t prevIndex = nearestIndex;
+	size_t end = std::min(prevIndex + 2, segments.size());
+	for (size_t i = (prevIndex > 0) ? prevIndex - 1 : 0; i < end; ++i) {
+		check(i, cp);
+	}
+
+	// Then search the rest of the tree, nearest branches first.
+	size_t stack[MAX_TREE_DEPTH + 1];
+	size_t top = 0;
+	stack[top++] = 0;
+	while (top != 0) {
+		const Node& n = tree[stack[--top]];
+		if (distanceSquaredToBox(n.lower, n.upper, cp) >= minDistSquared) {
+			continue;
+		}
+
+		if (n.firstChild == 0) {
+			for (size_t i = n.begin; i < n.end; ++i) {
+				check(i, cp);
+			}
+		} else {
+			size_t near = n.firstChild;
+			size_t far = n.firstChild + 1;
+			if (distanceSquaredToBox(tree[near].lower, tree[near].upper, cp) >
+					distanceSquaredToBox(tree[far].lower, tree[far].upper, cp)) {
+				std::swap(near, far);
+			}
+
+			assert(top + 2 <= MAX_TREE_DEPTH + 1);
+			stack[top++] = far;
+			stack[top++] = near;
+		}
+	}
+
+	const Segment& seg = segments[nearestIndex];
+	minDist = std::sqrt(minDistSquared);
+	dir = (seg.eval(uNearest) - cp).normalized();
+	tangentDir = seg.evalDerivative(uNearest).normalized();
+
+	depthOutputValue->setData(&minDist);
+	directionOutputValue->setData(&dir);
+	tangentDirectionOutputValue->setData(&tangentDir);
+}
+
+void HapticPath::check(size_t i, const cp_type& cp)
+{
+	double u;
+	double distSquared = project(segments[i], cp, &u);
+	if (distSquared < minDistSquared) {
+		minDistSquared = distSquared;
+		nearestIndex = i;
+		uNearest = u;
+	}
+}
+
+// Returns the squared distance from cp to the nearest point on the segment.
+double HapticPath::project(const Segment& seg, const cp_type& cp, double* uOut) const
+{
+	// Start from the nearest of the ends and the middle.
+	double uStart = 0.0;
+	double startDistSquared = (seg.eval(0.0) - cp).squaredNorm();
+	const double candidates[2] = { 0.5, 1.0 };
+	for (size_t k = 0; k < 2; ++k) {
+		double distSquared = (seg.eval(candidates[k]) - cp).squaredNorm();
+		if (distSquared < startDistSquared) {
+			startDistSquared = distSquared;
+			uStart = candidates[k];
+		}
+	}
+
+	// Newton's method on f(u) = (p(u) - cp) . p'(u), half the derivative of the
+	// squared distance.
+	double u = uStart;
+	for (int k = 0; k < MAX_NEWTON_ITERATIONS; ++k) {
+		cp_type r = seg.eval(u) - cp;
+		cp_type d1 = seg.evalDerivative(u);
+
+		double f = r.dot(d1);
+		double fPrime = d1.dot(d1) + r.dot(seg.evalSecondDerivative(u));
+		if (fPrime <= 0.0) {
+			fPrime = d1.dot(d1);  // Not locally convex: take a Gauss-Newton step.
+			if (fPrime <= 0.0) {
+				break;
+			}
+		}
+
+		double next = math::saturate(u - f / fPrime, 0.0, 1.0);
+		if (std::fabs(next - u) < 1e-12) {
+			break;
+		}
+		u = next;
+	}
+
+	double distSquared = (seg.eval(u) - cp).squaredNorm();
+	if (distSquared > startDistSquared) {
+		u = uStart;
+		distSquared = startDistSquared;
+	}
+
+	*uOut = u;
+	return distSquared;
+}
+
+double HapticPath::distanceSquaredToBox(const cp_type& lower, const cp_type& upper, const cp_type& cp)
+{
+	double distSquared = 0.0;
+	for (size_t j = 0; j < 3; ++j) {
+		if (cp[j] < lower[j]) {
+			distSquared += (lower[j] - cp[j]) * (lower[j] - cp[j]);
+		} else if (cp[j] > upper[j]) {
+			distSquared += (cp[j] - upper[j]) * (cp[j] - upper[j]);
+		}
+	}
+	return distSquared;
+}
+
+
+}
+}
@@ -56,18 +56,21 @@ namespace systems {
 // TODO(dc): test!
 
 
-RealTimeExecutionManager::RealTimeExecutionManager(double period_s, int rt_priority) :
+RealTimeExecutionManager::RealTimeExecutionManager(double period_s, int rt_priority, int cpu) :
 	ExecutionManager(period_s),
-	thread(), priority(rt_priority), running(false), error(false), errorStr(), errorCallback()
+	thread(), priority(rt_priority), cpuAffinity(cpu), running(false), error(false), errorStr(), errorCallback()
 {
 	init();
 }
 
 RealTimeExecutionManager::RealTimeExecutionManager(const libconfig::Setting& setting) :
 	ExecutionManager(setting),
-	thread(), priority(), running(false), error(false), errorStr(), errorCallback()
+	thread(), priority(), cpuAffinity(-1), running(false), error(false), errorStr(), errorCallback()
 {
 	priority = setting["thread_priority"];
+	if (setting.exists("cpu_affinity")) {
+		cpuAffinity = setting["cpu_affinity"];
+	}
 	init();
 }
 
@@ -142,10 +145,15 @@ void RealTimeExecutionManager::executionLoopEntryPoint()
 	uint32_t loopCount = 0;
 	uint32_t overruns = 0;
 	uint32_t missedReleasePoints = 0;
+	uint32_t firstCycle = 0;
 
-	PeriodicLoopTimer loopTimer(period, priority);
+	PeriodicLoopTimer loopTimer(period, priority, cpuAffinity);
 	running = true;
 	try {
+		// Give Systems a chance to fault in memory and bus buffers before the
+		// first cycle rather than during it.
+		prefault();
+
 		while (true) {
 			// Explicit interruption point
 			boost::this_thread::interruption_point();
@@ -164,6 +172,9 @@ void RealTimeExecutionManager::executionLoopEntryPoint()
 			}
 			sum += duration;
 			sumSq += duration * duration;
+			if (loopCount == 0) {
+				firstCycle = duration;
+			}
 			++loopCount;
 			if (duration > period_us) {
 				++overruns;
@@ -192,6 +203,7 @@ void RealTimeExecutionManager::executionLoopEntryPoint()
     logMessage("  min = %u") % min;
     logMessage("  ave = %.3f") % mean;
     logMessage("  max = %u") % max;
+    logMessage("  first cycle = %u") % firstCycle;
     logMessage("  stdev = %.3f") % stdev;
     logMessage("  num total cycles = %u") % loopCount;
     logMessage("  num missed release points = %u") % missedReleasePoints;
@@ -31,6 +31,7 @@
  */
 
 
+#include <barrett/detail/allocation_tracker.h>
 #include <barrett/systems/abstract/execution_manager.h>
 #include <barrett/systems/abstract/system.h>
 
@@ -65,6 +66,7 @@ void System::update(update_token_type updateToken)
 	}
 
 	if (inputsValid()) {
+		barrett::detail::AllocationTracker::SystemScope as(this);
 		operate();
 	} else {
 		invalidateOutputs();
@@ -154,6 +156,27 @@ void System::unsetExecutionManager()
 	}
 }
 
+void System::prefaultUpstream(update_token_type prefaultToken)
+{
+	// Visit each System once, even if several managed Systems pull from it
+	if (prefaultToken == prefaultUt) {
+		return;
+	}
+	prefaultUt = prefaultToken;
+
+	child_input_list_type::iterator i(inputs.begin()), iEnd(inputs.end());
+	for (; i != iEnd; ++i) {
+		i->prefaultUpstream(prefaultToken);
+	}
+
+	child_output_list_type::iterator o(outputs.begin()), oEnd(outputs.end());
+	for (; o != oEnd; ++o) {
+		o->prefaultUpstream(prefaultToken);
+	}
+
+	prefault();
+}
+
 
 System::AbstractInput::AbstractInput(System* parent) : parentSys(parent)
 {
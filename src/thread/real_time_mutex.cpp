@@ -41,15 +41,7 @@
 #ifdef BARRETT_XENOMAI
 	#include "real_time_mutex_impl-xenomai.cpp"
 #else
-	#include <boost/thread/recursive_mutex.hpp>
-
-	namespace barrett {
-	namespace thread {
-	namespace detail {
-		class mutex_impl : public boost::recursive_mutex {};
-	}
-	}
-	}
+	#include "real_time_mutex_impl-posix.cpp"
 #endif
 
 
@@ -57,8 +49,11 @@ namespace barrett {
 namespace thread {
 
 
+const size_t RealTimeMutex::MAX_LOCK_SITES;
+
 RealTimeMutex::RealTimeMutex() :
-	mutex(NULL), lockCount(0)
+	mutex(NULL), lockCount(0),
+	collectStats(false), numSites(0), numUntrackedLocks(0), holdSite(NULL), holdStart(0.0)
 {
 	mutex = new detail::mutex_impl;
 }
@@ -71,14 +66,34 @@ RealTimeMutex::~RealTimeMutex()
 
 void RealTimeMutex::lock()
 {
-	mutex->lock();
+	if ( !collectStats ) {
+		mutex->lock();
+		++lockCount;
+		return;
+	}
+
+	const void* site = __builtin_return_address(0);
+	bool contended = !mutex->try_lock();
+	double waitTime = 0.0;
+	if (contended) {
+		double start = highResolutionSystemTime();
+		mutex->lock();
+		waitTime = highResolutionSystemTime() - start;
+	}
+
 	++lockCount;
+	if (lockCount == 1) {
+		beginHold(site, contended, waitTime);
+	}
 }
 
 bool RealTimeMutex::try_lock()
 {
 	if (mutex->try_lock()) {
 		++lockCount;
+		if (collectStats  &&  lockCount == 1) {
+			beginHold(__builtin_return_address(0), false, 0.0);
+		}
 		return true;
 	} else {
 		return false;
@@ -87,6 +102,9 @@ bool RealTimeMutex::try_lock()
 
 void RealTimeMutex::unlock()
 {
+	if (lockCount == 1) {
+		endHold();
+	}
 	--lockCount;
 	mutex->unlock();
 }
@@ -98,20 +116,123 @@ int RealTimeMutex::fullUnlock()
 		(logMessage("thread::RealTimeMutex::%s Bad lockCount value.  lockCount = %d") %__func__ %lc).raise<std::logic_error>();
 	}
 
-	while (lockCount > 1) {
-		unlock();
-	}
-	unlock();
+	endHold();
+	lockCount = 0;
+	mutex->fullUnlock();
 
 	return lc;
 }
 
 void RealTimeMutex::relock(int lc)
+{
+	if ( !collectStats ) {
+		mutex->relock(lc);
+		lockCount = lc;
+		return;
+	}
+
+	const void* site = __builtin_return_address(0);
+	bool contended = !mutex->try_relock(lc);
+	double waitTime = 0.0;
+	if (contended) {
+		double start = highResolutionSystemTime();
+		mutex->relock(lc);
+		waitTime = highResolutionSystemTime() - start;
+	}
+
+	lockCount = lc;
+	beginHold(site, contended, waitTime);
+}
+
+
+// The statistics are only modified while the mutex is held.
+
+void RealTimeMutex::enableStatistics(bool enable)
+{
+	lock();
+	collectStats = enable;
+	holdSite = NULL;  // Don't record the hold time of this call
+	unlock();
+}
+
+void RealTimeMutex::resetStatistics()
 {
 	lock();
-	while (lockCount != lc) {
-		lock();
+	numSites = 0;
+	numUntrackedLocks = 0;
+	holdSite = NULL;
+	unlock();
+}
+
+void RealTimeMutex::logStatistics(const char* name) const
+{
+	logMessage("thread::RealTimeMutex \"%s\" contention stats (microseconds):") % name;
+	for (size_t i = 0; i < numSites; ++i) {
+		const LockSiteStats& s = sites[i];
+		logMessage("  site %p: locks = %lu, contended = %lu, wait ave/max = %.3f/%.3f, hold ave/max = %.3f/%.3f")
+				% s.site % s.numLocks % s.numContended
+				% (s.numContended == 0 ? 0.0 : 1e6 * s.totalWaitTime / s.numContended) % (1e6 * s.maxWaitTime)
+				% (s.numLocks == 0 ? 0.0 : 1e6 * s.totalHoldTime / s.numLocks) % (1e6 * s.maxHoldTime);
+	}
+	if (numUntrackedLocks != 0) {
+		logMessage("  %lu locks from more than %d sites weren't recorded")
+				% numUntrackedLocks % MAX_LOCK_SITES;
+	}
+}
+
+RealTimeMutex::LockSiteStats* RealTimeMutex::findSite(const void* site)
+{
+	for (size_t i = 0; i < numSites; ++i) {
+		if (sites[i].site == site) {
+			return &sites[i];
+		}
+	}
+
+	if (numSites == MAX_LOCK_SITES) {
+		// Table is full. Merging this site into another entry would corrupt
+		// that entry's statistics, so just count it.
+		++numUntrackedLocks;
+		return NULL;
+	}
+
+	LockSiteStats* s = &sites[numSites++];
+	s->site = site;
+	s->numLocks = s->numContended = 0;
+	s->totalWaitTime = s->maxWaitTime = 0.0;
+	s->totalHoldTime = s->maxHoldTime = 0.0;
+	return s;
+}
+
+void RealTimeMutex::beginHold(const void* site, bool contended, double waitTime)
+{
+	holdSite = findSite(site);
+	if (holdSite == NULL) {
+		return;
+	}
+
+	++holdSite->numLocks;
+	if (contended) {
+		++holdSite->numContended;
+		holdSite->totalWaitTime += waitTime;
+		if (waitTime > holdSite->maxWaitTime) {
+			holdSite->maxWaitTime = waitTime;
+		}
+	}
+	holdStart = highResolutionSystemTime();
+}
+
+void RealTimeMutex::endHold()
+{
+	if (holdSite == NULL) {
+		return;
+	}
+
+	double holdTime = highResolutionSystemTime() - holdStart;
+	holdSite->totalHoldTime += holdTime;
+	if (holdTime > holdSite->maxHoldTime) {
+		holdSite->maxHoldTime = holdTime;
 	}
+	holdSite = NULL;
 }
 
 
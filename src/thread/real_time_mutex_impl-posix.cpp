@@ -0,0 +1,168 @@
+/**
+ *	Copyright 2009-2014 Barrett Technology <support@barrett.com>
+ *
+ *	This file is part of libbarrett.
+ *
+ *	This version of libbarrett is free software: you can redistribute it
+ *	and/or modify it under the terms of the GNU General Public License as
+ *	published by the Free Software Foundation, either version 3 of the
+ *	License, or (at your option) any later version.
+ *
+ *	This version of libbarrett is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License along
+ *	with this version of libbarrett.  If not, see
+ *	<http://www.gnu.org/licenses/>.
+ *
+ *
+ *	Barrett Technology Inc.
+ *	73 Chapel Street
+ *	Newton, MA 02458
+ *
+ */
+
+/*
+ * real_time_mutex_impl-posix.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cstring>
+
+#include <pthread.h>
+
+#include <boost/thread/exceptions.hpp>
+
+#include <barrett/detail/ca_macro.h>
+#include <barrett/os.h>
+
+
+namespace barrett {
+namespace thread {
+namespace detail {
+
+
+// A recursive mutex built on a non-recursive, priority-inheriting pthread
+// mutex. Recursion is tracked here rather than by the pthread mutex so that
+// fullUnlock() and relock() are constant-time: the underlying mutex is only
+// ever held once.
+class mutex_impl {
+public:
+	mutex_impl() :
+		depth(0), owner()
+	{
+		pthread_mutexattr_t attr;
+		pthread_mutexattr_init(&attr);
+		pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_NORMAL);
+
+		int ret = pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+		if (ret != 0) {
+			logMessage("thread::detail::mutex_impl::%s: WARNING: No priority inheritance: (%d) %s")
+					% __func__ % ret % strerror(ret);
+		}
+
+		ret = pthread_mutex_init(&m, &attr);
+		pthread_mutexattr_destroy(&attr);
+		if (ret != 0) {
+			(logMessage("thread::detail::mutex_impl::%s: Could not create pthread mutex: (%d) %s")
+					% __func__ % ret % strerror(ret)).raise<std::logic_error>();
+		}
+	}
+
+	~mutex_impl() {
+		int ret = pthread_mutex_destroy(&m);
+		if (ret != 0) {
+			// Don't throw exceptions from a dtor!
+			logMessage("thread::detail::mutex_impl::%s: Could not destroy pthread mutex: (%d) %s")
+					% __func__ % ret % strerror(ret);
+		}
+	}
+
+	void lock() {
+		if (ownedByCaller()) {
+			++depth;
+			return;
+		}
+
+		int ret = pthread_mutex_lock(&m);
+		if (ret != 0) {
+			logMessage("thread::detail::mutex_impl::lock(): pthread_mutex_lock() returned %d") % ret;
+			throw boost::thread_resource_error(ret);
+		}
+		acquired(1);
+	}
+
+	bool try_lock() {
+		if (ownedByCaller()) {
+			++depth;
+			return true;
+		}
+
+		if (pthread_mutex_trylock(&m) != 0) {
+			return false;
+		}
+		acquired(1);
+		return true;
+	}
+
+	void unlock() {
+		if (--depth == 0) {
+			release();
+		}
+	}
+
+	void fullUnlock() {
+		depth = 0;
+		release();
+	}
+
+	void relock(int lc) {
+		lock();
+		depth = lc;
+	}
+
+	bool try_relock(int lc) {
+		if ( !try_lock() ) {
+			return false;
+		}
+		depth = lc;
+		return true;
+	}
+
+protected:
+	// Only the owning thread ever sets owner to its own ID, and it clears owner
+	// before releasing m, so a thread can only see its own ID here while it
+	// holds m.
+	bool ownedByCaller() const {
+		return pthread_equal(owner, pthread_self());
+	}
+
+	void acquired(int d) {
+		owner = pthread_self();
+		depth = d;
+	}
+
+	void release() {
+		owner = pthread_t();
+		int ret = pthread_mutex_unlock(&m);
+		if (ret != 0) {
+			(logMessage("thread::detail::mutex_impl::%s: Could not release pthread mutex: (%d) %s")
+					% __func__ % ret % strerror(ret)).raise<std::logic_error>();
+		}
+	}
+
+	pthread_mutex_t m;
+	int depth;
+	pthread_t owner;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(mutex_impl);
+};
+
+
+}
+}
+}
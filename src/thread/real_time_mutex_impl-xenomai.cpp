@@ -96,6 +96,29 @@ public:
 		}
 	}
 
+	// RT_MUTEXes are recursive, so these can't do better than one call per level.
+	void fullUnlock() {
+		while (lockCount > 0) {
+			unlock();
+		}
+	}
+
+	void relock(int lc) {
+		for (int i = 0; i < lc; ++i) {
+			lock();
+		}
+	}
+
+	bool try_relock(int lc) {
+		if ( !try_lock() ) {
+			return false;
+		}
+		for (int i = 1; i < lc; ++i) {
+			lock();
+		}
+		return true;
+	}
+
 protected:
 	int acquireWrapper(bool blocking)
 	{
@@ -0,0 +1,93 @@
+/*
+ * shared_memory.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <string>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <barrett/os.h>
+#include <barrett/thread/shared_memory.h>
+
+
+namespace barrett {
+namespace thread {
+
+
+SharedMemory::SharedMemory(const std::string& name_, size_t size_, bool create, bool replace, mode_t mode) :
+	name(name_), size(size_), owner(create), addr(MAP_FAILED)
+{
+	// POSIX requires a leading slash for portable names.
+	if (name.empty()  ||  name[0] != '/') {
+		name = "/" + name;
+	}
+
+	int fd;
+	if (create) {
+		if (replace) {
+			shm_unlink(name.c_str());
+		}
+		fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, mode);
+	} else {
+		fd = shm_open(name.c_str(), O_RDWR, 0);
+	}
+	if (fd == -1) {
+		if (create  &&  errno == EEXIST) {
+			(logMessage("thread::SharedMemory::%s(): Shared memory segment \"%s\" already exists. "
+					"If it was left behind by a crashed process, ask to replace it.")
+					% __func__ % name).raise<std::runtime_error>();
+		}
+		(logMessage("thread::SharedMemory::%s(): Could not open shared memory segment \"%s\": (%d) %s")
+				% __func__ % name % errno % strerror(errno)).raise<std::runtime_error>();
+	}
+
+	struct stat st;
+	if (create) {
+		if (ftruncate(fd, size) != 0) {
+			int err = errno;
+			::close(fd);
+			shm_unlink(name.c_str());
+			(logMessage("thread::SharedMemory::%s(): Could not size shared memory segment \"%s\": (%d) %s")
+					% __func__ % name % err % strerror(err)).raise<std::runtime_error>();
+		}
+	} else if (fstat(fd, &st) != 0  ||  static_cast<size_t>(st.st_size) < size) {
+		::close(fd);
+		(logMessage("thread::SharedMemory::%s(): Shared memory segment \"%s\" is smaller than %d bytes.")
+				% __func__ % name % size).raise<std::runtime_error>();
+	}
+
+	addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);  // The mapping stays valid after the descriptor is closed.
+	if (addr == MAP_FAILED) {
+		int err = errno;
+		if (owner) {
+			shm_unlink(name.c_str());
+		}
+		(logMessage("thread::SharedMemory::%s(): Could not map shared memory segment \"%s\": (%d) %s")
+				% __func__ % name % err % strerror(err)).raise<std::runtime_error>();
+	}
+
+	// Fault in (and keep in RAM) the pages now rather than in the execution cycle.
+	mlock(addr, size);
+}
+
+SharedMemory::~SharedMemory()
+{
+	munmap(addr, size);
+	if (owner) {
+		shm_unlink(name.c_str());
+	}
+}
+
+
+}
+}
@@ -0,0 +1,163 @@
+/*
+ * trajectory_file.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <vector>
+#include <stdexcept>
+
+#include <boost/tuple/tuple.hpp>
+#include <Eigen/Geometry>
+
+#include <gtest/gtest.h>
+#include <barrett/units.h>
+#include <barrett/log/writer.h>
+#include <barrett/log/trajectory_file.h>
+#include <barrett/log/trajectory_writer.h>
+
+
+namespace {
+using namespace barrett;
+
+const size_t DOF = 3;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+typedef boost::tuple<double, jp_type> jp_sample_type;
+typedef boost::tuple<double, cp_type> cp_sample_type;
+typedef boost::tuple<double, Eigen::Quaterniond> q_sample_type;
+
+
+class TrajectoryFileTest : public ::testing::Test {
+public:
+	TrajectoryFileTest() {
+		std::strcpy(tmpFile, "/tmp/btXXXXXX");
+		EXPECT_TRUE(mkstemp(tmpFile) != -1);
+	}
+	~TrajectoryFileTest() {
+		std::remove(tmpFile);
+	}
+
+protected:
+	char tmpFile[14];
+};
+
+
+TEST_F(TrajectoryFileTest, WriterOutputLoadsWithoutConversion) {
+	const size_t N = 1500;  // More than one of the writer's buffers
+	{
+		log::TrajectoryWriter<jp_sample_type> tw(tmpFile, 0.002);
+		jp_type jp;
+		for (size_t i = 0; i < N; ++i) {
+			jp << i, -0.5*i, std::sin(i * 0.01);
+			tw.putRecord(boost::make_tuple(i * 0.002, jp));
+		}
+		tw.close();
+	}
+
+	EXPECT_TRUE(log::TrajectoryFile::isTrajectoryFile(tmpFile));
+	log::TrajectoryFile tf(tmpFile);
+	EXPECT_EQ(log::TrajectoryFile::JOINT_POSITIONS, tf.getSampleType());
+	EXPECT_EQ(DOF, tf.getWidth());
+	EXPECT_EQ(0.002, tf.getRecordPeriod());
+	ASSERT_EQ(N, tf.numRecords());
+
+	std::vector<jp_sample_type, Eigen::aligned_allocator<jp_sample_type> > samples;
+	tf.getJointPositions(&samples);
+	ASSERT_EQ(N, samples.size());
+	for (size_t i = 0; i < N; ++i) {
+		EXPECT_EQ(i * 0.002, boost::get<0>(samples[i]));
+		EXPECT_EQ(i, boost::get<1>(samples[i])[0]);
+		EXPECT_EQ(-0.5*i, boost::get<1>(samples[i])[1]);
+		EXPECT_EQ(std::sin(i * 0.01), boost::get<1>(samples[i])[2]);
+	}
+}
+
+TEST_F(TrajectoryFileTest, WrongSampleTypeThrows) {
+	{
+		log::TrajectoryWriter<jp_sample_type> tw(tmpFile, 0.002);
+		tw.putRecord(boost::make_tuple(0.0, jp_type(0.0)));
+		tw.close();
+	}
+	log::TrajectoryFile tf(tmpFile);
+
+	typedef boost::tuple<double, units::JointPositions<4>::type> jp4_sample_type;
+	std::vector<jp4_sample_type, Eigen::aligned_allocator<jp4_sample_type> > jp4;
+	EXPECT_THROW(tf.getJointPositions(&jp4), std::logic_error);
+
+	std::vector<cp_sample_type, Eigen::aligned_allocator<cp_sample_type> > cp;
+	std::vector<q_sample_type, Eigen::aligned_allocator<q_sample_type> > q;
+	EXPECT_THROW(tf.getPoses(&cp, &q), std::logic_error);
+}
+
+TEST_F(TrajectoryFileTest, ConvertsPoseCSV) {
+	char csvFile[] = "/tmp/btXXXXXX";
+	ASSERT_TRUE(mkstemp(csvFile) != -1);
+	{
+		std::ofstream ofs(csvFile);
+		ofs << "pose_type\n";
+		ofs << "0,0.1,0.2,0.3,1,0,0,0\n";
+		ofs << "0.002,0.4,0.5,0.6,0.5,0.5,-0.5,0.5\n";
+	}
+	log::TrajectoryFile::convertCSV(csvFile, tmpFile);
+	std::remove(csvFile);
+
+	log::TrajectoryFile tf(tmpFile);
+	EXPECT_EQ(log::TrajectoryFile::POSE, tf.getSampleType());
+
+	std::vector<cp_sample_type, Eigen::aligned_allocator<cp_sample_type> > cp;
+	std::vector<q_sample_type, Eigen::aligned_allocator<q_sample_type> > q;
+	tf.getPoses(&cp, &q);
+	ASSERT_EQ(2u, cp.size());
+	ASSERT_EQ(2u, q.size());
+
+	EXPECT_EQ(0.002, boost::get<0>(cp[1]));
+	EXPECT_EQ(0.002, boost::get<0>(q[1]));
+	EXPECT_EQ(0.6, boost::get<1>(cp[1])[2]);
+	EXPECT_EQ(1.0, boost::get<1>(q[0]).w());
+	EXPECT_EQ(0.5, boost::get<1>(q[1]).w());
+	EXPECT_EQ(-0.5, boost::get<1>(q[1]).y());
+}
+
+TEST_F(TrajectoryFileTest, MalformedCSVThrows) {
+	char csvFile[] = "/tmp/btXXXXXX";
+	ASSERT_TRUE(mkstemp(csvFile) != -1);
+	{
+		std::ofstream ofs(csvFile);
+		ofs << "jp_type\n";
+		ofs << "0,1,2,3\n";
+		ofs << "0.002,1,2\n";
+	}
+	EXPECT_THROW(log::TrajectoryFile::convertCSV(csvFile, tmpFile), std::runtime_error);
+	std::remove(csvFile);
+}
+
+TEST_F(TrajectoryFileTest, RejectsOtherFiles) {
+	{
+		log::Writer<jp_sample_type> lw(tmpFile);
+		lw.putRecord(boost::make_tuple(0.0, jp_type(0.0)));
+		lw.putRecord(boost::make_tuple(1.0, jp_type(1.0)));
+		lw.close();
+	}
+	EXPECT_FALSE(log::TrajectoryFile::isTrajectoryFile(tmpFile));
+	EXPECT_THROW(log::TrajectoryFile tf(tmpFile), std::runtime_error);
+
+	EXPECT_THROW(log::TrajectoryFile tf("/tmp/this/file/does/not/exist"), std::runtime_error);
+}
+
+TEST_F(TrajectoryFileTest, RejectsPartialRecords) {
+	{
+		std::ofstream ofs(tmpFile, std::ios_base::binary);
+		log::TrajectoryFile::writeHeader(ofs, log::TrajectoryFile::JOINT_POSITIONS, DOF);
+		double record[DOF + 1] = { 0.0, 1.0, 2.0, 3.0 };
+		ofs.write(reinterpret_cast<const char*>(record), sizeof(record) - 1);
+	}
+	EXPECT_TRUE(log::TrajectoryFile::isTrajectoryFile(tmpFile));
+	EXPECT_THROW(log::TrajectoryFile tf(tmpFile), std::runtime_error);
+}
+
+
+}
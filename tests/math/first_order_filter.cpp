@@ -43,6 +43,16 @@ TEST_F(FirstOrderFilterTest, TimeStepCtor) {
 	EXPECT_EQ(T_s, f(1.0));
 }
 
+TEST_F(FirstOrderFilterTest, Reset) {
+	f.setIntegrator();
+	for (int i = 0; i < 10; ++i) {
+		f(1.0);
+	}
+
+	f.reset();
+	EXPECT_NEAR(T_s, f(1.0), ERR);
+}
+
 TEST_F(FirstOrderFilterTest, SetSamplePeriod) {
 	int i;
 	f.setIntegrator();
@@ -0,0 +1,198 @@
+/*
+ * gravity_calibrator.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+#include <vector>
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <Eigen/LU>
+
+#include <barrett/units.h>
+#include <barrett/math/gravity_calibrator.h>
+
+
+namespace {
+using namespace barrett;
+
+
+const size_t DOF = 4;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+typedef math::GravityCalibrator<DOF> calibrator_type;
+
+
+// A repeatable pseudo-random number in [-1, 1)
+double noise(unsigned int* seed) {
+	*seed = *seed * 1103515245 + 12345;
+	return ((*seed >> 16) % 2000) / 1000.0 - 1.0;
+}
+
+Eigen::Vector3d randomVector(unsigned int* seed) {
+	return Eigen::Vector3d(noise(seed), noise(seed), noise(seed));
+}
+
+// Adds numPoses random (but non-degenerate) poses
+void addRandomPoses(calibrator_type* gc, size_t numPoses, unsigned int* seed) {
+	calibrator_type::gravity_type g[DOF];
+	calibrator_type::rotation_type R[DOF];
+	jt_type jt;
+	for (size_t p = 0; p < numPoses; ++p) {
+		for (size_t j = 0; j < DOF; ++j) {
+			g[j] = 9.81 * randomVector(seed).normalized();
+			R[j] = Eigen::AngleAxisd(M_PI * noise(seed), randomVector(seed).normalized()).toRotationMatrix();
+			jt[j] = 10.0 * noise(seed);
+		}
+		gc->addPose(jt, g, R);
+	}
+}
+
+// The original formulation: for each link, a dense regularized least-squares
+// problem in mu and every pose's lateral forces.
+void denseSolve(const std::vector<jt_type>& jts,
+		const std::vector<std::vector<Eigen::Vector3d> >& gs,
+		const std::vector<std::vector<Eigen::Matrix3d> >& Rs,
+		double lambda, calibrator_type::mu_type mus[DOF]) {
+	const int P = jts.size();
+	Eigen::VectorXd next = Eigen::VectorXd::Zero(3 + 2*P);
+
+	for (int j = DOF - 1; j >= 0; --j) {
+		Eigen::MatrixXd GT = Eigen::MatrixXd::Zero(3*P, 3 + 2*P);
+		Eigen::VectorXd b(3*P);
+		for (int p = 0; p < P; ++p) {
+			const Eigen::Vector3d& g = gs[p][j];
+			const Eigen::Matrix3d& R = Rs[p][j];
+			GT(3*p + 0, 1) = -g[2];
+			GT(3*p + 0, 2) = g[1];
+			GT(3*p + 1, 0) = g[2];
+			GT(3*p + 1, 2) = -g[0];
+			GT(3*p + 2, 0) = -g[1];
+			GT(3*p + 2, 1) = g[0];
+			for (int r = 0; r < 3; ++r) {
+				GT(3*p + r, 3 + 2*p + 0) = -R(0,r);
+				GT(3*p + r, 3 + 2*p + 1) = -R(1,r);
+				b[3*p + r] = jts[p][j] * R(2,r);
+			}
+			if (j < (int)DOF - 1) {
+				b[3*p + 0] -= next[3 + 2*p + 0];
+				b[3*p + 1] -= next[3 + 2*p + 1];
+				b[3*p + 2] -= jts[p][j + 1];
+			}
+		}
+
+		Eigen::MatrixXd A = GT.transpose() * GT + lambda * Eigen::MatrixXd::Identity(3 + 2*P, 3 + 2*P);
+		next = A.inverse() * (GT.transpose() * b);
+		mus[j] << next[0], next[1], next[2];
+	}
+}
+
+
+TEST(GravityCalibratorTest, RunningStatistics) {
+	calibrator_type gc;
+	EXPECT_EQ(0u, gc.numSamples());
+
+	unsigned int seed = 1;
+	std::vector<jt_type> jts;
+	std::vector<jp_type> jps;
+	for (size_t i = 0; i < 2000; ++i) {
+		jt_type jt;
+		jp_type jp;
+		for (size_t j = 0; j < DOF; ++j) {
+			jt[j] = 3.0 + 0.1 * noise(&seed);
+			jp[j] = -1.0 + 0.001 * noise(&seed);
+		}
+		jts.push_back(jt);
+		jps.push_back(jp);
+		gc.addSample(jt, jp);
+	}
+	EXPECT_EQ(jts.size(), gc.numSamples());
+
+	// Two-pass mean and (population) variance
+	jt_type meanJt(0.0), varJt(0.0);
+	jp_type meanJp(0.0), varJp(0.0);
+	for (size_t i = 0; i < jts.size(); ++i) {
+		meanJt += jts[i] / jts.size();
+		meanJp += jps[i] / jps.size();
+	}
+	for (size_t i = 0; i < jts.size(); ++i) {
+		for (size_t j = 0; j < DOF; ++j) {
+			varJt[j] += (jts[i][j] - meanJt[j]) * (jts[i][j] - meanJt[j]) / jts.size();
+			varJp[j] += (jps[i][j] - meanJp[j]) * (jps[i][j] - meanJp[j]) / jps.size();
+		}
+	}
+
+	jt_type gcVarJt = gc.getTorqueVariance();
+	jp_type gcVarJp = gc.getPositionVariance();
+	for (size_t j = 0; j < DOF; ++j) {
+		EXPECT_NEAR(meanJt[j], gc.getMeanTorque()[j], 1e-12);
+		EXPECT_NEAR(meanJp[j], gc.getMeanPosition()[j], 1e-12);
+		EXPECT_NEAR(varJt[j], gcVarJt[j], 1e-12);
+		EXPECT_NEAR(varJp[j], gcVarJp[j], 1e-15);
+	}
+
+	gc.resetMeasurement();
+	EXPECT_EQ(0u, gc.numSamples());
+	EXPECT_EQ(0.0, gc.getTorqueVariance().norm());
+}
+
+TEST(GravityCalibratorTest, MatchesDenseSolve) {
+	const double lambda = 1e-6;
+	const size_t numPoses = 12;
+	calibrator_type gc(lambda);
+
+	unsigned int seed = 7;
+	addRandomPoses(&gc, numPoses, &seed);
+	EXPECT_EQ(numPoses, gc.numPoses());
+
+	// Regenerate the same poses for the reference solution.
+	seed = 7;
+	std::vector<jt_type> jts(numPoses);
+	std::vector<std::vector<Eigen::Vector3d> > gs(numPoses, std::vector<Eigen::Vector3d>(DOF));
+	std::vector<std::vector<Eigen::Matrix3d> > Rs(numPoses, std::vector<Eigen::Matrix3d>(DOF));
+	for (size_t p = 0; p < numPoses; ++p) {
+		for (size_t j = 0; j < DOF; ++j) {
+			gs[p][j] = 9.81 * randomVector(&seed).normalized();
+			Rs[p][j] = Eigen::AngleAxisd(M_PI * noise(&seed), randomVector(&seed).normalized()).toRotationMatrix();
+			jts[p][j] = 10.0 * noise(&seed);
+		}
+	}
+
+	calibrator_type::mu_type mus[DOF], expected[DOF];
+	gc.solve(mus);
+	denseSolve(jts, gs, Rs, lambda, expected);
+	for (size_t j = 0; j < DOF; ++j) {
+		EXPECT_NEAR(0.0, (mus[j] - expected[j]).norm(), 1e-8 * (1.0 + expected[j].norm()))
+			<< "link " << j;
+	}
+}
+
+TEST(GravityCalibratorTest, ManyPoses) {
+	calibrator_type gc;
+	unsigned int seed = 3;
+	addRandomPoses(&gc, 1000, &seed);
+
+	calibrator_type::mu_type mus[DOF];
+	gc.solve(mus);
+	for (size_t j = 0; j < DOF; ++j) {
+		EXPECT_TRUE(mus[j] == mus[j]);  // Not NaN
+	}
+
+	gc.clearPoses();
+	EXPECT_EQ(0u, gc.numPoses());
+}
+
+TEST(GravityCalibratorTest, InvalidArgumentsThrow) {
+	EXPECT_THROW(calibrator_type(-1.0), std::invalid_argument);
+
+	calibrator_type gc;
+	calibrator_type::mu_type mus[DOF];
+	EXPECT_THROW(gc.solve(mus), std::logic_error);
+}
+
+
+}
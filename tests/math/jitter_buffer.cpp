@@ -0,0 +1,142 @@
+/*
+ * jitter_buffer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <barrett/units.h>
+#include <barrett/math/jitter_buffer.h>
+
+
+namespace {
+using namespace barrett;
+
+const size_t DOF = 2;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+// The receiver's clock is OFFSET seconds ahead of the sender's, and the
+// network delay is at least DELAY seconds.
+const double OFFSET = 100.0;
+const double DELAY = 0.001;
+const double T_s = 0.002;
+
+
+TEST(JitterBufferTest, Empty) {
+	math::JitterBuffer<double> jb;
+	double x = 5.0;
+	EXPECT_EQ(0u, jb.size());
+	EXPECT_FALSE(jb.eval(1.0, &x));
+	EXPECT_EQ(5.0, x);
+}
+
+TEST(JitterBufferTest, InterpolatesBehindThePlayoutDelay) {
+	math::JitterBuffer<double> jb(2 * T_s);
+	for (uint32_t i = 0; i < 10; ++i) {
+		EXPECT_TRUE(jb.add(i, i * T_s, i * T_s + OFFSET + DELAY, 10.0 * i));
+	}
+	EXPECT_DOUBLE_EQ(OFFSET + DELAY, jb.getBaseTransit());
+	EXPECT_DOUBLE_EQ(0.0, jb.getJitter());
+
+	// Halfway between samples 6 and 7
+	double x;
+	ASSERT_TRUE(jb.eval(8.5 * T_s + OFFSET + DELAY, &x));
+	EXPECT_NEAR(65.0, x, 1e-9);
+
+	// Older than the buffer
+	ASSERT_TRUE(jb.eval(OFFSET - 1.0, &x));
+	EXPECT_EQ(10.0 * (10 - jb.size()), x);
+}
+
+TEST(JitterBufferTest, ExtrapolatesThenHolds) {
+	math::JitterBuffer<jp_type> jb(0.0, 1.5 * T_s);
+	jp_type slope;
+	slope << 1.0, -2.0;
+	for (uint32_t i = 0; i < 3; ++i) {
+		jb.add(i, i * T_s, i * T_s + OFFSET + DELAY, slope * i);
+	}
+
+	jp_type jp;
+	ASSERT_TRUE(jb.eval(3 * T_s + OFFSET + DELAY, &jp));
+	EXPECT_NEAR(3.0, jp[0], 1e-9);
+	EXPECT_NEAR(-6.0, jp[1], 1e-9);
+
+	ASSERT_TRUE(jb.eval(10 * T_s + OFFSET + DELAY, &jp));
+	EXPECT_NEAR(3.5, jp[0], 1e-9);
+	EXPECT_NEAR(-7.0, jp[1], 1e-9);
+}
+
+TEST(JitterBufferTest, DelayedSamplesDontMoveThePlayback) {
+	math::JitterBuffer<double> jb(4 * T_s);
+	double extra[] = { 0.0, 0.003, 0.0005, 0.0, 0.002, 0.0, 0.001, 0.0 };
+	for (uint32_t i = 0; i < 8; ++i) {
+		jb.add(i, i * T_s, i * T_s + OFFSET + DELAY + extra[i], 1.0 * i);
+	}
+	EXPECT_DOUBLE_EQ(OFFSET + DELAY, jb.getBaseTransit());
+	EXPECT_GT(jb.getJitter(), 0.0);
+
+	double x;
+	ASSERT_TRUE(jb.eval(7 * T_s + OFFSET + DELAY, &x));
+	EXPECT_NEAR(3.0, x, 1e-9);
+}
+
+TEST(JitterBufferTest, CountsLostAndLateSamples) {
+	math::JitterBuffer<double> jb;
+	EXPECT_TRUE(jb.add(1, 1.0, 1.0, 1.0));
+	EXPECT_TRUE(jb.add(4, 4.0, 4.0, 4.0));
+	EXPECT_EQ(2u, jb.getNumLost());
+
+	// 3 arrives late, so it isn't lost after all.
+	EXPECT_FALSE(jb.add(3, 3.0, 4.5, 3.0));
+	EXPECT_FALSE(jb.add(4, 4.0, 4.5, 4.0));
+	EXPECT_EQ(1u, jb.getNumLost());
+	EXPECT_EQ(2u, jb.getNumLate());
+	EXPECT_EQ(2u, jb.size());
+
+	// Sequence numbers wrap.
+	jb.reset();
+	EXPECT_TRUE(jb.add(0xffffffff, 1.0, 1.0, 1.0));
+	EXPECT_TRUE(jb.add(1, 2.0, 2.0, 2.0));
+	EXPECT_EQ(1u, jb.getNumLost());
+	EXPECT_EQ(0u, jb.getNumLate());
+}
+
+TEST(JitterBufferTest, SenderRestarts) {
+	math::JitterBuffer<double> jb;
+	for (uint32_t i = 0; i < 500; ++i) {
+		jb.add(i, i * T_s, i * T_s + OFFSET + DELAY, 1.0);
+	}
+
+	// Within MAX_MISORDER of the newest sample, it's just late.
+	EXPECT_FALSE(jb.add(400, 0.0, 500 * T_s + OFFSET + DELAY, 2.0));
+	EXPECT_EQ(1u, jb.getNumLate());
+
+	// The sender restarts (with a different clock).
+	for (uint32_t i = 0; i < 3; ++i) {
+		EXPECT_TRUE(jb.add(i, 50.0 + i * T_s, (500 + i) * T_s + OFFSET + DELAY, 3.0));
+	}
+	EXPECT_EQ(3u, jb.size());
+	EXPECT_EQ(1u, jb.getNumLate());
+	EXPECT_DOUBLE_EQ(500 * T_s + OFFSET + DELAY - 50.0, jb.getBaseTransit());
+
+	double x;
+	ASSERT_TRUE(jb.eval(502 * T_s + OFFSET + DELAY, &x));
+	EXPECT_EQ(3.0, x);
+
+	// restart() does the same for any sequence number.
+	jb.restart();
+	EXPECT_EQ(0u, jb.size());
+	EXPECT_TRUE(jb.add(1, 1.0, 1.0, 1.0));
+	EXPECT_EQ(1u, jb.getNumLate());
+}
+
+TEST(JitterBufferTest, InvalidArgumentsThrow) {
+	EXPECT_THROW(math::JitterBuffer<double>(-1.0), std::invalid_argument);
+	EXPECT_THROW(math::JitterBuffer<double>(0.0, -1.0), std::invalid_argument);
+}
+
+
+}
@@ -0,0 +1,148 @@
+/*
+ * s_curve_profile.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <barrett/units.h>
+#include <barrett/math/s_curve_profile.h>
+#include <barrett/math/trapezoidal_velocity_profile.h>
+
+
+namespace {
+using namespace barrett;
+
+
+const double T_s = 1e-4;
+const double ERR = 1e-9;
+
+
+// Samples the profile and checks that it is monotonic, continuous, and
+// within its limits.
+void checkProfile(const math::SCurveProfile& p) {
+	const double tol = 1e-6;
+
+	EXPECT_EQ(0.0, p.eval(0.0));
+	EXPECT_NEAR(p.getPathLength(), p.eval(p.finalT()), ERR);
+	EXPECT_EQ(p.getPathLength(), p.eval(p.finalT() + 1.0));
+
+	double s_1 = 0.0, sdd_1 = 0.0;
+	for (double t = T_s; t < p.finalT() + 2*T_s; t += T_s) {
+		double s = p.eval(t);
+		double sd = p.evalDerivative(t);
+		double sdd = p.evalSecondDerivative(t);
+
+		EXPECT_GE(s, s_1);
+		EXPECT_LE(sd, p.getVelocity() + tol);
+		EXPECT_LE(std::fabs(sdd), p.getAcceleration() + tol);
+		EXPECT_LE(std::fabs(sdd - sdd_1), p.getJerk() * T_s + tol);
+		EXPECT_NEAR(sd, (s - s_1) / T_s, p.getAcceleration() * T_s + tol);
+
+		s_1 = s;
+		sdd_1 = sdd;
+	}
+}
+
+
+TEST(SCurveProfileTest, ReachesAllLimits) {
+	double v = 1.0, a = 2.0, j = 10.0, l = 3.0;
+	math::SCurveProfile p(v, a, j, l);
+	checkProfile(p);
+
+	// Accelerating to v takes v/a + a/j; decelerating takes the same.
+	EXPECT_NEAR(l/v + v/a + a/j, p.finalT(), ERR);
+	EXPECT_NEAR(v, p.evalDerivative(p.finalT() / 2.0), ERR);
+}
+
+TEST(SCurveProfileTest, DoesNotReachAccelerationLimit) {
+	double v = 1.0, a = 5.0, j = 10.0, l = 3.0;
+	math::SCurveProfile p(v, a, j, l);
+	checkProfile(p);
+
+	double T_j = std::sqrt(v/j);
+	EXPECT_NEAR(l/v + 2.0*T_j, p.finalT(), ERR);
+}
+
+TEST(SCurveProfileTest, DoesNotReachVelocityLimit) {
+	double v = 10.0, a = 1.0, j = 10.0, l = 0.5;
+	math::SCurveProfile p(v, a, j, l);
+	checkProfile(p);
+
+	EXPECT_LT(p.evalDerivative(p.finalT() / 2.0), v);
+	EXPECT_NEAR(l/2.0, p.eval(p.finalT() / 2.0), ERR);
+}
+
+TEST(SCurveProfileTest, DoesNotReachAnyLimit) {
+	double v = 10.0, a = 10.0, j = 1.0, l = 0.25;
+	math::SCurveProfile p(v, a, j, l);
+	checkProfile(p);
+
+	// l = 2 * j * T_j^3
+	double T_j = std::pow(l / (2.0*j), 1.0/3.0);
+	EXPECT_NEAR(4.0*T_j, p.finalT(), ERR);
+}
+
+TEST(SCurveProfileTest, ZeroLength) {
+	math::SCurveProfile p(1.0, 1.0, 1.0, 0.0);
+	EXPECT_EQ(0.0, p.finalT());
+	EXPECT_EQ(0.0, p.eval(0.0));
+	EXPECT_EQ(0.0, p.eval(1.0));
+	EXPECT_EQ(0.0, p.evalDerivative(1.0));
+}
+
+TEST(SCurveProfileTest, InvalidLimitsThrow) {
+	EXPECT_THROW(math::SCurveProfile(0.0, 1.0, 1.0, 1.0), std::invalid_argument);
+	EXPECT_THROW(math::SCurveProfile(1.0, -1.0, 1.0, 1.0), std::invalid_argument);
+	EXPECT_THROW(math::SCurveProfile(1.0, 1.0, 0.0, 1.0), std::invalid_argument);
+	EXPECT_THROW(math::SCurveProfile(1.0, 1.0, 1.0, -1.0), std::invalid_argument);
+}
+
+TEST(SCurveProfileTest, NoSlowerThanTrapezoidPlusRampTime) {
+	double v = 0.5, a = 0.5, j = 5.0;
+	for (double l = 0.01; l < 4.0; l *= 1.7) {
+		math::SCurveProfile s(v, a, j, l);
+		math::TrapezoidalVelocityProfile t(v, a, 0.0, l);
+		EXPECT_GE(s.finalT(), t.finalT() - ERR);
+		if (s.evalDerivative(s.finalT() / 2.0) >= v - ERR) {
+			EXPECT_LE(s.finalT(), t.finalT() + a/j + ERR);
+		} else {
+			EXPECT_LE(s.finalT(), t.finalT() + 2.0*a/j + ERR);
+		}
+	}
+}
+
+TEST(SCurveProfileTest, MultiDofLimits) {
+	const size_t DOF = 3;
+	BARRETT_UNITS_TYPEDEFS(DOF);
+
+	jp_type d, v, a, j;
+	d << 1.0, -0.5, 0.0;
+	v << 0.5, 0.1, 0.01;
+	a << 1.0, 1.0, 0.01;
+	j << 10.0, 10.0, 0.01;
+
+	math::SCurveProfile p(d, v, a, j);
+	EXPECT_NEAR(d.norm(), p.getPathLength(), ERR);
+	checkProfile(p);
+
+	// Every DOF respects its own limits, and the tightest one is reached.
+	double maxSpeed[DOF] = { 0.0, 0.0, 0.0 };
+	for (double t = 0.0; t < p.finalT(); t += 1e-3) {
+		for (size_t i = 0; i < DOF; ++i) {
+			double speed = std::fabs(d[i]) / p.getPathLength() * p.evalDerivative(t);
+			EXPECT_LE(speed, v[i] + ERR);
+			maxSpeed[i] = std::max(maxSpeed[i], speed);
+		}
+	}
+	EXPECT_NEAR(v[1], maxSpeed[1], 1e-6);
+	EXPECT_NEAR(0.0, maxSpeed[2], ERR);
+	EXPECT_NEAR(v[1] * std::fabs(d[0] / d[1]), maxSpeed[0], 1e-6);
+}
+
+
+}
@@ -9,6 +9,7 @@
 #include <iostream>
 #include <vector>
 #include <boost/tuple/tuple.hpp>
+#include <Eigen/Geometry>
 
 #include <gtest/gtest.h>
 
@@ -169,4 +170,81 @@ TEST(SplineTest, NoSaturateCtor) {
 }
 
 
+class QuaternionSplineTest : public ::testing::Test {
+public:
+	QuaternionSplineTest() {
+		// Unevenly spaced samples of a rotation that changes axis
+		double s[] = { 0.0, 0.3, 0.5, 1.2, 1.4, 2.0 };
+		for (size_t i = 0; i < sizeof(s)/sizeof(s[0]); ++i) {
+			Eigen::Quaterniond q(Eigen::AngleAxisd(s[i], Eigen::Vector3d::UnitZ())
+					* Eigen::AngleAxisd(0.5 * s[i]*s[i], Eigen::Vector3d::UnitX()));
+			if (i % 2 == 1) {
+				q.coeffs() = -q.coeffs();  // The same orientation
+			}
+			samples.push_back(boost::make_tuple(s[i], q));
+		}
+	}
+
+protected:
+	typedef math::Spline<Eigen::Quaterniond>::tuple_type tuple_type;
+	std::vector<tuple_type, Eigen::aligned_allocator<tuple_type> > samples;
+};
+
+TEST_F(QuaternionSplineTest, PassesThroughSamples) {
+	math::Spline<Eigen::Quaterniond> spline(samples);
+	EXPECT_EQ(0.0, spline.initialS());
+	EXPECT_EQ(2.0, spline.finalS());
+
+	for (size_t i = 0; i < samples.size(); ++i) {
+		EXPECT_NEAR(0.0, spline.eval(boost::get<0>(samples[i])).angularDistance(boost::get<1>(samples[i])), 1e-9);
+	}
+	EXPECT_NEAR(0.0, spline.eval(-1.0).angularDistance(boost::get<1>(samples.front())), 1e-9);
+	EXPECT_NEAR(0.0, spline.eval(3.0).angularDistance(boost::get<1>(samples.back())), 1e-9);
+}
+
+TEST_F(QuaternionSplineTest, AngularVelocityIsContinuous) {
+	math::Spline<Eigen::Quaterniond> spline(samples);
+
+	const double h = 1e-6;
+	for (size_t i = 1; i < samples.size() - 1; ++i) {
+		double s = boost::get<0>(samples[i]);
+		Eigen::Quaterniond q = spline.eval(s);
+
+		// Angular velocity just before and just after the sample
+		Eigen::AngleAxisd before(q * spline.eval(s - h).conjugate());
+		Eigen::AngleAxisd after(spline.eval(s + h) * q.conjugate());
+		Eigen::Vector3d wBefore = before.axis() * before.angle() / h;
+		Eigen::Vector3d wAfter = after.axis() * after.angle() / h;
+		EXPECT_NEAR(0.0, (wBefore - wAfter).norm(), 1e-4 * wAfter.norm());
+	}
+}
+
+TEST_F(QuaternionSplineTest, BatchAndRandomAccessMatchSequential) {
+	math::Spline<Eigen::Quaterniond> spline(samples);
+
+	const size_t N = 300;
+	const double ds = 0.01;
+	std::vector<double> s(N);
+	for (size_t i = 0; i < N; ++i) {
+		s[i] = -0.5 + i*ds;
+	}
+	std::vector<Eigen::Quaterniond, Eigen::aligned_allocator<Eigen::Quaterniond> > batch(N);
+	spline.eval(s.begin(), s.end(), batch.begin());
+
+	std::vector<Eigen::Quaterniond, Eigen::aligned_allocator<Eigen::Quaterniond> > sequential;
+	for (size_t i = 0; i < N; ++i) {
+		sequential.push_back(spline.eval(-0.5 + i*ds));
+	}
+	for (size_t i = 0; i < N; ++i) {
+		EXPECT_TRUE(batch[i].isApprox(sequential[i]));
+	}
+
+	// Jump around
+	for (size_t i = 0; i < N; ++i) {
+		size_t j = (i * 7919) % N;
+		EXPECT_TRUE(spline.eval(-0.5 + j*ds).isApprox(sequential[j]));
+	}
+}
+
+
 }
@@ -0,0 +1,194 @@
+/*
+ * trajectory_simplifier.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include <boost/tuple/tuple.hpp>
+#include <Eigen/Geometry>
+
+#include <gtest/gtest.h>
+#include <barrett/units.h>
+#include <barrett/math/spline.h>
+#include <barrett/math/trajectory_simplifier.h>
+
+
+namespace {
+using namespace barrett;
+
+const size_t DOF = 3;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+typedef boost::tuple<double, jp_type> jp_sample_type;
+typedef std::vector<jp_sample_type, Eigen::aligned_allocator<jp_sample_type> > jp_vector;
+typedef boost::tuple<double, cp_type> cp_sample_type;
+typedef std::vector<cp_sample_type, Eigen::aligned_allocator<cp_sample_type> > cp_vector;
+typedef boost::tuple<double, Eigen::Quaterniond> q_sample_type;
+typedef std::vector<q_sample_type, Eigen::aligned_allocator<q_sample_type> > q_vector;
+
+const double T_s = 0.002;
+
+
+// The largest distance between a sample and a math::Spline through the knots
+template<typename Container>
+double maxDeviation(const Container& samples, const Container& knots) {
+	math::Spline<typename boost::tuples::element<1, typename Container::value_type>::type> spline(knots);
+	double maxDev = 0.0;
+	for (size_t i = 0; i < samples.size(); ++i) {
+		maxDev = std::max(maxDev,
+				(boost::get<1>(samples[i]) - spline.eval(boost::get<0>(samples[i]))).norm());
+	}
+	return maxDev;
+}
+
+double maxAngularDeviation(const q_vector& samples, const q_vector& knots) {
+	math::Spline<Eigen::Quaterniond> spline(knots);
+	double maxDev = 0.0;
+	for (size_t i = 0; i < samples.size(); ++i) {
+		maxDev = std::max(maxDev,
+				spline.eval(boost::get<0>(samples[i])).angularDistance(boost::get<1>(samples[i])));
+	}
+	return maxDev;
+}
+
+
+TEST(TrajectorySimplifierTest, ConstantVelocityNeedsOnlyEndpoints) {
+	jp_vector samples, knots;
+	jp_type jp;
+	for (size_t i = 0; i < 1000; ++i) {
+		jp << 0.001*i, -0.002*i, 0.5;
+		samples.push_back(boost::make_tuple(i * T_s, jp));
+	}
+
+	math::simplifyTrajectory(samples, 1e-6, &knots);
+	ASSERT_EQ(2u, knots.size());
+	EXPECT_EQ(boost::get<0>(samples.front()), boost::get<0>(knots.front()));
+	EXPECT_EQ(boost::get<0>(samples.back()), boost::get<0>(knots.back()));
+}
+
+TEST(TrajectorySimplifierTest, PreservesTiming) {
+	// Moves, then holds still. The path is a straight line, but the timing
+	// needs a knot where the motion stops.
+	jp_vector samples, knots;
+	jp_type jp(0.0);
+	for (size_t i = 0; i <= 1000; ++i) {
+		jp[0] = std::min(i, (size_t)500) * 0.001;
+		samples.push_back(boost::make_tuple(i * T_s, jp));
+	}
+
+	const double tol = 1e-6;
+	math::simplifyTrajectory(samples, tol, &knots);
+	EXPECT_LT(knots.size(), samples.size() / 10);
+	bool keptStop = false;
+	for (size_t i = 0; i < knots.size(); ++i) {
+		keptStop = keptStop  ||  boost::get<0>(knots[i]) == boost::get<0>(samples[500]);
+	}
+	EXPECT_TRUE(keptStop);
+	EXPECT_LE(maxDeviation(samples, knots), tol);
+}
+
+TEST(TrajectorySimplifierTest, SplineDoesntOvershootSharpTurnsAndPauses) {
+	// Straight moves joined by corners and pauses. The chords between the
+	// corners are exact, but a spline through only the corners rings.
+	jp_vector samples, knots;
+	jp_type jp(0.0), v(0.0);
+	double t = 0.0;
+	for (int leg = 0; leg < 8; ++leg) {
+		v[leg % DOF] = (leg % 2 == 0) ? 0.5 : -0.25;
+		for (size_t i = 0; i < 500; ++i) {
+			samples.push_back(boost::make_tuple(t, jp));
+			jp += v * T_s;
+			t += T_s;
+		}
+		v.setConstant(0.0);
+		for (size_t i = 0; i < 250 * (leg % 3); ++i) {
+			samples.push_back(boost::make_tuple(t, jp));
+			t += T_s;
+		}
+	}
+	samples.push_back(boost::make_tuple(t, jp));
+
+	const double tol = 1e-3;
+	math::simplifyTrajectory(samples, tol, &knots);
+	EXPECT_LT(knots.size(), samples.size() / 10);
+	EXPECT_LE(maxDeviation(samples, knots), tol);
+}
+
+TEST(TrajectorySimplifierTest, DeviationIsBounded) {
+	jp_vector samples, knots;
+	jp_type jp;
+	for (size_t i = 0; i < 20000; ++i) {
+		double t = i * T_s;
+		jp << std::sin(t), 0.5 * std::cos(2.0*t), 0.1 * t;
+		samples.push_back(boost::make_tuple(t, jp));
+	}
+
+	const double tol = 1e-3;
+	math::simplifyTrajectory(samples, tol, &knots);
+	EXPECT_LT(knots.size(), samples.size() / 20);
+	EXPECT_LE(maxDeviation(samples, knots), tol);
+
+	// A tighter tolerance keeps more knots.
+	jp_vector tightKnots;
+	math::simplifyTrajectory(samples, tol / 10.0, &tightKnots);
+	EXPECT_GT(tightKnots.size(), knots.size());
+	EXPECT_LE(maxDeviation(samples, tightKnots), tol / 10.0);
+}
+
+TEST(TrajectorySimplifierTest, PoseKeepsOrientationChanges) {
+	// The tool holds its position but turns, faster and faster.
+	cp_vector positions, cpKnots;
+	q_vector orientations, qKnots;
+	cp_type cp;
+	cp << 0.5, 0.0, 0.3;
+	for (size_t i = 0; i < 2000; ++i) {
+		double t = i * T_s;
+		positions.push_back(boost::make_tuple(t, cp));
+		orientations.push_back(boost::make_tuple(t,
+				Eigen::Quaterniond(Eigen::AngleAxisd(0.5 * t*t, Eigen::Vector3d::UnitZ()))));
+	}
+
+	const double tol = 1e-3;
+	math::simplifyTrajectory(positions, orientations, 1e-4, tol, &cpKnots, &qKnots);
+	ASSERT_EQ(cpKnots.size(), qKnots.size());
+	EXPECT_GT(qKnots.size(), 2u);
+	EXPECT_LT(qKnots.size(), orientations.size() / 20);
+
+	for (size_t i = 0; i < qKnots.size(); ++i) {
+		EXPECT_EQ(boost::get<0>(cpKnots[i]), boost::get<0>(qKnots[i]));
+	}
+	EXPECT_LE(maxDeviation(positions, cpKnots), 1e-4);
+	EXPECT_LE(maxAngularDeviation(orientations, qKnots), tol);
+}
+
+TEST(TrajectorySimplifierTest, InvalidArgumentsThrow) {
+	jp_vector samples, knots;
+	EXPECT_THROW(math::simplifyTrajectory(samples, -1.0, &knots), std::invalid_argument);
+
+	cp_vector positions(2), cpKnots;
+	q_vector orientations(1), qKnots;
+	EXPECT_THROW(math::simplifyTrajectory(positions, orientations, 1e-3, 1e-3, &cpKnots, &qKnots),
+			std::invalid_argument);
+}
+
+TEST(TrajectorySimplifierTest, ShortTrajectoriesAreUnchanged) {
+	jp_vector samples, knots;
+	math::simplifyTrajectory(samples, 1e-3, &knots);
+	EXPECT_TRUE(knots.empty());
+
+	samples.push_back(boost::make_tuple(0.0, jp_type(0.0)));
+	math::simplifyTrajectory(samples, 1e-3, &knots);
+	EXPECT_EQ(1u, knots.size());
+
+	samples.push_back(boost::make_tuple(T_s, jp_type(1.0)));
+	math::simplifyTrajectory(samples, 1e-3, &knots);
+	EXPECT_EQ(2u, knots.size());
+}
+
+
+}
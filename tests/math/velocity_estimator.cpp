@@ -0,0 +1,111 @@
+/*
+ * velocity_estimator.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+#include <barrett/units.h>
+#include <barrett/math/velocity_estimator.h>
+
+
+namespace {
+using namespace barrett;
+
+
+const size_t DOF = 2;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+const double T_s = 0.002;
+const double ERR = 1e-6;
+
+
+// Samples jp(t) = p0 + v*t + a*t^2/2 with a slightly uneven sample period.
+template<typename Estimator>
+void runTrajectory(Estimator& e, double a, size_t n, jv_type* jv, double* tFinal) {
+	jp_type jp;
+	double t = 0.0;
+	for (size_t i = 0; i <= n; ++i) {
+		t = i*T_s + ((i % 3 == 0) ? 0.2*T_s : 0.0);
+		jp << 1.0 + 0.5*t + a*t*t/2.0, -0.3*t;
+		if (i == 0) {
+			e.reset(jp, t);
+		} else {
+			e.update(jp, t);
+		}
+	}
+	*jv = e.getVelocity();
+	*tFinal = t;
+}
+
+
+TEST(VelocityEstimatorTest, FiniteDifferenceRamp) {
+	math::FiniteDifferenceVelocityEstimator<DOF> e;
+	jv_type jv;
+	double t;
+
+	runTrajectory(e, 0.0, 10, &jv, &t);
+	EXPECT_NEAR(0.5, jv[0], ERR);
+	EXPECT_NEAR(-0.3, jv[1], ERR);
+}
+
+TEST(VelocityEstimatorTest, FiniteDifferenceNominalPeriod) {
+	math::FiniteDifferenceVelocityEstimator<DOF> e(T_s);
+	jp_type jp(0.0);
+
+	e.reset(jp, 1.0);
+	jp.setConstant(T_s);
+	e.update(jp, 1.0);  // Same timestamp: fall back to the nominal period
+	EXPECT_NEAR(1.0, e.getVelocity()[0], ERR);
+}
+
+TEST(VelocityEstimatorTest, LeastSquaresLinearRamp) {
+	math::LeastSquaresVelocityEstimator<DOF, 7> e(1);
+	jv_type jv;
+	double t;
+
+	runTrajectory(e, 0.0, 20, &jv, &t);
+	EXPECT_NEAR(0.5, jv[0], ERR);
+	EXPECT_NEAR(-0.3, jv[1], ERR);
+}
+
+TEST(VelocityEstimatorTest, LeastSquaresQuadraticIsExactForConstantAcceleration) {
+	math::LeastSquaresVelocityEstimator<DOF, 7> e(2);
+	jv_type jv;
+	double t;
+
+	runTrajectory(e, 4.0, 20, &jv, &t);
+	EXPECT_NEAR(0.5 + 4.0*t, jv[0], 1e-5);
+	EXPECT_NEAR(-0.3, jv[1], 1e-5);
+}
+
+TEST(VelocityEstimatorTest, LeastSquaresBadOrderThrows) {
+	EXPECT_THROW((math::LeastSquaresVelocityEstimator<DOF, 2>(2)), std::invalid_argument);
+	EXPECT_THROW((math::LeastSquaresVelocityEstimator<DOF, 5>(3)), std::invalid_argument);
+}
+
+TEST(VelocityEstimatorTest, KalmanConvergesOnRamp) {
+	math::KalmanVelocityEstimator<DOF> e(v_type(1.0), v_type(1e-8));
+	jv_type jv;
+	double t;
+
+	runTrajectory(e, 0.0, 500, &jv, &t);
+	EXPECT_NEAR(0.5, jv[0], 1e-3);
+	EXPECT_NEAR(-0.3, jv[1], 1e-3);
+}
+
+TEST(VelocityEstimatorTest, KalmanResetZeroesVelocity) {
+	math::KalmanVelocityEstimator<DOF> e(v_type(1.0), v_type(1e-8));
+	jv_type jv;
+	double t;
+
+	runTrajectory(e, 0.0, 50, &jv, &t);
+	e.reset(jp_type(0.0), t);
+	EXPECT_EQ(0.0, e.getVelocity()[0]);
+	EXPECT_EQ(0.0, e.getVelocity()[1]);
+}
+
+
+}
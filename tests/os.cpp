@@ -5,6 +5,8 @@
  *      Author: dc
  */
 
+#include <iostream>
+
 #include <boost/thread.hpp>
 
 #include <gtest/gtest.h>
@@ -37,16 +39,79 @@ TEST(HighResolutionSystemTimeTest, AgreesWithBoostThreadSleep) {
 	verifySleepDurations(&boostSleep);
 }
 
+TEST(HighResolutionSystemTimeTest, IsMonotonicWithFineResolution) {
+	const int NUM_CALLS = 100000;
+	double minStep = 1.0;
+
+	double t_1 = highResolutionSystemTime();
+	for (int i = 0; i < NUM_CALLS; ++i) {
+		double t = highResolutionSystemTime();
+		ASSERT_GE(t, t_1);
+		if (t > t_1  &&  t - t_1 < minStep) {
+			minStep = t - t_1;
+		}
+		t_1 = t;
+	}
+
+	EXPECT_LT(minStep, 1e-6);
+}
+
+// Microbenchmark: not a pass/fail test of performance, but a gross
+// regression (e.g. falling back to a system call per read) will trip it.
+TEST(HighResolutionSystemTimeTest, PerCallCost) {
+	const int NUM_CALLS = 1000000;
+	volatile double sink = 0.0;
+
+	double before = highResolutionSystemTime();
+	for (int i = 0; i < NUM_CALLS; ++i) {
+		sink = highResolutionSystemTime();
+	}
+	double after = highResolutionSystemTime();
+
+	double perCall_ns = (after - before) / NUM_CALLS * 1e9;
+	std::cout << "highResolutionSystemTime(): " << perCall_ns << " ns per call" << std::endl;
+	RecordProperty("PerCallNanoseconds", static_cast<int>(perCall_ns));
+	EXPECT_LT(perCall_ns, 1000.0);
+}
+
 TEST(BtsleepTest, AgreesWithHRST) {
 	verifySleepDurations(&btsleep);
 }
 
 
+TEST(LogMessageRTTest, LogsImmediatelyUntilStarted) {
+	// Nothing has started the logger yet, and this isn't a real-time thread.
+	unsigned long before = getNumDroppedRealTimeLogMessages();
+	logMessageRT("LogMessageRTTest: %s") % __func__;
+	EXPECT_EQ(before, getNumDroppedRealTimeLogMessages());
+}
+
+TEST(LogMessageRTTest, CountsDroppedMessages) {
+	startRealTimeLogging();
+	btsleep(0.05);  // Let the logger drain anything already queued
+	unsigned long before = getNumDroppedRealTimeLogMessages();
+
+	logMessageRT("LogMessageRTTest: %s %d %u %.3f %c") % __func__ % -1 % 2u % 3.0 % 'x';
+	btsleep(0.05);
+	EXPECT_EQ(before, getNumDroppedRealTimeLogMessages());
+
+	// The logger can't keep up with a burst of twice what the queue holds.
+	// The messages that are queued only go to syslog.
+	for (size_t i = 0; i < 2 * detail::REAL_TIME_LOG_QUEUE_SIZE; ++i) {
+		logMessageRT("LogMessageRTTest: burst %d") % i;
+	}
+	EXPECT_LT(before, getNumDroppedRealTimeLogMessages());
+}
+
+
+// The timers below are given a priority of 0 so the tests don't switch to
+// SCHED_FIFO or lock the test process' memory.
+
 TEST(PeriodicLoopTimerTest, LoopRateIsCorrect) {
 	const int LOOP_COUNT = 10;
 
 	for (double period = 0.05; period <= 0.10; period += 0.025) {
-		PeriodicLoopTimer plt(period);
+		PeriodicLoopTimer plt(period, 0);
 		plt.wait();  // There might be first-run timing effects. These are not important.
 
 		double before = highResolutionSystemTime();
@@ -62,7 +127,7 @@ TEST(PeriodicLoopTimerTest, LoopRateIsCorrect) {
 
 TEST(PeriodicLoopTimerTest, CountsMissedRelesePoints) {
 	const double PERIOD = 0.05;
-	PeriodicLoopTimer plt(PERIOD);
+	PeriodicLoopTimer plt(PERIOD, 0);
 
 	for (int i = 0; i < 5; ++i) {
 		EXPECT_EQ(i, plt.wait()) << "This test is known to fail under Xenomai.";
@@ -70,4 +135,20 @@ TEST(PeriodicLoopTimerTest, CountsMissedRelesePoints) {
 	}
 }
 
+TEST(PeriodicLoopTimerTest, AccumulatesMissedReleasePoints) {
+	const double PERIOD = 0.02;
+	PeriodicLoopTimer plt(PERIOD, 0);
+	unsigned long sum = 0;
+
+	EXPECT_EQ(0u, plt.getNumMissedReleasePoints());
+	for (int i = 0; i < 4; ++i) {
+		sum += plt.wait();
+		btsleep(PERIOD * (i + 1.5));
+	}
+	sum += plt.wait();
+
+	EXPECT_NE(0u, sum);
+	EXPECT_EQ(sum, plt.getNumMissedReleasePoints());
+}
+
 }
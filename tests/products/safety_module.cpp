@@ -0,0 +1,165 @@
+/*
+ * safety_module.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <deque>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include <barrett/thread/null_mutex.h>
+#include <barrett/bus/abstract/communications_bus.h>
+#include <barrett/bus/bus_manager.h>
+#include <barrett/products/puck.h>
+#include <barrett/products/puck_group.h>
+#include <barrett/products/safety_module.h>
+
+
+namespace {
+using namespace barrett;
+
+typedef SafetyModule::PendantState PS;
+
+
+// Three bits per parameter: 1 is SAFE, 2 is WARNING, 4 is FAULT.
+int penWithParameters(int velocity, int torque, int voltage, int heartbeat, int other) {
+	return (1 << 27) | (1 << 26) |  // No button pressed
+			velocity | (torque << 3) | (voltage << 6) | (heartbeat << 9) | (other << 12);
+}
+
+
+TEST(SafetyModuleTest, DecodePendantState) {
+	PS ps;
+	ASSERT_TRUE(SafetyModule::decodePendantState(penWithParameters(2, 4, 1, 1, 1), &ps));
+	EXPECT_EQ(PS::NONE, ps.pressedButton);
+	EXPECT_EQ(PS::WARNING, ps.safetyParameters[PS::VELOCITY]);
+	EXPECT_EQ(PS::FAULT, ps.safetyParameters[PS::TORQUE]);
+	EXPECT_EQ(PS::SAFE, ps.safetyParameters[PS::VOLTAGE]);
+	EXPECT_TRUE(ps.hasFaults());
+	EXPECT_FALSE(ps.allSafe());
+
+	// Exactly one bit per parameter must be set.
+	EXPECT_FALSE(SafetyModule::decodePendantState(penWithParameters(1, 1, 3, 1, 1), &ps));
+	EXPECT_FALSE(SafetyModule::decodePendantState(penWithParameters(1, 1, 1, 0, 1), &ps));
+}
+
+TEST(SafetyModuleTest, DecodeSafetyParameter) {
+	enum PS::Parameter state;
+	int pen = penWithParameters(2, 1, 3, 0, 4);
+
+	ASSERT_TRUE(SafetyModule::decodeSafetyParameter(pen, PS::VELOCITY, &state));
+	EXPECT_EQ(PS::WARNING, state);
+	ASSERT_TRUE(SafetyModule::decodeSafetyParameter(pen, PS::TORQUE, &state));
+	EXPECT_EQ(PS::SAFE, state);
+	ASSERT_TRUE(SafetyModule::decodeSafetyParameter(pen, PS::OTHER, &state));
+	EXPECT_EQ(PS::FAULT, state);
+
+	// Malformed fields don't affect the others.
+	EXPECT_FALSE(SafetyModule::decodeSafetyParameter(pen, PS::VOLTAGE, &state));
+	EXPECT_FALSE(SafetyModule::decodeSafetyParameter(pen, PS::HEARTBEAT, &state));
+}
+
+
+// Stands in for a CANbus with a single SafetyModule on it. Every property
+// reads as 2 (which makes the Puck a READY SafetyModule in ACTIVE mode).
+// Replies to MODE requests are held until release() is called.
+class FakeSafetyBus : public bus::CommunicationsBus {
+public:
+	FakeSafetyBus() : modePropId(-1), numModeRequests(0) {}
+
+	virtual thread::Mutex& getMutex() const { return mutex; }
+
+	virtual void open(int port) {}
+	virtual void close() {}
+	virtual bool isOpen() const { return true; }
+
+	virtual int send(int busId, const unsigned char* data, size_t len) const {
+		if (len != 1) {
+			return 0;  // Ignore SETs
+		}
+
+		Message m;
+		m.busId = Puck::encodeBusId(busId & Puck::NODE_ID_MASK, PuckGroup::FGRP_OTHER);
+		m.len = 4;
+		m.data[0] = data[0] | Puck::SET_MASK;
+		m.data[1] = 0;
+		m.data[2] = 2;
+		m.data[3] = 0;
+
+		if ((data[0] & Puck::PROPERTY_MASK) == modePropId) {
+			++numModeRequests;
+			heldReplies.push_back(m);
+		} else {
+			replies.push_back(m);
+		}
+		return 0;
+	}
+
+	virtual int receiveRaw(int& busId, unsigned char* data, size_t& len, bool blocking = true) const {
+		if (replies.empty()) {
+			return 1;
+		}
+
+		busId = replies.front().busId;
+		len = replies.front().len;
+		std::memcpy(data, replies.front().data, len);
+		replies.pop_front();
+		return 0;
+	}
+
+	void release() {
+		replies.insert(replies.end(), heldReplies.begin(), heldReplies.end());
+		heldReplies.clear();
+	}
+
+	int modePropId;
+	mutable int numModeRequests;
+
+protected:
+	struct Message {
+		int busId;
+		size_t len;
+		unsigned char data[MAX_MESSAGE_LEN];
+	};
+
+	mutable thread::NullMutex mutex;
+	mutable std::deque<Message> replies;
+	mutable std::deque<Message> heldReplies;
+};
+
+TEST(SafetyModuleTest, PollModeDoesNotWaitForTheReply) {
+	FakeSafetyBus fsb;
+	bus::BusManager bm(&fsb);
+	Puck puck(bm, 10);
+	SafetyModule sm(&puck);
+	ASSERT_TRUE(sm.isMonitoringBus());
+	fsb.modePropId = puck.getPropertyId(Puck::MODE);
+
+	enum SafetyModule::SafetyMode mode;
+	EXPECT_FALSE(sm.getObservedMode(&mode, 1.0));
+
+	sm.pollMode(0.0);
+	EXPECT_EQ(1, fsb.numModeRequests);
+	EXPECT_FALSE(sm.getObservedMode(&mode, 1.0));
+
+	// Only one request is outstanding at a time.
+	sm.pollMode(0.0);
+	EXPECT_EQ(1, fsb.numModeRequests);
+	EXPECT_FALSE(sm.getObservedMode(&mode, 1.0));
+
+	fsb.release();
+	sm.pollMode(0.0);
+	EXPECT_EQ(2, fsb.numModeRequests);
+	ASSERT_TRUE(sm.getObservedMode(&mode, 1.0));
+	EXPECT_EQ(SafetyModule::ACTIVE, mode);
+
+	// Not due yet
+	fsb.release();
+	sm.pollMode(10.0);
+	EXPECT_EQ(2, fsb.numModeRequests);
+}
+
+
+}
@@ -0,0 +1,61 @@
+/*
+ * tactile_puck.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+
+#include <gtest/gtest.h>
+#include <barrett/products/tactile_puck.h>
+
+
+namespace {
+using namespace barrett;
+
+
+TEST(TactilePuckTest, Top10ParserDecodesMaskedCells) {
+	TactilePuck::v_type result(5.0);  // Stale data should be cleared
+
+	// Cells 0, 1, 2, 8, 9, 10, 16, 17, 18, 23 are in the top ten
+	const unsigned char data[] = { 0x87, 0x07, 0x07, 0x12, 0x34, 0x56, 0x78, 0x9f };
+	EXPECT_EQ(0, TactilePuck::Top10TactParser::parse(0, 0, &result, data, 8));
+
+	EXPECT_EQ(1.0, result[0]);
+	EXPECT_EQ(2.0, result[1]);
+	EXPECT_EQ(3.0, result[2]);
+	EXPECT_EQ(4.0, result[8]);
+	EXPECT_EQ(5.0, result[9]);
+	EXPECT_EQ(6.0, result[10]);
+	EXPECT_EQ(7.0, result[16]);
+	EXPECT_EQ(8.0, result[17]);
+	EXPECT_EQ(9.0, result[18]);
+	EXPECT_EQ(15.0, result[23]);
+
+	EXPECT_EQ(0.0, result[3]);
+	EXPECT_EQ(0.0, result[7]);
+	EXPECT_EQ(0.0, result[15]);
+	EXPECT_EQ(0.0, result[22]);
+}
+
+TEST(TactilePuckTest, Top10ParserRejectsBadLength) {
+	TactilePuck::v_type result;
+	const unsigned char data[8] = { 0 };
+	EXPECT_NE(0, TactilePuck::Top10TactParser::parse(0, 0, &result, data, 7));
+}
+
+TEST(TactilePuckTest, FullParserDecodesSequence) {
+	TactilePuck::v_type result;
+
+	// Sequence number 1 covers cells 5 through 9
+	const unsigned char data[] = { 0x11, 0x00, 0x20, 0x03, 0x00, 0x40, 0x05, 0x00 };
+	EXPECT_EQ(0, TactilePuck::FullTactParser::parse(0, 0, &result, data, 8));
+
+	EXPECT_EQ(1.0, result[5]);
+	EXPECT_EQ(2.0, result[6]);
+	EXPECT_EQ(3.0, result[7]);
+	EXPECT_EQ(4.0, result[8]);
+	EXPECT_EQ(5.0, result[9]);
+}
+
+
+}
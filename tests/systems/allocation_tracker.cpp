@@ -0,0 +1,134 @@
+/*
+ * allocation_tracker.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <barrett/detail/allocation_tracker.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/constant.h>
+#include <barrett/systems/gain.h>
+#include "./exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+
+// Allocates in each call to operate()
+class AllocatingSystem : public systems::System {
+public:
+	explicit AllocatingSystem(systems::ExecutionManager* em) : System("AllocatingSystem") {
+		em->startManaging(*this);
+	}
+	virtual ~AllocatingSystem() { mandatoryCleanUp(); }
+
+	std::vector<int> v;
+
+protected:
+	virtual bool inputsValid() { return true; }
+	virtual void operate() { v.push_back(0); }
+	virtual void invalidateOutputs() {}
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(AllocatingSystem);
+};
+
+
+class AllocationTrackerTest : public ::testing::Test {
+public:
+	AllocationTrackerTest() : c(1.0), g(2.0) {
+		systems::connect(c.output, g.input);
+		systems::connect(g.output, eios.input);
+		mem.startManaging(eios);
+
+		// Warm up before tracking
+		mem.runExecutionCycle();
+		mem.setAllocationTracker(&at);
+	}
+
+	~AllocationTrackerTest() {
+		mem.setAllocationTracker(NULL);
+	}
+
+protected:
+	void runExecutionCycles(size_t n) {
+		for (size_t i = 0; i < n; ++i) {
+			mem.runExecutionCycle();
+		}
+	}
+
+	systems::ManualExecutionManager mem;
+	detail::AllocationTracker at;
+
+	systems::Constant<double> c;
+	systems::Gain<double> g;
+	ExposedIOSystem<double> eios;
+};
+
+
+TEST_F(AllocationTrackerTest, InterposerIsLinked) {
+	EXPECT_TRUE(detail::AllocationTracker::isInterposerLinked());
+}
+
+TEST_F(AllocationTrackerTest, SteadyStateCycleDoesntAllocate) {
+	runExecutionCycles(10);
+
+	EXPECT_EQ(10u, at.getNumCycles());
+	EXPECT_EQ(0u, at.getNumAllocatingCycles());
+	EXPECT_EQ(0u, at.getNumAllocations());
+	EXPECT_EQ(0u, at.getNumFrees());
+}
+
+TEST_F(AllocationTrackerTest, OnlyCountsExecutionCycles) {
+	std::vector<double>* v = new std::vector<double>(100);
+	delete v;
+
+	mem.runExecutionCycle();
+
+	EXPECT_EQ(1u, at.getNumCycles());
+	EXPECT_EQ(0u, at.getNumAllocations());
+	EXPECT_EQ(0u, at.getNumFrees());
+}
+
+TEST_F(AllocationTrackerTest, AttributesAllocationsToSystems) {
+	AllocatingSystem as(&mem);
+	as.v.reserve(4);
+
+	runExecutionCycles(3);
+	EXPECT_EQ(3u, at.getNumCycles());
+	EXPECT_EQ(0u, at.getNumAllocatingCycles());
+
+	// The vector must grow on the 5th push_back().
+	runExecutionCycles(2);
+	EXPECT_EQ(5u, at.getNumCycles());
+	EXPECT_EQ(1u, at.getNumAllocatingCycles());
+	EXPECT_EQ(1u, at.getNumAllocations());
+	EXPECT_EQ(1u, at.getNumFrees());
+	EXPECT_GE(at.getNumBytes(), 5 * sizeof(int));
+
+	ASSERT_EQ(1u, at.getNumSystems());
+	const detail::AllocationTracker::SystemStats& s = at.getSystemStats(0);
+	EXPECT_EQ(&as, s.sys);
+	EXPECT_STREQ("AllocatingSystem", s.name);
+	EXPECT_EQ(1u, s.numAllocations);
+	EXPECT_EQ(1u, s.numFrees);
+}
+
+TEST_F(AllocationTrackerTest, Reset) {
+	AllocatingSystem as(&mem);
+	runExecutionCycles(2);
+	EXPECT_NE(0u, at.getNumAllocations());
+
+	at.reset();
+	EXPECT_EQ(0u, at.getNumCycles());
+	EXPECT_EQ(0u, at.getNumAllocatingCycles());
+	EXPECT_EQ(0u, at.getNumAllocations());
+	EXPECT_EQ(0u, at.getNumSystems());
+}
+
+
+}
@@ -0,0 +1,127 @@
+/*
+ * command_subscriber.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <string>
+#include <stdexcept>
+
+#include <unistd.h>
+
+#include <boost/lexical_cast.hpp>
+
+#include <gtest/gtest.h>
+
+#include <barrett/os.h>
+#include <barrett/units.h>
+#include <barrett/thread/shared_memory.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/state_publisher.h>
+#include <barrett/systems/command_subscriber.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+const size_t DOF = 3;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+const double TIMEOUT = 0.05;
+
+
+std::string uniqueName(const char* base) {
+	return std::string("/barrett_test_") + base + "_" + boost::lexical_cast<std::string>(getpid());
+}
+
+
+TEST(StatePublisherTest, PublishesInput) {
+	systems::ManualExecutionManager mem(0.002);
+	systems::StatePublisher<jp_type> sp(uniqueName("state"));
+	ExposedIOSystem<jp_type> eios;
+	systems::connect(eios.output, sp.input);
+	mem.startManaging(sp);
+
+	// Another process would open the channel by name.
+	thread::SharedMemoryChannel<jp_type> reader(sp.getChannelName(), false);
+	thread::SharedMemoryChannel<jp_type>::Sample s;
+	EXPECT_FALSE(reader.tryRead(&s));
+
+	jp_type jp;
+	jp << 0.1, 0.2, 0.3;
+	eios.setOutputValue(jp);
+	mem.runExecutionCycle();
+
+	ASSERT_TRUE(reader.tryRead(&s));
+	EXPECT_EQ(jp, s.value);
+	EXPECT_LE(s.time, highResolutionSystemTime());
+
+	mem.runExecutionCycle();
+	EXPECT_EQ(4u, reader.getSequence());
+}
+
+
+class CommandSubscriberTest : public ::testing::Test {
+public:
+	CommandSubscriberTest() :
+		mem(0.002), cs(uniqueName("command"), TIMEOUT), writer(cs.getChannelName(), false)
+	{
+		systems::connect(cs.output, eios.input);
+		mem.startManaging(cs);
+		mem.startManaging(eios);
+	}
+
+protected:
+	systems::ManualExecutionManager mem;
+	systems::CommandSubscriber<jp_type> cs;
+	thread::SharedMemoryChannel<jp_type> writer;
+	ExposedIOSystem<jp_type> eios;
+};
+
+
+TEST_F(CommandSubscriberTest, UndefinedUntilFirstCommand) {
+	mem.runExecutionCycle();
+	EXPECT_FALSE(cs.isActive());
+	EXPECT_FALSE(eios.inputValueDefined());
+}
+
+TEST_F(CommandSubscriberTest, OutputsLatestCommand) {
+	jp_type jp(0.5);
+	writer.write(jp);
+	mem.runExecutionCycle();
+	EXPECT_TRUE(cs.isActive());
+	ASSERT_TRUE(eios.inputValueDefined());
+	EXPECT_EQ(jp, eios.getInputValue());
+
+	// Only the most recent command is used.
+	writer.write(jp_type(1.0));
+	writer.write(jp_type(2.0));
+	mem.runExecutionCycle();
+	EXPECT_EQ(jp_type(2.0), eios.getInputValue());
+}
+
+TEST_F(CommandSubscriberTest, WatchdogTimesOut) {
+	writer.write(jp_type(1.0));
+	mem.runExecutionCycle();
+	EXPECT_TRUE(eios.inputValueDefined());
+
+	// No new commands arrive.
+	btsleep(2 * TIMEOUT);
+	mem.runExecutionCycle();
+	EXPECT_FALSE(cs.isActive());
+	EXPECT_FALSE(eios.inputValueDefined());
+
+	writer.write(jp_type(1.0));
+	mem.runExecutionCycle();
+	EXPECT_TRUE(cs.isActive());
+	EXPECT_TRUE(eios.inputValueDefined());
+}
+
+TEST(CommandSubscriberCtorTest, InvalidTimeoutThrows) {
+	EXPECT_THROW(systems::CommandSubscriber<double>(uniqueName("bad"), 0.0), std::invalid_argument);
+}
+
+
+}
@@ -0,0 +1,212 @@
+/*
+ * force_torque_sensor_source.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <deque>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include <barrett/thread/null_mutex.h>
+#include <barrett/bus/abstract/communications_bus.h>
+#include <barrett/products/puck.h>
+#include <barrett/products/puck_group.h>
+#include <barrett/products/force_torque_sensor.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/helpers.h>
+#include <barrett/systems/force_torque_sensor_source.h>
+
+#include "./exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+typedef ForceTorqueSensor::cf_type cf_type;
+typedef ForceTorqueSensor::ct_type ct_type;
+
+const int FTS_ID = 8;
+const double T_s = 0.002;
+
+
+// Stands in for a CANbus with a single force-torque sensor on it. Every
+// property reads as 2 (which makes the Puck READY); reading FT returns the
+// current force and torque.
+class FakeFtsBus : public bus::CommunicationsBus {
+public:
+	FakeFtsBus() : force(0.0), torque(0.0),
+		ftPropId(Puck::getPropertyId(Puck::FT, Puck::PT_ForceTorque, 0)) {}
+
+	virtual thread::Mutex& getMutex() const { return mutex; }
+
+	virtual void open(int port) {}
+	virtual void close() {}
+	virtual bool isOpen() const { return true; }
+
+	virtual int send(int busId, const unsigned char* data, size_t len) const {
+		if (len != 1) {
+			return 0;  // Ignore SETs
+		}
+
+		int id = busId & Puck::NODE_ID_MASK;
+		if ((data[0] & Puck::PROPERTY_MASK) == ftPropId) {
+			queueVector(Puck::encodeBusId(id, PuckGroup::FGRP_FT_FORCE), force, ForceTorqueSensor::ForceParser::SCALE_FACTOR);
+			queueVector(Puck::encodeBusId(id, PuckGroup::FGRP_FT_TORQUE), torque, ForceTorqueSensor::TorqueParser::SCALE_FACTOR);
+		} else {
+			Message m;
+			m.busId = Puck::encodeBusId(id, PuckGroup::FGRP_OTHER);
+			m.len = 4;
+			m.data[0] = data[0] | Puck::SET_MASK;
+			m.data[1] = 0;
+			m.data[2] = 2;
+			m.data[3] = 0;
+			replies.push_back(m);
+		}
+		return 0;
+	}
+
+	virtual int receiveRaw(int& busId, unsigned char* data, size_t& len, bool blocking = true) const {
+		if (replies.empty()) {
+			return 1;
+		}
+
+		busId = replies.front().busId;
+		len = replies.front().len;
+		std::memcpy(data, replies.front().data, len);
+		replies.pop_front();
+		return 0;
+	}
+
+	// In units of 1/SCALE_FACTOR
+	cf_type force;
+	ct_type torque;
+
+protected:
+	struct Message {
+		int busId;
+		size_t len;
+		unsigned char data[MAX_MESSAGE_LEN];
+	};
+
+	template<typename T>
+	void queueVector(int busId, const T& v, double scaleFactor) const {
+		Message m;
+		m.busId = busId;
+		m.len = 6;
+		for (int i = 0; i < 3; ++i) {
+			int raw = static_cast<int>(v[i] * scaleFactor);
+			m.data[2*i] = raw & 0xff;
+			m.data[2*i + 1] = (raw >> 8) & 0xff;
+		}
+		replies.push_back(m);
+	}
+
+	mutable thread::NullMutex mutex;
+	mutable std::deque<Message> replies;
+	int ftPropId;
+};
+
+
+class ForceTorqueSensorSourceTest : public ::testing::Test {
+public:
+	ForceTorqueSensorSourceTest() :
+		mem(T_s), puck(bus, FTS_ID), fts(&puck), ftss(&mem, &fts)
+	{
+		systems::connect(ftss.forceOutput, forceSink.input);
+		systems::connect(ftss.torqueOutput, torqueSink.input);
+		mem.startManaging(forceSink);
+		mem.startManaging(torqueSink);
+	}
+
+protected:
+	bool runCycle() {
+		mem.runExecutionCycle();
+		return forceSink.inputValueDefined()  &&  torqueSink.inputValueDefined();
+	}
+
+	FakeFtsBus bus;
+	systems::ManualExecutionManager mem;
+	Puck puck;
+	ForceTorqueSensor fts;
+	systems::ForceTorqueSensorSource ftss;
+	ExposedIOSystem<cf_type> forceSink;
+	ExposedIOSystem<ct_type> torqueSink;
+};
+
+
+TEST_F(ForceTorqueSensorSourceTest, OutputsReadings) {
+	bus.force << 1.0, -2.0, 3.0;
+	bus.torque << 0.5, 0.25, -0.125;
+
+	ASSERT_TRUE(runCycle());
+	EXPECT_EQ(bus.force, forceSink.getInputValue());
+	EXPECT_EQ(bus.torque, torqueSink.getInputValue());
+}
+
+TEST_F(ForceTorqueSensorSourceTest, TareAveragesReadings) {
+	bus.torque << 0.5, 0.5, 0.5;
+
+	ftss.tare(2);
+	EXPECT_TRUE(ftss.isTaring());
+	bus.force << 1.0, 2.0, 3.0;
+	EXPECT_FALSE(runCycle());
+
+	// The second sample completes the tare.
+	bus.force << 3.0, 4.0, 5.0;
+	ASSERT_TRUE(runCycle());
+	EXPECT_FALSE(ftss.isTaring());
+	EXPECT_EQ(cf_type(2.0, 3.0, 4.0), ftss.getForceBias());
+	EXPECT_EQ(ct_type(0.5), ftss.getTorqueBias());
+	EXPECT_EQ(cf_type(1.0), forceSink.getInputValue());
+	EXPECT_EQ(ct_type(0.0), torqueSink.getInputValue());
+
+	bus.force << 3.0, 3.0, 3.0;
+	ASSERT_TRUE(runCycle());
+	EXPECT_EQ(cf_type(1.0, 0.0, -1.0), forceSink.getInputValue());
+}
+
+TEST_F(ForceTorqueSensorSourceTest, LowPass) {
+	ftss.setLowPass(10.0);
+	bus.force << 1.0, 1.0, 1.0;
+
+	ASSERT_TRUE(runCycle());
+	double first = forceSink.getInputValue()[0];
+	EXPECT_GT(first, 0.0);
+	EXPECT_LT(first, 1.0);
+	ASSERT_TRUE(runCycle());
+	EXPECT_GT(forceSink.getInputValue()[0], first);
+
+	ftss.clearLowPass();
+	ASSERT_TRUE(runCycle());
+	EXPECT_EQ(bus.force, forceSink.getInputValue());
+}
+
+TEST_F(ForceTorqueSensorSourceTest, ChangingTheBiasResetsTheLowPass) {
+	ftss.setLowPass(100.0);
+	bus.force << 2.0, 2.0, 2.0;
+	for (int i = 0; i < 1000; ++i) {
+		ASSERT_TRUE(runCycle());
+	}
+	EXPECT_NEAR(2.0, forceSink.getInputValue()[0], 1e-6);
+
+	// The filter starts again from zero, not from the output with the old
+	// bias.
+	ftss.tare(1);
+	ASSERT_TRUE(runCycle());
+	EXPECT_EQ(cf_type(0.0), forceSink.getInputValue());
+
+	bus.force << 3.0, 3.0, 3.0;
+	for (int i = 0; i < 1000; ++i) {
+		ASSERT_TRUE(runCycle());
+	}
+	EXPECT_NEAR(1.0, forceSink.getInputValue()[0], 1e-6);
+
+	ftss.setBias(cf_type(3.0), ct_type(0.0));
+	ASSERT_TRUE(runCycle());
+	EXPECT_EQ(cf_type(0.0), forceSink.getInputValue());
+}
+
+
+}
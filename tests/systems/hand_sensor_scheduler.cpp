@@ -0,0 +1,146 @@
+/*
+ * hand_sensor_scheduler.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <barrett/products/tactile_puck.h>
+#include <barrett/systems/hand_sensor_scheduler.h>
+
+
+namespace {
+using namespace barrett;
+
+typedef systems::HandSensorScheduler HSS;
+
+const size_t DOF = HSS::DOF;
+const size_t FULL = TactilePuck::NUM_FULL_MESSAGES;
+const size_t TOP10 = TactilePuck::NUM_TOP10_MESSAGES;
+
+// Bus time for the positions plus each optional stream
+const double POSITIONS = HSS::frameTime(1 + DOF);
+const double FTT = HSS::frameTime(1 + DOF);
+const double FULL_PAD = HSS::frameTime(1 + FULL);
+
+
+class HandSensorScheduleTest : public ::testing::Test {
+public:
+	HandSensorScheduleTest() : numFtt(0), numTact(0) {}
+
+protected:
+	void run(HSS::Schedule* s, size_t n, double budget, bool hasFtt, size_t tactFrames) {
+		for (size_t i = 0; i < n; ++i) {
+			bool readFtt, readTact;
+			s->next(budget, hasFtt, tactFrames, &readFtt, &readTact);
+			numFtt += readFtt;
+			numTact += readTact;
+		}
+	}
+
+	size_t numFtt, numTact;
+};
+
+
+TEST_F(HandSensorScheduleTest, ReadsEverythingWhenItFits) {
+	HSS::Schedule s(1);
+	run(&s, 20, POSITIONS + FTT + FULL_PAD, true, FULL);
+	EXPECT_EQ(20u, numFtt);
+	EXPECT_EQ(20u, numTact);
+	EXPECT_EQ(0u, s.getNumDeferredReads());
+}
+
+TEST_F(HandSensorScheduleTest, FingertipTorqueDivider) {
+	HSS::Schedule s(5);
+	EXPECT_EQ(5u, s.getFingertipTorqueDivider());
+	run(&s, 20, 2e-3, true, 0);
+	EXPECT_EQ(4u, numFtt);
+	EXPECT_EQ(0u, numTact);
+
+	s.setFingertipTorqueDivider(2);
+	run(&s, 20, 2e-3, true, 0);
+	EXPECT_EQ(4u + 10u, numFtt);
+
+	EXPECT_THROW(s.setFingertipTorqueDivider(0), std::invalid_argument);
+	EXPECT_THROW(HSS::Schedule(0), std::invalid_argument);
+}
+
+TEST_F(HandSensorScheduleTest, MissingSensorsAreNotRead) {
+	HSS::Schedule s(1);
+	run(&s, 10, 2e-3, false, 0);
+	EXPECT_EQ(0u, numFtt);
+	EXPECT_EQ(0u, numTact);
+	EXPECT_EQ(0u, s.getNumDeferredReads());
+}
+
+TEST_F(HandSensorScheduleTest, StreamsTakeTurnsWhenOnlyOneFits) {
+	// With a 2 ms control loop, the positions fit with either stream, but not
+	// with both.
+	const double budget = 2e-3;
+	ASSERT_LE(POSITIONS + FTT, budget);
+	ASSERT_LE(POSITIONS + FULL_PAD, budget);
+	ASSERT_GT(POSITIONS + FTT + FULL_PAD, budget);
+
+	HSS::Schedule s(1);
+	for (size_t i = 0; i < 20; ++i) {
+		bool readFtt, readTact;
+		s.next(budget, true, FULL, &readFtt, &readTact);
+		EXPECT_NE(readFtt, readTact);
+		EXPECT_EQ(i % 2 == 0, readFtt);
+	}
+	EXPECT_EQ(20u, s.getNumDeferredReads());
+
+	// A TOP10 pad fits alongside the fingertip torques.
+	run(&s, 10, budget, true, TOP10);
+	EXPECT_EQ(10u, numFtt);
+	EXPECT_EQ(10u, numTact);
+}
+
+TEST_F(HandSensorScheduleTest, DeferredFingertipTorqueStaysPending) {
+	const double budget = 2e-3;
+	HSS::Schedule s(5);
+
+	// Due in cycle 0. Read then, and a tactile pad is deferred.
+	bool readFtt, readTact;
+	s.next(budget, true, FULL, &readFtt, &readTact);
+	EXPECT_TRUE(readFtt);
+	EXPECT_FALSE(readTact);
+
+	// The deferred pad goes first when the fingertip torques are next due.
+	run(&s, 4, budget, true, FULL);
+	EXPECT_EQ(0u, numFtt);
+	s.next(budget, true, FULL, &readFtt, &readTact);
+	EXPECT_FALSE(readFtt);
+	EXPECT_TRUE(readTact);
+
+	// The fingertip torques were deferred, so they are read next.
+	s.next(budget, true, FULL, &readFtt, &readTact);
+	EXPECT_TRUE(readFtt);
+	EXPECT_FALSE(readTact);
+}
+
+TEST_F(HandSensorScheduleTest, OnlyPositionsFitInATinyBudget) {
+	HSS::Schedule s(1);
+	run(&s, 10, POSITIONS, true, FULL);
+	EXPECT_EQ(0u, numFtt);
+	EXPECT_EQ(0u, numTact);
+	EXPECT_EQ(20u, s.getNumDeferredReads());
+}
+
+TEST_F(HandSensorScheduleTest, DefaultBudgetLeavesRoomForAWam) {
+	const double wam = HSS::frameTime(HSS::WAM_FRAMES);
+	EXPECT_DOUBLE_EQ(4e-3 - wam, HSS::defaultBusTimeBudget(4e-3));
+	EXPECT_EQ(0.0, HSS::defaultBusTimeBudget(wam / 2.0));
+
+	// At 500 Hz, a WAM leaves room for the Hand's positions only.
+	HSS::Schedule s(1);
+	run(&s, 10, HSS::defaultBusTimeBudget(2e-3), true, FULL);
+	EXPECT_EQ(0u, numFtt);
+	EXPECT_EQ(0u, numTact);
+}
+
+
+}
@@ -0,0 +1,139 @@
+/*
+ * haptic_path.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <vector>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <barrett/units.h>
+#include <barrett/math/spline.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/haptic_path.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+BARRETT_UNITS_FIXED_SIZE_TYPEDEFS;
+
+
+class HapticPathTest : public ::testing::Test {
+public:
+	HapticPathTest() : mem(0.002), path(makePath()), hp(path) {
+		systems::connect(eiosIn.output, hp.input);
+		systems::connect(hp.depthOutput, depth.input);
+		systems::connect(hp.directionOutput, direction.input);
+		systems::connect(hp.tangentDirectionOutput, tangent.input);
+		mem.startManaging(depth);
+		mem.startManaging(direction);
+		mem.startManaging(tangent);
+
+		// HapticPath drops the first point, and keeps the rest because they
+		// are more than HapticPath::COARSE_STEP apart.
+		std::vector<cp_type> knots(path.begin() + 1, path.end());
+		spline = new math::Spline<cp_type>(knots);
+	}
+	~HapticPathTest() {
+		delete spline;
+	}
+
+protected:
+	// Two parallel arms 8 cm apart, joined by a half circle
+	static std::vector<cp_type> makePath() {
+		std::vector<cp_type> p;
+		cp_type x(0.0);
+		for (int i = 0; i <= 20; ++i) {
+			x << 0.5, -0.2 + 0.015*i, 0.1;
+			p.push_back(x);
+		}
+		for (int i = 1; i < 8; ++i) {
+			double theta = M_PI * i / 8.0;
+			x << 0.46 + 0.04*std::cos(theta), 0.1 + 0.04*std::sin(theta), 0.1;
+			p.push_back(x);
+		}
+		for (int i = 0; i <= 20; ++i) {
+			x << 0.42, 0.1 - 0.015*i, 0.1;
+			p.push_back(x);
+		}
+		return p;
+	}
+
+	void update(const cp_type& cp) {
+		eiosIn.setOutputValue(cp);
+		mem.runExecutionCycle();
+	}
+
+	// Distance to the spline, by sampling
+	double bruteForceDistance(const cp_type& cp) const {
+		double minDist = (spline->eval(spline->finalS()) - cp).norm();
+		for (double s = spline->initialS(); s <= spline->finalS(); s += 2e-5) {
+			minDist = std::min(minDist, (spline->eval(s) - cp).norm());
+		}
+		return minDist;
+	}
+
+	systems::ManualExecutionManager mem;
+	std::vector<cp_type> path;
+	systems::HapticPath hp;
+	math::Spline<cp_type>* spline;
+
+	ExposedIOSystem<cp_type> eiosIn;
+	ExposedIOSystem<double> depth;
+	ExposedIOSystem<cf_type> direction;
+	ExposedIOSystem<cp_type> tangent;
+};
+
+
+TEST_F(HapticPathTest, MatchesBruteForceSearch) {
+	// A pseudo-random walk around the path
+	unsigned int seed = 1;
+	cp_type cp;
+	cp << 0.46, -0.25, 0.1;
+	for (int i = 0; i < 30; ++i) {
+		for (size_t j = 0; j < 3; ++j) {
+			seed = seed * 1103515245 + 12345;
+			cp[j] += 0.02 * (((seed >> 16) % 1000) / 1000.0 - 0.5);
+		}
+		cp[1] += 0.012;
+		update(cp);
+
+		double expected = bruteForceDistance(cp);
+		EXPECT_LE(depth.getInputValue(), expected + 1e-9);
+		EXPECT_NEAR(expected, depth.getInputValue(), 1e-5);
+	}
+}
+
+TEST_F(HapticPathTest, JumpsBetweenArms) {
+	cp_type cp;
+	cp << 0.505, -0.1, 0.1;
+	update(cp);
+	EXPECT_NEAR(0.005, depth.getInputValue(), 1e-6);
+
+	// The previous nearest point is now 8 cm away, but the other arm is closer.
+	cp << 0.4185, -0.1, 0.1;
+	update(cp);
+	EXPECT_NEAR(0.0015, depth.getInputValue(), 1e-6);
+}
+
+TEST_F(HapticPathTest, DirectionsPointToAndAlongThePath) {
+	cp_type cp;
+	cp << 0.51, -0.05, 0.12;
+	update(cp);
+
+	cp_type nearest = cp + depth.getInputValue() * direction.getInputValue();
+	EXPECT_NEAR(0.5, nearest[0], 1e-6);
+	EXPECT_NEAR(-0.05, nearest[1], 1e-6);
+	EXPECT_NEAR(0.1, nearest[2], 1e-6);
+
+	EXPECT_NEAR(1.0, direction.getInputValue().norm(), 1e-9);
+	EXPECT_NEAR(1.0, std::fabs(tangent.getInputValue()[1]), 1e-6);
+	EXPECT_NEAR(0.0, tangent.getInputValue().dot(direction.getInputValue()), 1e-6);
+}
+
+
+}
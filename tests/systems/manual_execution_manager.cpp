@@ -6,6 +6,8 @@
  */
 
 
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <barrett/systems/manual_execution_manager.h>
 #include "./exposed_io_system.h"
@@ -15,6 +17,20 @@ namespace {
 using namespace barrett;
 
 
+class PrefaultRecorder : public ExposedIOSystem<double> {
+public:
+	explicit PrefaultRecorder(std::vector<const System*>* visits) :
+		visits(visits) {}
+
+protected:
+	virtual void prefault() {
+		visits->push_back(this);
+	}
+
+	std::vector<const System*>* visits;
+};
+
+
 class ManualExecutionManagerTest : public ::testing::Test {
 public:
 	ManualExecutionManagerTest() {
@@ -338,6 +354,38 @@ TEST_F(ManualExecutionManagerTest, UpdateTokensDontCollide) {
 	EXPECT_TRUE(eios.operateCalled);
 }
 
+TEST_F(ManualExecutionManagerTest, PrefaultVisitsEachManagedSystemOnce) {
+	std::vector<const systems::System*> visits;
+	PrefaultRecorder source(&visits), delegate(&visits), shared(&visits),
+			sink1(&visits), sink2(&visits), downstream(&visits);
+
+	// source -> shared -> sink1 and shared -> sink2; source's output is
+	// delegated to delegate's.
+	source.delegateOutputValueTo(delegate.output);
+	systems::connect(source.output, shared.input);
+	systems::connect(shared.output, sink1.input);
+	systems::connect(shared.output, sink2.input);
+	systems::connect(sink2.output, downstream.input);
+	mem.startManaging(sink1);
+	mem.startManaging(sink2);
+
+	mem.prefault();
+	ASSERT_EQ(5u, visits.size());
+	EXPECT_EQ(&delegate, visits[0]);  // Upstream Systems come first
+	EXPECT_EQ(&source, visits[1]);
+	EXPECT_EQ(&shared, visits[2]);
+	EXPECT_EQ(&sink1, visits[3]);
+	EXPECT_EQ(&sink2, visits[4]);
+
+	// Each call visits them again
+	mem.prefault();
+	EXPECT_EQ(10u, visits.size());
+
+	// prefault() doesn't run execution cycles
+	EXPECT_FALSE(source.operateCalled);
+	EXPECT_FALSE(sink1.operateCalled);
+}
+
 
 // death tests
 typedef ManualExecutionManagerTest ManualExecutionManagerDeathTest;
@@ -0,0 +1,146 @@
+/*
+ * network_link.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <barrett/os.h>
+#include <barrett/units.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/network_link.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+const size_t DOF = 3;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+const double T_s = 0.002;
+const char LOCALHOST[] = "127.0.0.1";
+
+
+// Two ends of a link over the loopback interface
+class NetworkLinkTest : public ::testing::Test {
+public:
+	NetworkLinkTest() :
+		mem(T_s), portA(20000 + getpid() % 20000), portB(portA + 1),
+		a(LOCALHOST, portA, portB, 2 * T_s), b(LOCALHOST, portB, portA, 2 * T_s)
+	{
+		systems::connect(inA.output, a.input);
+		systems::connect(a.output, outA.input);
+		systems::connect(inB.output, b.input);
+		systems::connect(b.output, outB.input);
+		mem.startManaging(a);
+		mem.startManaging(b);
+		mem.startManaging(outA);  // So their inputs can be read
+		mem.startManaging(outB);
+	}
+
+protected:
+	// Runs n cycles in (approximately) real time, ramping A's input.
+	void run(size_t n) {
+		for (size_t i = 0; i < n; ++i) {
+			inA.setOutputValue(jp_type(ramp(highResolutionSystemTime())));
+			mem.runExecutionCycle();
+			btsleep(T_s);
+		}
+	}
+
+	static double ramp(double t) { return 0.5 * t; }
+
+	systems::ManualExecutionManager mem;
+	int portA, portB;
+	systems::NetworkLink<jp_type> a, b;
+
+	ExposedIOSystem<jp_type> inA, outA, inB, outB;
+};
+
+
+TEST_F(NetworkLinkTest, NotLinkedAtFirst) {
+	EXPECT_FALSE(a.isLinked());
+	EXPECT_FALSE(b.isLinked());
+	EXPECT_EQ(0u, a.getStatistics().packetsReceived);
+}
+
+TEST_F(NetworkLinkTest, ExchangesValues) {
+	inB.setOutputValue(jp_type(-1.0));
+	run(250);
+
+	ASSERT_TRUE(a.isLinked());
+	ASSERT_TRUE(b.isLinked());
+	ASSERT_TRUE(outA.inputValueDefined());
+	ASSERT_TRUE(outB.inputValueDefined());
+	EXPECT_EQ(jp_type(-1.0), outA.getInputValue());
+
+	// B plays A's ramp back about 2 * T_s behind (plus the loopback delay and
+	// however late the last cycle ran).
+	double expected = ramp(highResolutionSystemTime() - 2 * T_s);
+	EXPECT_NEAR(expected, outB.getInputValue()[0], 0.5 * 4 * T_s);
+
+	systems::NetworkLink<jp_type>::Statistics s = b.getStatistics();
+	EXPECT_GT(s.packetsSent, 200u);
+	EXPECT_GT(s.packetsReceived, 200u);
+	EXPECT_EQ(0u, s.packetsDropped);
+	EXPECT_EQ(0u, s.packetsLost);
+	EXPECT_GT(s.roundTripTime, 0.0);
+	EXPECT_LT(s.roundTripTime, 0.05);
+}
+
+TEST_F(NetworkLinkTest, TimesOut) {
+	inB.setOutputValue(jp_type(0.0));
+	run(50);
+	ASSERT_TRUE(b.isLinked());
+
+	// A stops sending.
+	mem.stopManaging(a);
+	run(60);  // Longer than the default timeout
+	EXPECT_FALSE(b.isLinked());
+	EXPECT_FALSE(outB.inputValueDefined());
+}
+
+TEST(NetworkLinkRestartTest, RecoversWhenTheOtherEndRestarts) {
+	systems::ManualExecutionManager mem(T_s);
+	int portA = 20000 + (getpid() + 2) % 20000, portB = portA + 1;
+	ExposedIOSystem<jp_type> in, out;
+	in.setOutputValue(jp_type(1.0));
+
+	systems::NetworkLink<jp_type> b(LOCALHOST, portB, portA, 2 * T_s);
+	systems::connect(in.output, b.input);
+	systems::connect(b.output, out.input);
+	mem.startManaging(b);
+	mem.startManaging(out);
+
+	// A runs, then is replaced by a new A that starts again from sequence
+	// number 0.
+	for (int restarts = 0; restarts < 2; ++restarts) {
+		systems::NetworkLink<jp_type> a(LOCALHOST, portA, portB, 2 * T_s);
+		systems::connect(in.output, a.input);
+		mem.startManaging(a);
+
+		for (size_t i = 0; i < 150; ++i) {
+			mem.runExecutionCycle();
+			btsleep(T_s);
+		}
+		EXPECT_TRUE(b.isLinked());
+		EXPECT_TRUE(out.inputValueDefined());
+
+		mem.stopManaging(a);
+	}
+}
+
+TEST(NetworkLinkCtorTest, InvalidArgumentsThrow) {
+	EXPECT_THROW(systems::NetworkLink<double>("not an address", 20000, 20001), std::invalid_argument);
+	EXPECT_THROW(systems::NetworkLink<double>(LOCALHOST, 20000, 20001, 0.0, 0.01, 0.0), std::invalid_argument);
+}
+
+
+}
@@ -0,0 +1,127 @@
+/*
+ * setpoint_table.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <vector>
+#include <stdexcept>
+#include <cmath>
+
+#include <boost/tuple/tuple.hpp>
+
+#include <gtest/gtest.h>
+
+#include <barrett/units.h>
+#include <barrett/math/spline.h>
+#include <barrett/math/trapezoidal_velocity_profile.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/setpoint_table.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+const size_t DOF = 3;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+const double T_s = 0.002;
+
+
+class SetpointTableTest : public ::testing::Test {
+public:
+	SetpointTableTest() : mem(T_s) {
+		// A recording from t = 1 s to t = 3 s
+		jp_type jp;
+		for (int i = 0; i <= 20; ++i) {
+			double t = 1.0 + 0.1*i;
+			jp << std::sin(t), std::cos(t), 0.5*t;
+			samples.push_back(boost::make_tuple(t, jp));
+			points.push_back(jp);
+		}
+		spline = new math::Spline<jp_type>(samples);
+
+		mem.startManaging(eiosOut);
+	}
+	~SetpointTableTest() {
+		delete spline;
+	}
+
+protected:
+	void connectTable(systems::SetpointTable<jp_type>& table) {
+		systems::connect(eiosIn.output, table.input);
+		systems::connect(table.output, eiosOut.input);
+	}
+
+	jp_type stream(double t) {
+		eiosIn.setOutputValue(t);
+		mem.runExecutionCycle();
+		return eiosOut.getInputValue();
+	}
+
+	systems::ManualExecutionManager mem;
+	ExposedIOSystem<double> eiosIn;
+	ExposedIOSystem<jp_type> eiosOut;
+
+	std::vector<boost::tuple<double, jp_type> > samples;
+	std::vector<jp_type> points;
+	math::Spline<jp_type>* spline;
+};
+
+
+TEST_F(SetpointTableTest, MatchesSplineAtEveryTick) {
+	systems::SetpointTable<jp_type> table(*spline, T_s);
+	EXPECT_EQ(1.0, table.initialT());
+	EXPECT_NEAR(3.0, table.finalT(), 1e-9);
+	ASSERT_EQ(1001u, table.size());
+
+	for (size_t i = 0; i < table.size(); ++i) {
+		EXPECT_TRUE(table.getSetpoint(i).isApprox(spline->eval(1.0 + i*T_s)));
+	}
+}
+
+TEST_F(SetpointTableTest, ThreadsRenderTheSameTable) {
+	systems::SetpointTable<jp_type> table1(*spline, T_s, 1);
+	systems::SetpointTable<jp_type> table4(*spline, T_s, 4);
+	ASSERT_EQ(table1.size(), table4.size());
+	for (size_t i = 0; i < table1.size(); ++i) {
+		EXPECT_EQ(table1.getSetpoint(i), table4.getSetpoint(i));
+	}
+}
+
+TEST_F(SetpointTableTest, FollowsProfile) {
+	math::Spline<jp_type> path(points);
+	math::TrapezoidalVelocityProfile profile(0.5, 1.0, 0.0, path.changeInS());
+
+	systems::SetpointTable<jp_type> table(path, profile, T_s, 3);
+	EXPECT_EQ(0.0, table.initialT());
+	EXPECT_GE(table.finalT(), profile.finalT());
+	EXPECT_LT(table.finalT(), profile.finalT() + T_s);
+
+	for (size_t i = 0; i < table.size(); ++i) {
+		EXPECT_TRUE(table.getSetpoint(i).isApprox(path.eval(profile.eval(i*T_s))));
+	}
+	EXPECT_TRUE(table.getSetpoint(table.size() - 1).isApprox(points.back()));
+}
+
+TEST_F(SetpointTableTest, StreamsNearestSetpoint) {
+	systems::SetpointTable<jp_type> table(*spline, T_s);
+	connectTable(table);
+
+	EXPECT_EQ(table.getSetpoint(0), stream(0.0));
+	EXPECT_EQ(table.getSetpoint(0), stream(1.0));
+	EXPECT_EQ(table.getSetpoint(10), stream(1.0 + 10.4*T_s));
+	EXPECT_EQ(table.getSetpoint(11), stream(1.0 + 10.6*T_s));
+	EXPECT_EQ(table.getSetpoint(table.size() - 1), stream(3.0));
+	EXPECT_EQ(table.getSetpoint(table.size() - 1), stream(1e300));
+}
+
+TEST_F(SetpointTableTest, InvalidArgumentsThrow) {
+	EXPECT_THROW(systems::SetpointTable<jp_type>(*spline, 0.0), std::invalid_argument);
+	EXPECT_THROW(systems::SetpointTable<jp_type>(*spline, T_s, 0), std::invalid_argument);
+}
+
+
+}
@@ -0,0 +1,175 @@
+/*
+ * settle_detector.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+#include <gtest/gtest.h>
+
+#include <barrett/os.h>
+#include <barrett/units.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/settle_detector.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+const size_t DOF = 3;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+const double T_s = 0.002;
+const size_t WINDOW = 10;
+
+
+class SettleDetectorTest : public ::testing::Test {
+public:
+	SettleDetectorTest() :
+		mem(T_s), threshold(0.01), sd(WINDOW, threshold, threshold)
+	{
+		systems::connect(eios.output, sd.input);
+		mem.startManaging(sd);
+	}
+
+protected:
+	void run(const jv_type& jv, size_t n = 1) {
+		eios.setOutputValue(jv);
+		for (size_t i = 0; i < n; ++i) {
+			mem.runExecutionCycle();
+		}
+	}
+
+	systems::ManualExecutionManager mem;
+	jv_type threshold;
+	systems::SettleDetector<jv_type> sd;
+	ExposedIOSystem<jv_type> eios;
+};
+
+
+TEST_F(SettleDetectorTest, NeedsAFullWindow) {
+	run(jv_type(0.0), WINDOW - 1);
+	EXPECT_FALSE(sd.isSettled());
+
+	run(jv_type(0.0));
+	EXPECT_TRUE(sd.isSettled());
+}
+
+TEST_F(SettleDetectorTest, MeanThreshold) {
+	jv_type jv(0.0);
+	jv[1] = 0.1;
+	run(jv, 2 * WINDOW);
+	EXPECT_FALSE(sd.isSettled());
+
+	// Settles once the moving samples have left the window.
+	jv[1] = 0.005;
+	run(jv, WINDOW - 1);
+	EXPECT_FALSE(sd.isSettled());
+	run(jv);
+	EXPECT_TRUE(sd.isSettled());
+
+	jv[1] = -0.02;
+	run(jv, WINDOW);
+	EXPECT_FALSE(sd.isSettled());
+}
+
+TEST_F(SettleDetectorTest, DeviationThreshold) {
+	// Oscillates about zero: the mean is small but the deviation isn't.
+	jv_type jv(0.0);
+	for (size_t i = 0; i < 4 * WINDOW; ++i) {
+		jv[2] = (i % 2) ? 0.05 : -0.05;
+		run(jv);
+		EXPECT_FALSE(sd.isSettled());
+	}
+
+	// Dies out
+	for (size_t i = 0; i < 2 * WINDOW; ++i) {
+		jv[2] = (i % 2) ? 0.001 : -0.001;
+		run(jv);
+	}
+	EXPECT_TRUE(sd.isSettled());
+}
+
+TEST_F(SettleDetectorTest, OccasionalSpikesDontPreventSettling) {
+	// A one-count encoder dither shows up as a single filtered velocity
+	// sample above the threshold.
+	run(jv_type(0.0), WINDOW);
+	ASSERT_TRUE(sd.isSettled());
+
+	jv_type jv(0.0);
+	for (size_t i = 0; i < 4 * WINDOW; ++i) {
+		jv[0] = (i % WINDOW == 0) ? 0.0136 : 0.0;
+		run(jv);
+		EXPECT_TRUE(sd.isSettled());
+	}
+}
+
+TEST_F(SettleDetectorTest, ZeroThresholdsAreNotChecked) {
+	// A torque settles at a non-zero value, so only its deviation is checked.
+	systems::SettleDetector<jt_type> jtSd(WINDOW, jt_type(0.0), jt_type(0.01));
+	ExposedIOSystem<jt_type> jtEios;
+	systems::connect(jtEios.output, jtSd.input);
+	mem.startManaging(jtSd);
+
+	jtEios.setOutputValue(jt_type(5.0));
+	for (size_t i = 0; i < WINDOW; ++i) {
+		mem.runExecutionCycle();
+	}
+	EXPECT_TRUE(jtSd.isSettled());
+}
+
+TEST_F(SettleDetectorTest, Scalar) {
+	systems::SettleDetector<double> scalarSd(WINDOW, 0.0, 0.1);
+	ExposedIOSystem<double> scalarEios;
+	systems::connect(scalarEios.output, scalarSd.input);
+	mem.startManaging(scalarSd);
+
+	for (size_t i = 0; i < 3 * WINDOW; ++i) {
+		scalarEios.setOutputValue(i < WINDOW ? 1.0 * i : 2.0);
+		mem.runExecutionCycle();
+		EXPECT_EQ(i >= 2 * WINDOW - 1, scalarSd.isSettled());
+	}
+}
+
+// Runs n cycles, starting shortly after the caller begins waiting
+void runCycles(systems::ManualExecutionManager* mem, size_t n) {
+	btsleep(0.05);
+	for (size_t i = 0; i < n; ++i) {
+		mem->runExecutionCycle();
+		btsleep(T_s / 10.0);
+	}
+}
+
+TEST_F(SettleDetectorTest, WaitUntilSettled) {
+	systems::SettleDetector<jv_type> unmanaged(WINDOW, threshold);
+	EXPECT_FALSE(unmanaged.waitUntilSettled(1.0));
+
+	// Nothing runs the execution cycle.
+	run(jv_type(0.0), WINDOW);
+	EXPECT_TRUE(sd.isSettled());
+	EXPECT_FALSE(sd.waitUntilSettled(0.05));
+
+	// Samples from before the call don't count.
+	boost::thread t1(runCycles, &mem, WINDOW - 1);
+	EXPECT_FALSE(sd.waitUntilSettled(0.5));
+	t1.join();
+
+	boost::thread t2(runCycles, &mem, 100 * WINDOW);
+	EXPECT_TRUE(sd.waitUntilSettled(10.0));
+	t2.join();
+}
+
+TEST(SettleDetectorCtorTest, InvalidArgumentsThrow) {
+	EXPECT_THROW(systems::SettleDetector<double>(1, 0.1), std::invalid_argument);
+	EXPECT_THROW(systems::SettleDetector<double>(10, -0.1), std::invalid_argument);
+	EXPECT_THROW(systems::SettleDetector<double>(10, 0.1, -0.1), std::invalid_argument);
+}
+
+
+}
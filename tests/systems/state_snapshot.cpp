@@ -0,0 +1,141 @@
+/*
+ * state_snapshot.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <boost/thread.hpp>
+#include <boost/tuple/tuple.hpp>
+
+#include <gtest/gtest.h>
+
+#include <barrett/units.h>
+#include <barrett/systems/manual_execution_manager.h>
+#include <barrett/systems/state_snapshot.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+const size_t DOF = 4;
+BARRETT_UNITS_TYPEDEFS(DOF);
+
+typedef systems::StateSnapshot<DOF>::State state_type;
+
+
+class StateSnapshotTest : public ::testing::Test {
+public:
+	StateSnapshotTest() : mem(0.002) {
+		systems::connect(jpEios.output, ss.jpInput);
+		systems::connect(jvEios.output, ss.jvInput);
+		systems::connect(jtEios.output, ss.jtInput);
+		systems::connect(poseEios.output, ss.poseInput);
+		mem.startManaging(ss);
+	}
+
+protected:
+	// Sets every element of the inputs to x and runs a cycle
+	void run(double x) {
+		jpEios.setOutputValue(jp_type(x));
+		jvEios.setOutputValue(jv_type(x));
+		jtEios.setOutputValue(jt_type(x));
+		poseEios.setOutputValue(boost::make_tuple(cp_type(x), Eigen::Quaterniond(x, x, x, x)));
+		mem.runExecutionCycle();
+	}
+
+	systems::ManualExecutionManager mem;
+	systems::StateSnapshot<DOF> ss;
+
+	ExposedIOSystem<jp_type> jpEios;
+	ExposedIOSystem<jv_type> jvEios;
+	ExposedIOSystem<jt_type> jtEios;
+	ExposedIOSystem<pose_type> poseEios;
+};
+
+
+TEST_F(StateSnapshotTest, InitialState) {
+	state_type s = ss.getState();
+	EXPECT_EQ(0u, s.cycle);
+	EXPECT_EQ(jp_type(0.0), s.jp);
+
+	// Nothing is published while an input is undefined.
+	mem.runExecutionCycle();
+	EXPECT_EQ(0u, ss.getState().cycle);
+}
+
+TEST_F(StateSnapshotTest, PublishesEachCycle) {
+	jp_type jp;
+	jv_type jv;
+	jt_type jt;
+	cp_type cp;
+	jp << 1, 2, 3, 4;
+	jv << 5, 6, 7, 8;
+	jt << 9, 10, 11, 12;
+	cp << 13, 14, 15;
+	Eigen::Quaterniond to(0.5, 0.5, -0.5, 0.5);
+
+	jpEios.setOutputValue(jp);
+	jvEios.setOutputValue(jv);
+	jtEios.setOutputValue(jt);
+	poseEios.setOutputValue(boost::make_tuple(cp, to));
+	mem.runExecutionCycle();
+
+	state_type s = ss.getState();
+	EXPECT_EQ(1u, s.cycle);
+	EXPECT_GT(s.time, 0.0);
+	EXPECT_EQ(jp, s.jp);
+	EXPECT_EQ(jv, s.jv);
+	EXPECT_EQ(jt, s.jt);
+	EXPECT_EQ(cp, s.cp);
+	EXPECT_EQ(to.coeffs(), s.to.coeffs());
+
+	run(1.0);
+	run(2.0);
+	s = ss.getState();
+	EXPECT_EQ(3u, s.cycle);
+	EXPECT_EQ(jt_type(2.0), s.jt);
+	EXPECT_LE(ss.getState().time, highResolutionSystemTime());
+
+	state_type s2;
+	EXPECT_TRUE(ss.tryGetState(&s2));
+	EXPECT_EQ(s.cycle, s2.cycle);
+}
+
+// Reads the snapshot until the writer is done, checking that each State is
+// internally consistent.
+void readUntil(const systems::StateSnapshot<DOF>* ss, unsigned long lastCycle, bool* consistent) {
+	unsigned long prevCycle = 0;
+	state_type s;
+	do {
+		s = ss->getState();
+		double x = s.jp[0];
+		if (s.cycle < prevCycle  ||  (s.cycle != 0  &&  x != s.cycle)  ||
+				s.jp != jp_type(x)  ||  s.jv != jv_type(x)  ||  s.jt != jt_type(x)  ||
+				s.cp != cp_type(x)  ||  s.to.w() != x  ||  s.to.z() != x) {
+			*consistent = false;
+			return;
+		}
+		prevCycle = s.cycle;
+	} while (s.cycle != lastCycle);
+}
+
+TEST_F(StateSnapshotTest, ReadersSeeConsistentStates) {
+	const unsigned long numCycles = 20000;
+	bool consistent1 = true, consistent2 = true;
+
+	boost::thread t1(readUntil, &ss, numCycles, &consistent1);
+	boost::thread t2(readUntil, &ss, numCycles, &consistent2);
+	for (unsigned long i = 1; i <= numCycles; ++i) {
+		run(i);
+	}
+	t1.join();
+	t2.join();
+
+	EXPECT_TRUE(consistent1);
+	EXPECT_TRUE(consistent2);
+}
+
+
+}
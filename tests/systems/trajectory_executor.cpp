@@ -0,0 +1,353 @@
+/*
+ * trajectory_executor.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include <boost/thread.hpp>
+
+#include <gtest/gtest.h>
+
+#include <barrett/os.h>
+#include <barrett/units.h>
+#include <barrett/systems/trajectory_executor.h>
+
+#include "exposed_io_system.h"
+
+
+namespace {
+using namespace barrett;
+
+const size_t DOF = 3;
+typedef units::JointPositions<DOF>::type jp_type;
+
+const double T_s = 0.002;
+
+class TrajectoryExecutorTest : public ::testing::Test {
+public:
+	TrajectoryExecutorTest() :
+		mem(T_s), a(0.0), b(1.0), c(-0.5)
+	{
+		mem.startManaging(eios);
+		systems::connect(te.output, eios.input);
+	}
+
+protected:
+	// Reads the TrajectoryExecutor's output every cycle, as a controller would.
+	void runExecutionCycle() {
+		mem.runExecutionCycle();
+		eios.inputValueDefined();
+	}
+
+	// Runs execution cycles until the move is done. Returns the number of cycles.
+	size_t runUntilDone(systems::TrajectoryExecutor<jp_type>::move_id_type id) {
+		size_t n = 0;
+		while ( !te.isDone(id) ) {
+			runExecutionCycle();
+			++n;
+			EXPECT_LT(n, 10000u);
+			if (n >= 10000) {
+				break;
+			}
+		}
+		return n;
+	}
+
+	systems::ManualExecutionManager mem;
+	systems::TrajectoryExecutor<jp_type> te;
+	ExposedIOSystem<jp_type> eios;
+
+	jp_type a, b, c;
+};
+
+
+TEST_F(TrajectoryExecutorTest, UndefinedUntilFirstMove) {
+	EXPECT_TRUE(te.isIdle());
+
+	runExecutionCycle();
+	EXPECT_FALSE(eios.inputValueDefined());
+}
+
+TEST_F(TrajectoryExecutorTest, MovesAndHolds) {
+	systems::TrajectoryExecutor<jp_type>::move_id_type id = te.enqueue(a, b, 1.0, 1.0);
+	EXPECT_FALSE(te.isDone(id));
+	EXPECT_FALSE(te.isIdle());
+	EXPECT_EQ(b, te.getFinalDestination());
+
+	runExecutionCycle();
+	ASSERT_TRUE(eios.inputValueDefined());
+	EXPECT_NEAR(0.0, (eios.getInputValue() - a).norm(), 1e-9);
+
+	runUntilDone(id);
+	EXPECT_TRUE(te.isIdle());
+	EXPECT_TRUE(eios.getInputValue().isApprox(b));
+
+	for (int i = 0; i < 10; ++i) {
+		runExecutionCycle();
+		EXPECT_TRUE(eios.getInputValue().isApprox(b));
+	}
+}
+
+TEST_F(TrajectoryExecutorTest, NextMoveStartsOnNextCycle) {
+	te.enqueue(a, b, 1.0, 1.0);
+	systems::TrajectoryExecutor<jp_type>::move_id_type id2 = te.enqueue(b, c, 1.0, 1.0);
+
+	size_t n = 0;
+	while ( !te.isDone(id2 - 1) ) {
+		runExecutionCycle();
+		++n;
+		ASSERT_LT(n, 10000u);
+	}
+	EXPECT_FALSE(te.isDone(id2));
+	EXPECT_TRUE(eios.getInputValue().isApprox(b));
+
+	runExecutionCycle();
+	EXPECT_TRUE(eios.getInputValue().isApprox(b));  // Start of the second move
+	runExecutionCycle();
+	EXPECT_FALSE(eios.getInputValue().isApprox(b));
+
+	runUntilDone(id2);
+	EXPECT_TRUE(eios.getInputValue().isApprox(c));
+}
+
+TEST_F(TrajectoryExecutorTest, PreemptCancelsEarlierMoves) {
+	systems::TrajectoryExecutor<jp_type>::move_id_type id1 = te.enqueue(a, b, 1.0, 1.0);
+	for (int i = 0; i < 10; ++i) {
+		runExecutionCycle();
+	}
+	EXPECT_FALSE(te.isDone(id1));
+
+	jp_type current = eios.getInputValue();
+	systems::TrajectoryExecutor<jp_type>::move_id_type id2 = te.enqueue(current, c, 1.0, 1.0, true);
+	runExecutionCycle();
+	EXPECT_TRUE(te.isDone(id1));
+	EXPECT_FALSE(te.isDone(id2));
+	EXPECT_TRUE(eios.getInputValue().isApprox(current));
+
+	runUntilDone(id2);
+	EXPECT_TRUE(eios.getInputValue().isApprox(c));
+}
+
+TEST_F(TrajectoryExecutorTest, DisconnectingCancels) {
+	systems::TrajectoryExecutor<jp_type>::move_id_type id = te.enqueue(a, b, 1.0, 1.0);
+	runExecutionCycle();
+	EXPECT_FALSE(te.isDone(id));
+
+	systems::disconnect(te.output);
+	EXPECT_TRUE(te.isDone(id));
+	EXPECT_TRUE(te.isIdle());
+	EXPECT_FALSE(te.waitUntilDone(id + 1));
+}
+
+TEST_F(TrajectoryExecutorTest, ReconnectingDoesNotCancel) {
+	// As Wam::moveTo() does: enqueue, then (re)connect the output.
+	systems::TrajectoryExecutor<jp_type>::move_id_type id = te.enqueue(a, b, 1.0, 1.0, true);
+	systems::forceConnect(te.output, eios.input);
+	EXPECT_FALSE(te.isDone(id));
+	runExecutionCycle();
+
+	systems::reconnect(te.output, eios.input);
+	EXPECT_FALSE(te.isDone(id));
+	runUntilDone(id);
+	EXPECT_TRUE(eios.getInputValue().isApprox(b));
+
+	// A second move of the same type
+	id = te.enqueue(b, c, 1.0, 1.0, true);
+	systems::forceConnect(te.output, eios.input);
+	runExecutionCycle();
+	EXPECT_FALSE(te.isDone(id));
+	runUntilDone(id);
+	EXPECT_TRUE(eios.getInputValue().isApprox(c));
+}
+
+TEST_F(TrajectoryExecutorTest, ThrowsWhenSlotsAreFullAndNotRunning) {
+	systems::disconnect(te.output);
+	for (size_t i = 0; i < systems::TrajectoryExecutor<jp_type>::NUM_SLOTS; ++i) {
+		te.enqueue(a, b, 1.0, 1.0);
+	}
+	EXPECT_THROW(te.enqueue(a, b, 1.0, 1.0), std::runtime_error);
+
+	// Slots are reclaimed once their moves are done.
+	systems::connect(te.output, eios.input);
+	runUntilDone(1);
+	te.enqueue(a, b, 1.0, 1.0);
+}
+
+TEST_F(TrajectoryExecutorTest, DoesntWaitForAStoppedExecutionManager) {
+	// Connected, but the ExecutionManager never runs a cycle
+	systems::TrajectoryExecutor<jp_type>::move_id_type id = 0;
+	for (size_t i = 0; i < systems::TrajectoryExecutor<jp_type>::NUM_SLOTS; ++i) {
+		id = te.enqueue(a, b, 1.0, 1.0);
+	}
+	EXPECT_THROW(te.enqueue(a, b, 1.0, 1.0), std::runtime_error);
+	EXPECT_FALSE(te.waitUntilDone(id));
+}
+
+// Runs n cycles, starting shortly after the caller begins waiting
+void runCycles(systems::ManualExecutionManager* mem, ExposedIOSystem<jp_type>* eios, size_t n) {
+	btsleep(0.05);
+	for (size_t i = 0; i < n; ++i) {
+		mem->runExecutionCycle();
+		eios->inputValueDefined();
+		btsleep(T_s / 10.0);
+	}
+}
+
+TEST_F(TrajectoryExecutorTest, WaitsForSlotsWhileRunning) {
+	// Queued faster than the control loop can pick them up, as non-blocking
+	// Wam::moveTo() calls might be
+	for (size_t i = 0; i < systems::TrajectoryExecutor<jp_type>::NUM_SLOTS; ++i) {
+		te.enqueue(a, b, 1.0, 1.0, true);
+	}
+
+	boost::thread t(runCycles, &mem, &eios, 10);
+	systems::TrajectoryExecutor<jp_type>::move_id_type id = te.enqueue(a, c, 1.0, 1.0, true);
+	t.join();
+
+	EXPECT_TRUE(te.isDone(id - 1));
+	EXPECT_FALSE(te.isDone(id));
+	runUntilDone(id);
+	EXPECT_TRUE(eios.getInputValue().isApprox(c));
+}
+
+TEST_F(TrajectoryExecutorTest, JerkLimit) {
+	const double jerk = 5.0;
+	EXPECT_THROW(te.setJerkLimit(-1.0), std::invalid_argument);
+	te.setJerkLimit(jerk);
+	EXPECT_EQ(jerk, te.getJerkLimit());
+
+	systems::TrajectoryExecutor<jp_type>::move_id_type id = te.enqueue(a, b, 1.0, 1.0);
+	math::SCurveProfile p(1.0, 1.0, jerk, (b - a).norm());
+
+	// The acceleration along the path changes by at most jerk*T_s per cycle.
+	double s_2 = 0.0, s_1 = 0.0, sdd_1 = 0.0;
+	size_t n = 0;
+	while ( !te.isDone(id) ) {
+		runExecutionCycle();
+		++n;
+		ASSERT_LT(n, 10000u);
+
+		double s = (eios.getInputValue() - a).norm();
+		double sdd = (s - 2.0*s_1 + s_2) / (T_s*T_s);
+		if (n > 2) {
+			EXPECT_LE(std::abs(sdd - sdd_1), jerk * T_s * 1.01);
+		}
+		s_2 = s_1;
+		s_1 = s;
+		sdd_1 = sdd;
+	}
+	EXPECT_NEAR(p.finalT() / T_s, n, 2.0);
+	EXPECT_TRUE(eios.getInputValue().isApprox(b));
+}
+
+
+
+TEST_F(TrajectoryExecutorTest, AppendNeedsAPreviousMove) {
+	EXPECT_THROW(te.append(b, 1.0, 1.0, 0.1), std::logic_error);
+}
+
+TEST_F(TrajectoryExecutorTest, AppendBlendsWithoutStopping) {
+	jp_type corner(0.0);
+	corner[0] = 1.0;
+	jp_type end(corner);
+	end[1] = 1.0;
+
+	te.enqueue(a, corner, 1.0, 1.0);
+	runExecutionCycle();
+	systems::TrajectoryExecutor<jp_type>::move_id_type id = te.append(end, 1.0, 1.0, 0.2);
+
+	// The velocity never drops to zero and never jumps.
+	jp_type prev = eios.getInputValue();
+	double prevSpeed = 0.0;
+	double minSpeed = 1e10;
+	size_t n = 0;
+	while ( !te.isDone(id) ) {
+		runExecutionCycle();
+		++n;
+		ASSERT_LT(n, 10000u);
+
+		double speed = (eios.getInputValue() - prev).norm() / T_s;
+		EXPECT_LT(std::abs(speed - prevSpeed), 2.0 * T_s * 1.5);
+		prev = eios.getInputValue();
+		prevSpeed = speed;
+
+		if ( !te.isDone(id - 1) ) {
+			EXPECT_LT(eios.getInputValue()[1], 0.2 + 1e-9);  // Don't start turning too soon
+		} else if (eios.getInputValue()[1] < 0.5) {
+			minSpeed = std::min(minSpeed, speed);
+		}
+	}
+	EXPECT_GT(minSpeed, 0.1);
+	EXPECT_TRUE(eios.getInputValue().isApprox(end));
+}
+
+TEST_F(TrajectoryExecutorTest, AppendStartsFromRestIfPreviousMoveIsDone) {
+	systems::TrajectoryExecutor<jp_type>::move_id_type id1 = te.enqueue(a, b, 1.0, 1.0);
+	runUntilDone(id1);
+
+	systems::TrajectoryExecutor<jp_type>::move_id_type id2 = te.append(c, 1.0, 1.0, 0.2);
+	runExecutionCycle();
+	EXPECT_TRUE(eios.getInputValue().isApprox(b));
+
+	runUntilDone(id2);
+	EXPECT_TRUE(eios.getInputValue().isApprox(c));
+}
+
+TEST_F(TrajectoryExecutorTest, AppendedMovesAreDroppedAfterCancel) {
+	te.enqueue(a, b, 1.0, 1.0);
+	runExecutionCycle();
+	systems::TrajectoryExecutor<jp_type>::move_id_type id = te.append(c, 1.0, 1.0, 0.2);
+	runExecutionCycle();
+	jp_type held = eios.getInputValue();
+
+	systems::disconnect(te.output);
+	EXPECT_TRUE(te.isDone(id));
+
+	// The WAM never reached b, so moves that start there can't run.
+	systems::connect(te.output, eios.input);
+	id = te.append(c, 1.0, 1.0, 0.2);
+	runExecutionCycle();
+	EXPECT_TRUE(te.isDone(id));
+	EXPECT_EQ(held, eios.getInputValue());
+
+	// A preempting move starts a new chain.
+	te.enqueue(held, b, 1.0, 1.0, true);
+	runExecutionCycle();
+	id = te.append(c, 1.0, 1.0, 0.2);
+	runUntilDone(id);
+	EXPECT_TRUE(eios.getInputValue().isApprox(c));
+}
+
+TEST_F(TrajectoryExecutorTest, MoveThroughAfterPreviousMove) {
+	// As Wam::moveTo() does
+	systems::TrajectoryExecutor<jp_type>::move_id_type id = te.enqueue(a, b, 1.0, 1.0, true);
+	systems::forceConnect(te.output, eios.input);
+	runUntilDone(id);
+
+	// As Wam::moveThrough() does: the first waypoint falls back to moveTo()
+	// because the executor is idle, and the rest are appended.
+	ASSERT_TRUE(te.isIdle());
+	te.enqueue(b, c, 1.0, 1.0, true);
+	systems::forceConnect(te.output, eios.input);
+	runExecutionCycle();
+	te.append(a, 1.0, 1.0, 0.2);
+	runExecutionCycle();
+	id = te.append(b, 1.0, 1.0, 0.2);
+
+	bool reachedC = false;
+	size_t n = 0;
+	while ( !te.isDone(id) ) {
+		runExecutionCycle();
+		++n;
+		ASSERT_LT(n, 10000u);
+		reachedC = reachedC  ||  (eios.getInputValue() - c).norm() < 0.2;
+	}
+	EXPECT_TRUE(reachedC);
+	EXPECT_TRUE(eios.getInputValue().isApprox(b));
+}
+
+}
@@ -0,0 +1,96 @@
+/*
+ * bounded_queue.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <vector>
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+#include <gtest/gtest.h>
+
+#include <barrett/thread/bounded_queue.h>
+
+
+namespace {
+using namespace barrett;
+
+
+TEST(BoundedQueueTest, IsFifo) {
+	thread::BoundedQueue<int, 8> q;
+	int x;
+
+	EXPECT_TRUE(q.empty());
+	EXPECT_FALSE(q.pop(&x));
+
+	for (int i = 0; i < 5; ++i) {
+		EXPECT_TRUE(q.push(i));
+	}
+	EXPECT_FALSE(q.empty());
+	for (int i = 0; i < 5; ++i) {
+		ASSERT_TRUE(q.pop(&x));
+		EXPECT_EQ(i, x);
+	}
+	EXPECT_TRUE(q.empty());
+}
+
+TEST(BoundedQueueTest, PushFailsWhenFull) {
+	thread::BoundedQueue<int, 4> q;
+	int x;
+
+	// Go around the ring a few times
+	for (int lap = 0; lap < 3; ++lap) {
+		for (int i = 0; i < 4; ++i) {
+			EXPECT_TRUE(q.push(i));
+		}
+		EXPECT_FALSE(q.push(4));
+
+		for (int i = 0; i < 4; ++i) {
+			ASSERT_TRUE(q.pop(&x));
+			EXPECT_EQ(i, x);
+		}
+		EXPECT_FALSE(q.pop(&x));
+	}
+}
+
+
+const int NUM_PRODUCERS = 4;
+const int NUM_ITEMS = 10000;
+
+void produce(thread::BoundedQueue<int, 64>* q, int id) {
+	for (int i = 0; i < NUM_ITEMS; ++i) {
+		while ( !q->push(id * NUM_ITEMS + i) ) {
+			boost::this_thread::yield();
+		}
+	}
+}
+
+TEST(BoundedQueueTest, MultipleProducers) {
+	thread::BoundedQueue<int, 64> q;
+	std::vector<int> next(NUM_PRODUCERS, 0);
+
+	boost::thread_group producers;
+	for (int p = 0; p < NUM_PRODUCERS; ++p) {
+		producers.create_thread(boost::bind(&produce, &q, p));
+	}
+
+	int x;
+	for (int n = 0; n < NUM_PRODUCERS * NUM_ITEMS; ++n) {
+		while ( !q.pop(&x) ) {
+			boost::this_thread::yield();
+		}
+
+		// Items from each producer arrive in order, and none are lost or repeated
+		int p = x / NUM_ITEMS;
+		ASSERT_EQ(next[p], x % NUM_ITEMS);
+		++next[p];
+	}
+	producers.join_all();
+
+	EXPECT_TRUE(q.empty());
+}
+
+
+}
@@ -0,0 +1,148 @@
+/*
+ * real_time_mutex.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <algorithm>
+
+#include <boost/thread.hpp>
+
+#include <gtest/gtest.h>
+
+#include <barrett/os.h>
+#include <barrett/thread/real_time_mutex.h>
+
+
+namespace {
+using namespace barrett;
+
+
+void holdFor(thread::RealTimeMutex* m, double duration, bool* locked) {
+	m->lock();
+	*locked = true;
+	if (duration > 0.0) {
+		btsleep(duration);
+	}
+	m->unlock();
+}
+
+
+TEST(RealTimeMutexTest, IsRecursive) {
+	thread::RealTimeMutex m;
+
+	m.lock();
+	m.lock();
+	EXPECT_TRUE(m.try_lock());
+	m.unlock();
+	m.unlock();
+	m.unlock();
+
+	EXPECT_TRUE(m.try_lock());
+	m.unlock();
+}
+
+TEST(RealTimeMutexTest, FullUnlockAndRelock) {
+	thread::RealTimeMutex m;
+
+	m.lock();
+	m.lock();
+	m.lock();
+	int lc = m.fullUnlock();
+	EXPECT_EQ(3, lc);
+
+	// Another thread can take the mutex while it is fully unlocked
+	bool locked = false;
+	boost::thread t(holdFor, &m, 0.01, &locked);
+	t.join();
+	EXPECT_TRUE(locked);
+
+	m.relock(lc);
+	m.unlock();
+	m.unlock();
+	m.unlock();
+}
+
+TEST(RealTimeMutexTest, FullUnlockThrowsIfNotLocked) {
+	thread::RealTimeMutex m;
+	EXPECT_THROW(m.fullUnlock(), std::logic_error);
+}
+
+TEST(RealTimeMutexTest, ExcludesOtherThreads) {
+	thread::RealTimeMutex m;
+	bool locked = false;
+
+	m.lock();
+	boost::thread t(holdFor, &m, 0.0, &locked);
+	btsleep(0.01);
+	EXPECT_FALSE(locked);
+	m.unlock();
+
+	t.join();
+	EXPECT_TRUE(locked);
+}
+
+TEST(RealTimeMutexTest, CollectsStatistics) {
+	const double HOLD_TIME = 0.02;
+	thread::RealTimeMutex m;
+	m.enableStatistics();
+	ASSERT_TRUE(m.statisticsEnabled());
+
+	bool locked = false;
+	boost::thread t(holdFor, &m, HOLD_TIME, &locked);
+	while ( !locked ) {
+		btsleep(0.001);
+	}
+
+	m.lock();  // Contended
+	m.unlock();
+	t.join();
+
+	unsigned long numLocks = 0, numContended = 0;
+	double maxWait = 0.0, maxHold = 0.0;
+	for (size_t i = 0; i < m.getNumLockSites(); ++i) {
+		const thread::RealTimeMutex::LockSiteStats& s = m.getLockSiteStats(i);
+		numLocks += s.numLocks;
+		numContended += s.numContended;
+		maxWait = std::max(maxWait, s.maxWaitTime);
+		maxHold = std::max(maxHold, s.maxHoldTime);
+	}
+
+	EXPECT_EQ(2u, numLocks);
+	EXPECT_EQ(1u, numContended);
+	EXPECT_GT(maxWait, HOLD_TIME / 2.0);
+	EXPECT_GT(maxHold, HOLD_TIME / 2.0);
+
+	m.resetStatistics();
+	EXPECT_EQ(0u, m.getNumLockSites());
+}
+
+// Each instantiation locks from a different site.
+template<int N>
+__attribute__((noinline)) void lockFromSites(thread::RealTimeMutex* m) {
+	m->lock();
+	m->unlock();
+	lockFromSites<N - 1>(m);
+}
+template<>
+void lockFromSites<0>(thread::RealTimeMutex* m) {}
+
+TEST(RealTimeMutexTest, CountsLocksFromTooManySites) {
+	const size_t MAX_SITES = thread::RealTimeMutex::MAX_LOCK_SITES;
+	thread::RealTimeMutex m;
+	m.enableStatistics();
+
+	lockFromSites<MAX_SITES + 4>(&m);
+	EXPECT_EQ(MAX_SITES, m.getNumLockSites());
+	EXPECT_EQ(4u, m.getNumUntrackedLocks());
+	for (size_t i = 0; i < m.getNumLockSites(); ++i) {
+		EXPECT_TRUE(m.getLockSiteStats(i).site != NULL);
+		EXPECT_EQ(1u, m.getLockSiteStats(i).numLocks);
+	}
+
+	m.resetStatistics();
+	EXPECT_EQ(0u, m.getNumUntrackedLocks());
+}
+
+
+}
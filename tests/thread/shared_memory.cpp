@@ -0,0 +1,138 @@
+/*
+ * shared_memory.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <string>
+#include <stdexcept>
+#include <cstring>
+
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/lexical_cast.hpp>
+
+#include <gtest/gtest.h>
+
+#include <barrett/thread/shared_memory.h>
+
+
+namespace {
+using namespace barrett;
+
+
+std::string uniqueName(const char* base) {
+	return std::string("/barrett_test_") + base + "_" + boost::lexical_cast<std::string>(getpid());
+}
+
+struct Command {
+	double x[3];
+	int mode;
+};
+
+
+TEST(SharedMemoryTest, CreateAndOpen) {
+	std::string name = uniqueName("shm");
+	EXPECT_THROW(thread::SharedMemory(name, 64, false), std::runtime_error);
+
+	{
+		thread::SharedMemory created(name, 64, true);
+		EXPECT_TRUE(created.isOwner());
+		std::memset(created.get(), 7, 64);
+
+		thread::SharedMemory opened(name, 64, false);
+		EXPECT_FALSE(opened.isOwner());
+		EXPECT_NE(created.get(), opened.get());
+		EXPECT_EQ(7, static_cast<char*>(opened.get())[63]);
+
+		EXPECT_THROW(thread::SharedMemory(name, 128, false), std::runtime_error);
+	}
+
+	// The owner removes the segment.
+	EXPECT_THROW(thread::SharedMemory(name, 64, false), std::runtime_error);
+}
+
+TEST(SharedMemoryTest, CreateExistingThrowsUnlessReplacing) {
+	std::string name = uniqueName("existing");
+	thread::SharedMemory created(name, 64, true);
+	static_cast<char*>(created.get())[0] = 7;
+
+	EXPECT_THROW(thread::SharedMemory(name, 64, true), std::runtime_error);
+	{
+		thread::SharedMemory opened(name, 64, false);
+		EXPECT_EQ(7, static_cast<char*>(opened.get())[0]);
+	}
+
+	thread::SharedMemory replaced(name, 64, true, true);
+	EXPECT_EQ(0, static_cast<char*>(replaced.get())[0]);
+}
+
+TEST(SharedMemoryTest, Permissions) {
+	std::string name = uniqueName("mode");
+	struct stat st;
+	{
+		thread::SharedMemory created(name, 16, true);
+		int fd = shm_open(name.c_str(), O_RDONLY, 0);
+		ASSERT_NE(-1, fd);
+		ASSERT_EQ(0, fstat(fd, &st));
+		close(fd);
+		EXPECT_EQ(static_cast<mode_t>(S_IRUSR | S_IWUSR), st.st_mode & 0777);
+	}
+	{
+		mode_t oldMask = umask(S_IWGRP | S_IRWXO);  // The umask still applies.
+		thread::SharedMemory created(name, 16, true, false, S_IRUSR | S_IWUSR | S_IRGRP);
+		umask(oldMask);
+
+		int fd = shm_open(name.c_str(), O_RDONLY, 0);
+		ASSERT_NE(-1, fd);
+		ASSERT_EQ(0, fstat(fd, &st));
+		close(fd);
+		EXPECT_EQ(static_cast<mode_t>(S_IRUSR | S_IWUSR | S_IRGRP), st.st_mode & 0777);
+	}
+}
+
+TEST(SharedMemoryTest, NameGetsLeadingSlash) {
+	std::string name = uniqueName("slash");
+	thread::SharedMemory created(name.substr(1), 16, true);
+	EXPECT_EQ(name, created.getName());
+	thread::SharedMemory opened(name, 16, false);
+}
+
+TEST(SharedMemoryChannelTest, PassesValues) {
+	std::string name = uniqueName("channel");
+	thread::SharedMemoryChannel<Command> writer(name, true);
+	thread::SharedMemoryChannel<Command> reader(name, false);
+	thread::SharedMemoryChannel<Command>::Sample s;
+
+	EXPECT_EQ(0u, reader.getSequence());
+	EXPECT_FALSE(reader.tryRead(&s));
+
+	Command c = { {1.0, 2.0, 3.0}, 4 };
+	writer.write(c, 12.5);
+	EXPECT_EQ(2u, reader.getSequence());
+	ASSERT_TRUE(reader.tryRead(&s));
+	EXPECT_EQ(12.5, s.time);
+	EXPECT_EQ(3.0, s.value.x[2]);
+	EXPECT_EQ(4, s.value.mode);
+
+	c.mode = 5;
+	writer.write(c);
+	ASSERT_TRUE(reader.tryRead(&s));
+	EXPECT_EQ(5, s.value.mode);
+	EXPECT_GT(s.time, 0.0);
+}
+
+TEST(SharedMemoryChannelTest, TypeMismatchThrows) {
+	std::string name = uniqueName("mismatch");
+	thread::SharedMemoryChannel<Command> writer(name, true);
+	EXPECT_THROW(thread::SharedMemoryChannel<double>(name, false), std::runtime_error);
+
+	thread::SharedMemory plain(uniqueName("plain"), 4096, true);
+	EXPECT_THROW(thread::SharedMemoryChannel<Command>(plain.getName(), false), std::runtime_error);
+}
+
+
+}